@@ -89,6 +89,10 @@ public:
   int    peek(void);
   size_t write(uint8_t val) override;
   int    read(void) override;
+
+  // Read up to size bytes which are already received, does not wait for more data.
+  size_t read(uint8_t *buffer,
+              size_t   size);
   int    available(void) override;
   int    availableForWrite(void);
   void   flush(void) override;
@@ -88,28 +88,37 @@ float SDM::readVal(uint16_t reg, uint8_t node) {
 }
 
 void SDM::startReadVal(uint16_t reg, uint8_t node, uint8_t functionCode) {
+  startReadRegisters(reg, SDM_B_06, node, functionCode);
+}
+
+void SDM::startReadRegisters(uint16_t reg, uint8_t nrRegisters, uint8_t node, uint8_t functionCode) {
+  if (nrRegisters > SDM_MAX_READ_REGISTERS) {
+    nrRegisters = SDM_MAX_READ_REGISTERS;
+  }
   uint8_t data[] = {
     node,             // Address
     functionCode,     // Modbus function
     highByte(reg),    // Start address high byte
     lowByte(reg),     // Start address low byte
     SDM_B_05,         // Number of points high byte
-    SDM_B_06,         // Number of points low byte
+    nrRegisters,      // Number of points low byte
     0,                // Checksum low byte
     0};               // Checksum high byte
 
+  framesize = 5 + 2 * nrRegisters;                                              //  address, function, byte count, data, crc
+
   constexpr size_t messageLength = sizeof(data) / sizeof(data[0]);
   modbusWrite(data, messageLength);
 }
 
 uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
   uint16_t readErr = SDM_ERR_NO_ERROR;
-  if (sdmSer.available() < FRAMESIZE && ((millis() - resptime) < msturnaround)) 
+  if (sdmSer.available() < framesize && ((millis() - resptime) < msturnaround)) 
   {
     return SDM_ERR_STILL_WAITING;
   }
 
-  while (sdmSer.available() < FRAMESIZE) {
+  while (sdmSer.available() < framesize) {
     if ((millis() - resptime) > msturnaround) {
       readErr = SDM_ERR_TIMEOUT;                                                //err debug (4)
 
@@ -128,16 +137,16 @@ uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
 
   if (readErr == SDM_ERR_NO_ERROR) {                                            //if no timeout...
 
-    if (sdmSer.available() >= FRAMESIZE) {
+    if (sdmSer.available() >= framesize) {
 
-      for(int n=0; n<FRAMESIZE; n++) {
+      for(int n=0; n<framesize; n++) {
         sdmarr[n] = sdmSer.read();
       }
 
       if (sdmarr[0] == node && 
           sdmarr[1] == functionCode && 
-          sdmarr[2] == SDM_REPLY_BYTE_COUNT) {
-        if (!validChecksum(sdmarr, FRAMESIZE)) {
+          sdmarr[2] == framesize - 5) {
+        if (!validChecksum(sdmarr, framesize)) {
           readErr = SDM_ERR_CRC_ERROR;                                          //err debug (1)
         }
 
@@ -169,13 +178,14 @@ uint16_t SDM::readValReady(uint8_t node, uint8_t functionCode) {
   return readErr;
 }
 
-float SDM::decodeFloatValue() const {
-  if (validChecksum(sdmarr, FRAMESIZE)) {
+float SDM::decodeFloatValue(uint8_t registerOffset) const {
+  const size_t pos = 3 + 2 * registerOffset;
+  if ((pos + 4 + 2) <= framesize && validChecksum(sdmarr, framesize)) {
     float res{};
-    ((uint8_t*)&res)[3]= sdmarr[3];
-    ((uint8_t*)&res)[2]= sdmarr[4];
-    ((uint8_t*)&res)[1]= sdmarr[5];
-    ((uint8_t*)&res)[0]= sdmarr[6];
+    ((uint8_t*)&res)[3]= sdmarr[pos];
+    ((uint8_t*)&res)[2]= sdmarr[pos + 1];
+    ((uint8_t*)&res)[1]= sdmarr[pos + 2];
+    ((uint8_t*)&res)[0]= sdmarr[pos + 3];
     return res;
   }
   constexpr float res = NAN;
@@ -226,6 +236,7 @@ bool SDM::writeHoldingRegister(float value, uint16_t reg, uint8_t node) {
     constexpr size_t messageLength = sizeof(data) / sizeof(data[0]);
     modbusWrite(data, messageLength);
   }
+  framesize = FRAMESIZE;
   uint16_t readErr = SDM_ERR_STILL_WAITING;
   while (readErr == SDM_ERR_STILL_WAITING) {
     delay(1);
@@ -103,6 +103,11 @@
 #define SDM_WRITE_HOLDING_REGISTER                    0x10
 
 #define FRAMESIZE                                     9                         //  size of out/in array
+#if !defined ( SDM_MAX_READ_REGISTERS )
+  //  The reply (5 + 2 * registers bytes) must fit in the 64 byte receive buffer of SoftwareSerial and the SC16IS752
+  #define SDM_MAX_READ_REGISTERS                      24                        //  max number of registers read in a single request (2 registers per float value)
+#endif
+#define SDM_MAX_FRAMESIZE                             (5 + 2 * SDM_MAX_READ_REGISTERS) //  size of in array for reading multiple registers
 #define SDM_REPLY_BYTE_COUNT                          0x04                      //  number of bytes with data
 
 #define SDM_B_01                                      0x01                      //  BYTE 1 -> slave address (default value 1 read from node 1)
@@ -337,8 +342,9 @@ class SDM {
     void begin(void);
     float readVal(uint16_t reg, uint8_t node = SDM_B_01);                       //  read value from register = reg and from deviceId = node
     void startReadVal(uint16_t reg, uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);                   //  Start sending out the request to read a register from a specific node (allows for async access)
+    void startReadRegisters(uint16_t reg, uint8_t nrRegisters, uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02); //  Start reading a block of registers (max. SDM_MAX_READ_REGISTERS) from a specific node (allows for async access)
     uint16_t readValReady(uint8_t node = SDM_B_01, uint8_t functionCode = SDM_B_02);                             //  Check to see if a reply is ready reading from a node (allow for async access)
-    float decodeFloatValue() const;
+    float decodeFloatValue(uint8_t registerOffset = 0) const;                  //  decode float value at registerOffset from the start register of the last read
 
     float readHoldingRegister(uint16_t reg, uint8_t node = SDM_B_01);
     bool writeHoldingRegister(float value, uint16_t reg, uint8_t node = SDM_B_01);
@@ -392,7 +398,8 @@ class SDM {
     uint32_t readingerrcount = 0;                                               //  total errors counter
     uint32_t readingsuccesscount = 0;                                           //  total success counter
     unsigned long resptime = 0;
-    uint8_t sdmarr[FRAMESIZE] = {};
+    uint8_t sdmarr[SDM_MAX_FRAMESIZE] = {};
+    uint8_t framesize = FRAMESIZE;                                              //  expected size of the reply frame
     uint16_t calculateCRC(const uint8_t *array, uint8_t len) const;
     void flush(unsigned long _flushtime = 0);                                   //  read serial if any old data is available or for a given time in ms
     void dereSet(bool _state = LOW);                                            //  for control MAX485 DE/RE pins, LOW receive from SDM, HIGH transmit to SDM
@@ -507,11 +507,9 @@ boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigne
     if (!beginPublish(topic, plength, retained)) {
         return false;
     }
-    for (unsigned int i=0;i<plength;i++) {
-        write(payload[i]);
-    }
-    endPublish();
-    return true;
+    const size_t written = write(payload, plength);
+    const bool flushed = endPublish() != 0;
+    return flushed && (written == plength);
 }
 
 boolean PubSubClient::publish_P(const char* topic, const char* payload, boolean retained) {
@@ -551,7 +549,11 @@ boolean PubSubClient::beginPublish(const char* topic, unsigned int plength, bool
 }
 
 int PubSubClient::endPublish() {
-    flushBuffer();
+    // Report a truncated message when not all buffered data could be sent.
+    const size_t pending = _bufferWritePos;
+    if (flushBuffer() != pending) {
+        return 0;
+    }
     return 1;
 }
 
@@ -730,8 +732,22 @@ size_t PubSubClient::appendBuffer(uint8_t data) {
 }
 
 size_t PubSubClient::appendBuffer(const uint8_t *data, size_t size) {
-    for (size_t i = 0; i < size; ++i) {
-        if (appendBuffer(data[i]) == 0) return i;
+    if (!initBuffer()) {
+        return 0;
+    }
+    // Copy in chunks of at most the free space in the buffer, flush when full.
+    size_t pos = 0;
+    while (pos < size) {
+        size_t chunk = MQTT_MAX_PACKET_SIZE - _bufferWritePos;
+        if (chunk > (size - pos)) {
+            chunk = size - pos;
+        }
+        memcpy(buffer + _bufferWritePos, data + pos, chunk);
+        _bufferWritePos += chunk;
+        pos += chunk;
+        if (_bufferWritePos >= MQTT_MAX_PACKET_SIZE) {
+            if (flushBuffer() != MQTT_MAX_PACKET_SIZE) return pos - chunk;
+        }
     }
     return size;
 }
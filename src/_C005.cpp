@@ -17,9 +17,12 @@
 
 String CPlugin_005_pubname;
 bool   CPlugin_005_mqtt_retainFlag = false;
+bool   CPlugin_005_publishTaskJSON = false;
 
 bool C005_parse_command(struct EventStruct *event);
 
+bool C005_publish_task_json(struct EventStruct *event);
+
 bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String& string)
 {
   bool success = false;
@@ -50,6 +53,14 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_INIT:
     {
+      {
+        MakeControllerSettings(ControllerSettings); // -V522
+
+        if (AllocatedControllerSettings()) {
+          LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+          CPlugin_005_publishTaskJSON = ControllerSettings->mqtt_publishTaskJSON();
+        }
+      }
       success = init_mqtt_delay_queue(event->ControllerIndex, CPlugin_005_pubname, CPlugin_005_mqtt_retainFlag);
       break;
     }
@@ -60,6 +71,20 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+    case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
+    {
+      MakeControllerSettings(ControllerSettings); // -V522
+
+      if (!AllocatedControllerSettings()) {
+        addHtmlError(F("Out of memory, cannot load page"));
+      } else {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_PUBLISH_TASK_JSON);
+        addFormNote(F("Publish one JSON object per task, e.g. {\"Temperature\":21.3,\"Humidity\":55}. %valname% is removed from the topic."));
+      }
+      break;
+    }
+
     case CPlugin::Function::CPLUGIN_PROTOCOL_TEMPLATE:
     {
       event->String1 = F("%sysname%/#");
@@ -83,6 +108,10 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
         break;
       }
 
+      if (CPlugin_005_publishTaskJSON) {
+        success = C005_publish_task_json(event);
+        break;
+      }
 
       String pubname              = CPlugin_005_pubname;
       const bool contains_valname = pubname.indexOf(F("%valname%")) != -1;
@@ -154,6 +183,62 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
   return success;
 }
 
+// Publish all values of the task as a single JSON object, e.g. {"Temperature":21.3,"Humidity":55}
+// The topic is parsed only once per task, with the %valname% level removed.
+bool C005_publish_task_json(struct EventStruct *event) {
+  String topic = CPlugin_005_pubname;
+
+  topic.replace(F("/%valname%"), F(""));
+  topic.replace(F("%valname%"),  F(""));
+  parseControllerVariables(topic, event, false);
+
+  const bool    isStringType = event->sensorType == Sensor_VType::SENSOR_TYPE_STRING;
+  const uint8_t valueCount   = getValueCountForTask(event->TaskIndex);
+  String payload;
+
+  payload.reserve(isStringType ? event->String2.length() + 32 : valueCount * 24);
+  payload += '{';
+
+  for (uint8_t x = 0; x < valueCount; x++)
+  {
+    // Skip values with empty labels, like the per value publish does
+    const String valueName = Cache.getTaskDeviceValueName(event->TaskIndex, x);
+
+    if (valueName.isEmpty()) {
+      continue;
+    }
+
+    if (payload.length() > 1) {
+      payload += ',';
+    }
+
+    if (isStringType) {
+      payload += to_json_object_value(valueName, event->String2, true);
+    } else {
+      payload += to_json_object_value(valueName, formatUserVarNoCheck(event, x));
+    }
+  }
+  payload += '}';
+
+  if (payload.length() <= 2) {
+    // No named values
+    return false;
+  }
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogMove(LOG_LEVEL_DEBUG,
+               strformat(
+                 F("MQTT : %s %s"),
+                 topic.c_str(),
+                 payload.substring(0, 40).c_str()));
+  }
+# endif // ifndef BUILD_NO_DEBUG
+
+  // Publish using move operator, thus topic and payload are empty after this call
+  return MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(topic), std::move(payload), CPlugin_005_mqtt_retainFlag);
+}
+
 bool C005_parse_command(struct EventStruct *event) {
   // FIXME TD-er: Command is not parsed for template arguments.
 
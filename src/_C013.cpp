@@ -7,6 +7,7 @@
 
 
 # include "src/Globals/Nodes.h"
+# include "src/DataStructs/C013_p2p_CompactSensorData.h"
 # include "src/DataStructs/C013_p2p_SensorDataStruct.h"
 # include "src/DataStructs/C013_p2p_SensorInfoStruct.h"
 # include "src/ESPEasyCore/ESPEasyRules.h"
@@ -33,6 +34,8 @@ void C013_sendUDP(uint8_t        unit,
                   const uint8_t *data,
                   size_t         size);
 void C013_Receive(struct EventStruct *event);
+void C013_ProcessSensorData(const C013_SensorDataStruct& dataReply,
+                            uint8_t                      valueMask);
 
 
 bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -63,6 +66,8 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_TASK_CHANGE_NOTIFICATION:
     {
+      // Make sure the next compact data message contains all values
+      C013_resetCompactSensorData(event->TaskIndex);
       C013_SendUDPTaskInfo(0, event->TaskIndex, event->TaskIndex);
       break;
     }
@@ -169,7 +174,18 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
     dataReply.destUnit = 255;
   }
   dataReply.prepareForSend();
-  C013_sendUDP(dataReply.destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+
+  if (C013_allNodesSupportCompactSensorData()) {
+    // Only send changed values, in a compact encoding
+    uint8_t compactData[C013_COMPACT_MAX_SIZE];
+    const size_t size = C013_encodeCompactSensorData(dataReply, compactData);
+    C013_sendUDP(dataReply.destUnit, compactData, size);
+  } else {
+    // Some nodes may not understand the compact format
+    // Make sure to start with all values when switching back to the compact format.
+    C013_resetCompactSensorData(event->TaskIndex);
+    C013_sendUDP(dataReply.destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+  }
 }
 
 /*********************************************************************************************\
@@ -225,7 +241,7 @@ void C013_Receive(struct EventStruct *event) {
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
     if ((event->Data != nullptr) &&
-        (event->Data[1] > 1) && (event->Data[1] < 6))
+        (event->Data[1] > 1) && (event->Data[1] <= C013_COMPACT_SENSORDATA_ID))
     {
       String log = (F("C013 : msg "));
 
@@ -239,8 +255,6 @@ void C013_Receive(struct EventStruct *event) {
   }
 # endif // ifndef BUILD_NO_DEBUG
 
-  START_TIMER
-
   switch (event->Data[1]) {
     case 2: // sensor info pull request
     {
@@ -352,66 +366,91 @@ void C013_Receive(struct EventStruct *event) {
       // For example sending different sensor type data from one dummy to another is probably not going to work well
 
       if (dataReply.setData(event->Data, event->Par2)) {
-        // only if this task has a remote feed, update values
-        const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
-
-        if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
-        {
-          // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
-          // See:
-          // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
-          // Thus should not be checked
-          //
-          // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
-          // missed)
-          // Then we cannot be sure about its build.
-          const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
-
-          if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
-            // Mismatch in plugin ID from sending node
-            if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-              String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
-              log += concat(F(" from unit "), dataReply.sourceUnit);
-              log += concat(F(" remote: "), dataReply.deviceNumber.value);
-              log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
-              addLogMove(LOG_LEVEL_ERROR, log);
-            }
-          } else {
-            struct EventStruct TempEvent(dataReply.destTaskIndex);
-            TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+        C013_ProcessSensorData(dataReply, (1 << VARS_PER_TASK) - 1);
+      }
 
-            const Sensor_VType sensorType = TempEvent.getSensorType();
+      break;
+    }
 
-            if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
-              TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+    case C013_COMPACT_SENSORDATA_ID: // compact sensor data, only changed values
+    {
+      struct C013_SensorDataStruct dataReply;
+      uint8_t valueMask = 0;
 
-              if (taskValues != nullptr) {
-                memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
-              }
-              STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
-
-              if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
-                // Only use timestamp of remote unit when we got a system time ourselves
-                // If not, then the order of samples can get messed up.
-                // timestamp_fraq is 16 bit, so need to scale it to 32 bit
-                TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
-                SensorSendTask(&TempEvent, dataReply.timestamp_sec);
-              } else {
-                SensorSendTask(&TempEvent);
-              }
-            } else {
-              // Mismatch in sensor types
-              if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-                String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
-                log += concat(F(" from unit "), dataReply.sourceUnit);
-                addLogMove(LOG_LEVEL_ERROR, log);
-              }
+      if (C013_decodeCompactSensorData(event->Data, event->Par2, dataReply, valueMask)) {
+        C013_ProcessSensorData(dataReply, valueMask);
+      }
+      break;
+    }
+  }
+}
+
+void C013_ProcessSensorData(const C013_SensorDataStruct& dataReply, uint8_t valueMask)
+{
+  START_TIMER
+
+  // only if this task has a remote feed, update values
+  const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+
+  if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
+  {
+    // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
+    // See:
+    // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
+    // Thus should not be checked
+    //
+    // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
+    // missed)
+    // Then we cannot be sure about its build.
+    const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
+
+    if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
+      // Mismatch in plugin ID from sending node
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
+        log += concat(F(" from unit "), dataReply.sourceUnit);
+        log += concat(F(" remote: "), dataReply.deviceNumber.value);
+        log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
+        addLogMove(LOG_LEVEL_ERROR, log);
+      }
+    } else {
+      struct EventStruct TempEvent(dataReply.destTaskIndex);
+      TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+
+      const Sensor_VType sensorType = TempEvent.getSensorType();
+
+      if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
+        TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+
+        if (taskValues != nullptr) {
+          // Only update the values present in the received data, per 32-bit word
+          constexpr size_t wordSize = sizeof(dataReply.taskValues_Data) / VARS_PER_TASK;
+
+          for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+            if (bitRead(valueMask, x)) {
+              memcpy(&taskValues->binary[x * wordSize], &dataReply.taskValues_Data[x * wordSize], wordSize);
             }
           }
         }
+        STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
+
+        if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
+          // Only use timestamp of remote unit when we got a system time ourselves
+          // If not, then the order of samples can get messed up.
+          // timestamp_fraq is 16 bit, so need to scale it to 32 bit
+          TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
+          SensorSendTask(&TempEvent, dataReply.timestamp_sec);
+        } else {
+          SensorSendTask(&TempEvent);
+        }
+      } else {
+        // Mismatch in sensor types
+        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+          String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
+          log += concat(F(" from unit "), dataReply.sourceUnit);
+          addLogMove(LOG_LEVEL_ERROR, log);
+        }
       }
-
-      break;
     }
   }
 }
@@ -23,7 +23,8 @@
    - Unused flash after the partitioned space (TODO)
 
    The controller can deliver the data to:
-   <TODO>
+   - A HTTP server accepting InfluxDB line protocol, when a host is configured.
+     The samples are uploaded in batches and only removed from the cache after the server acknowledged them.
  */
 
 # include "src/Globals/C016_ControllerCache.h"
@@ -35,8 +36,26 @@
 
 // #include <ArduinoJson.h>
 
+# ifndef C016_UPLOAD_MAX_BATCH_SIZE
+#  define C016_UPLOAD_MAX_BATCH_SIZE    2048  // Max. size of the body of a single HTTP POST
+# endif // ifndef C016_UPLOAD_MAX_BATCH_SIZE
+# ifndef C016_UPLOAD_INTERVAL_IDLE
+#  define C016_UPLOAD_INTERVAL_IDLE     10000 // msec to wait when all data has been uploaded
+# endif // ifndef C016_UPLOAD_INTERVAL_IDLE
+# ifndef C016_UPLOAD_INTERVAL_RETRY
+#  define C016_UPLOAD_INTERVAL_RETRY    30000 // msec to wait after a failed upload
+# endif // ifndef C016_UPLOAD_INTERVAL_RETRY
+# define C016_DEFAULT_UPLOAD_PATH       "/write?db=espeasy&precision=s"
+
 bool C016_allowLocalSystemTime = false;
 
+# if FEATURE_HTTP_CLIENT
+bool          C016_uploadEnabled = false;
+unsigned long C016_nextUpload    = 0;
+
+uint32_t C016_upload_batch(controllerIndex_t ControllerIndex);
+# endif // if FEATURE_HTTP_CLIENT
+
 bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String& string)
 {
   bool success = false;
@@ -51,13 +70,22 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesAccount          = false;
       proto.usesPassword         = false;
       proto.usesExtCreds         = false;
+      # if FEATURE_HTTP_CLIENT
+      proto.usesAccount          = true;
+      proto.usesPassword         = true;
+      proto.defaultPort          = 8086;
+      proto.usesHost             = true;
+      proto.usesPort             = true;
+      proto.usesTimeout          = true;
+      # else // if FEATURE_HTTP_CLIENT
       proto.defaultPort          = 80;
-      proto.usesID               = false;
       proto.usesHost             = false;
       proto.usesPort             = false;
+      proto.usesTimeout          = false;
+      # endif // if FEATURE_HTTP_CLIENT
+      proto.usesID               = false;
       proto.usesQueue            = false;
       proto.usesCheckReply       = false;
-      proto.usesTimeout          = false;
       proto.usesSampleSets       = false;
       proto.needsNetwork         = false;
       proto.allowsExpire         = false;
@@ -79,6 +107,12 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
         if (AllocatedControllerSettings()) {
           LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
           C016_allowLocalSystemTime = ControllerSettings->useLocalSystemTime();
+          # if FEATURE_HTTP_CLIENT
+
+          // Only upload when a host is configured
+          C016_uploadEnabled = ControllerSettings->isSet();
+          C016_nextUpload    = millis();
+          # endif // if FEATURE_HTTP_CLIENT
         }
       }
       success = init_c016_delay_queue(event->ControllerIndex);
@@ -88,12 +122,44 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_EXIT:
     {
+      # if FEATURE_HTTP_CLIENT
+      C016_uploadEnabled = false;
+      # endif // if FEATURE_HTTP_CLIENT
       exit_c016_delay_queue();
       break;
     }
 
+    # if FEATURE_HTTP_CLIENT
+    case CPlugin::Function::CPLUGIN_GET_PROTOCOL_DISPLAY_NAME:
+    {
+      success = true;
+
+      switch (event->idx) {
+        case ControllerSettingsStruct::CONTROLLER_PUBLISH:
+          string = F("Upload Path");
+          break;
+        default:
+          success = false;
+          break;
+      }
+      break;
+    }
+    # endif // if FEATURE_HTTP_CLIENT
+
     case CPlugin::Function::CPLUGIN_WEBFORM_LOAD:
     {
+      # if FEATURE_HTTP_CLIENT
+      MakeControllerSettings(ControllerSettings); // -V522
+
+      if (!AllocatedControllerSettings()) {
+        addHtmlError(F("Out of memory, cannot load page"));
+      } else {
+        LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
+        addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_PUBLISH);
+        addFormNote(concat(F("Samples are uploaded as InfluxDB line protocol when a host is set. Default: "),
+                           F(C016_DEFAULT_UPLOAD_PATH)));
+      }
+      # endif // if FEATURE_HTTP_CLIENT
       break;
     }
 
@@ -153,6 +219,19 @@ bool CPlugin_016(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+    # if FEATURE_HTTP_CLIENT
+    case CPlugin::Function::CPLUGIN_TEN_PER_SECOND:
+    {
+      if (C016_uploadEnabled &&
+          C016_CacheInitialized() &&
+          NetworkConnected() &&
+          (timePassedSince(C016_nextUpload) >= 0)) {
+        C016_nextUpload = millis() + C016_upload_batch(event->ControllerIndex);
+      }
+      break;
+    }
+    # endif // if FEATURE_HTTP_CLIENT
+
     case CPlugin::Function::CPLUGIN_WEBFORM_SHOW_HOST_CONFIG:
     {
       string = F("-");
@@ -183,4 +262,188 @@ return true;
 // - Feed it to some plugin (e.g. a display to show a chart)
 }
 
+# if FEATURE_HTTP_CLIENT
+
+// ********************************************************************************
+// Upload the cached samples in batches using InfluxDB line protocol
+// ********************************************************************************
+
+// Escape measurement names and field keys.
+void C016_appendEscaped(String& str, const String& name) {
+  for (size_t i = 0; i < name.length(); ++i) {
+    const char c = name[i];
+
+    if ((c == ',') || (c == ' ') || (c == '=')) {
+      str += '\\';
+    }
+    str += c;
+  }
+}
+
+// Append a line like: "taskname valname1=1.23,valname2=4.56 1700000000"
+bool C016_appendLineProtocol(String& body, const C016_binary_element& element) {
+  if (!validTaskIndex(element.TaskIndex)) {
+    return false;
+  }
+  const String taskName = Cache.getTaskDeviceName(element.TaskIndex);
+
+  if (taskName.isEmpty()) {
+    return false;
+  }
+  const size_t startLength = body.length();
+
+  C016_appendEscaped(body, taskName);
+
+  bool hasField = false;
+
+  for (uint8_t i = 0; i < element.valueCount && i < VARS_PER_TASK; ++i) {
+    if (!element.values.isValid(i, element.sensorType)) {
+      continue;
+    }
+    const String valueName = Cache.getTaskDeviceValueName(element.TaskIndex, i);
+
+    if (valueName.isEmpty()) {
+      continue;
+    }
+    body += hasField ? ',' : ' ';
+    C016_appendEscaped(body, valueName);
+    body    += '=';
+    body    += element.values.getAsString(i, element.sensorType, Cache.getTaskDeviceValueDecimals(element.TaskIndex, i));
+    hasField = true;
+  }
+
+  if (!hasField) {
+    // Line protocol needs at least one field
+    body.remove(startLength);
+    return false;
+  }
+
+  if (element.unixTime != 0) {
+    body += ' ';
+    body += element.unixTime;
+  }
+  body += '\n';
+  return true;
+}
+
+bool C016_isBeforeFilePos(int fileNr, int readPos, int otherFileNr, int otherReadPos) {
+  return (fileNr < otherFileNr) || ((fileNr == otherFileNr) && (readPos < otherReadPos));
+}
+
+// Return true when an enabled Cache Controller Reader (P146) task may still need the cached data.
+bool C016_cacheReaderEnabled() {
+  constexpr pluginID_t PLUGIN_CACHE_READER(146);
+
+  for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
+    if (Settings.TaskDeviceEnabled[task] &&
+        (Settings.getPluginID_for_task(task) == PLUGIN_CACHE_READER)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Upload the samples following the last acknowledged read position in the cache.
+// The read position is only updated when the server acknowledged the data.
+// Returns the time in msec to wait before the next upload attempt.
+uint32_t C016_upload_batch(controllerIndex_t ControllerIndex) {
+  int fileNr  = 0;
+  int readPos = 0;
+
+  if (!ControllerCache.getReadFilePos(fileNr, readPos)) {
+    return C016_UPLOAD_INTERVAL_IDLE;
+  }
+
+  // The peek position is shared with P146 and the CSV dump, so it is restored after collecting the batch.
+  // P146 uses it as its read position, so do not upload (and delete) beyond it.
+  int        peekFileNr         = 0;
+  const int  peekReadPos        = ControllerCache.getPeekFilePos(peekFileNr);
+  const bool limitToPeekFilePos = (peekFileNr > 0) && (peekReadPos >= 0) && C016_cacheReaderEnabled();
+
+  if (limitToPeekFilePos && !C016_isBeforeFilePos(fileNr, readPos, peekFileNr, peekReadPos)) {
+    return C016_UPLOAD_INTERVAL_IDLE;
+  }
+
+  String body;
+
+  if (!body.reserve(C016_UPLOAD_MAX_BATCH_SIZE + 128)) {
+    return C016_UPLOAD_INTERVAL_RETRY;
+  }
+  ControllerCache.setPeekFilePos(fileNr, readPos);
+  size_t nrSamples = 0;
+  C016_binary_element element;
+  int newFileNr  = fileNr;
+  int newReadPos = readPos;
+
+  while (body.length() < C016_UPLOAD_MAX_BATCH_SIZE &&
+         (!limitToPeekFilePos || C016_isBeforeFilePos(newFileNr, newReadPos, peekFileNr, peekReadPos)) &&
+         ControllerCache.peek(reinterpret_cast<uint8_t *>(&element), sizeof(element))) {
+    C016_appendLineProtocol(body, element);
+    ++nrSamples;
+    newReadPos = ControllerCache.getPeekFilePos(newFileNr);
+
+    if (newReadPos < 0) { break; }
+  }
+
+  if (peekFileNr > 0) {
+    ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+  } else {
+    ControllerCache.resetpeek();
+  }
+
+  if (nrSamples == 0) {
+    return C016_UPLOAD_INTERVAL_IDLE;
+  }
+
+  if (newReadPos < 0) {
+    return C016_UPLOAD_INTERVAL_RETRY;
+  }
+
+  if (!body.isEmpty()) {
+    MakeControllerSettings(ControllerSettings); // -V522
+
+    if (!AllocatedControllerSettings()) {
+      return C016_UPLOAD_INTERVAL_RETRY;
+    }
+    LoadControllerSettings(ControllerIndex, *ControllerSettings);
+
+    // The acknowledgement is needed to know whether the data can be removed from the cache.
+    ControllerSettings->MustCheckReply = true;
+
+    String uri(ControllerSettings->Publish);
+
+    if (uri.isEmpty()) {
+      uri = F(C016_DEFAULT_UPLOAD_PATH);
+    }
+
+    int httpCode = -1;
+    send_via_http(
+      CPLUGIN_ID_016,
+      *ControllerSettings,
+      ControllerIndex,
+      uri,
+      F("POST"),
+      F("Content-Type: text/plain; charset=utf-8\r\n"),
+      body,
+      httpCode);
+
+    if ((httpCode < 200) || (httpCode >= 300)) {
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        addLogMove(LOG_LEVEL_ERROR, strformat(F("C016 : Upload of %d samples failed, HTTP code: %d"), static_cast<int>(nrSamples), httpCode));
+      }
+      return C016_UPLOAD_INTERVAL_RETRY;
+    }
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(F("C016 : Uploaded %d samples, read position %d;%d"), static_cast<int>(nrSamples), newFileNr, newReadPos));
+  }
+  ControllerCache.setReadFilePos(newFileNr, newReadPos);
+
+  // Continue quickly as long as there may be more data to upload.
+  return 0;
+}
+
+# endif // if FEATURE_HTTP_CLIENT
+
 #endif // ifdef USES_C016
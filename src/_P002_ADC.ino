@@ -102,19 +102,20 @@ boolean Plugin_002(uint8_t function, struct EventStruct *event, String& string)
       if (nullptr != P002_data) {
         success = true;
         P002_data->init(event);
+# if FEATURE_ADC_CONTINUOUS
+        P002_data->startContinuousSampling(event);
+# endif // if FEATURE_ADC_CONTINUOUS
       }
       break;
     }
     case PLUGIN_TEN_PER_SECOND:
     {
-      if (P002_OVERSAMPLING != P002_USE_CURENT_SAMPLE) // Use multiple samples
-      {
-        P002_data_struct *P002_data =
-          static_cast<P002_data_struct *>(getPluginTaskData(event->TaskIndex));
+      // Also called when using the current sample, to keep reading the continuous sampling buffer
+      P002_data_struct *P002_data =
+        static_cast<P002_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-        if (nullptr != P002_data) {
-          P002_data->takeSample();
-        }
+      if (nullptr != P002_data) {
+        P002_data->takeSample();
       }
       success = true;
       break;
@@ -137,7 +138,7 @@ boolean Plugin_002(uint8_t function, struct EventStruct *event, String& string)
             raw_value,
             formatUserVarNoCheck(event, 0).c_str());
 
-          if (P002_OVERSAMPLING == P002_USE_OVERSAMPLING) {
+          if ((P002_OVERSAMPLING == P002_USE_OVERSAMPLING) || (P002_OVERSAMPLING == P002_USE_RMS)) {
             log += strformat(F(" (%u samples)"), P002_data->getOversamplingCount());
           }
           addLogMove(LOG_LEVEL_INFO, log);
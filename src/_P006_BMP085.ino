@@ -82,7 +82,7 @@ boolean Plugin_006(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_INIT:
     {
-      initPluginTaskData(event->TaskIndex, new (std::nothrow) P006_data_struct());
+      initPluginTaskData(event->TaskIndex, new (std::nothrow) P006_data_struct(event->TaskIndex, PCONFIG(1)));
       P006_data_struct *P006_data =
         static_cast<P006_data_struct *>(getPluginTaskData(event->TaskIndex));
 
@@ -96,24 +96,19 @@ boolean Plugin_006(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P006_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P006_data) {
-        if (P006_data->begin())
-        {
-          UserVar.setFloat(event->TaskIndex, 0, P006_data->readTemperature());
-          int   elev     = PCONFIG(1);
-          float pressure = static_cast<float>(P006_data->readPressure()) / 100.0f;
-
-          if (elev != 0)
-          {
-            pressure = pressureElevation(pressure, elev);
-          }
-          UserVar.setFloat(event->TaskIndex, 1, pressure);
-
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            addLog(LOG_LEVEL_INFO, concat(F("BMP  : Temperature: "), formatUserVarNoCheck(event, 0)));
-            addLog(LOG_LEVEL_INFO, concat(F("BMP  : Barometric Pressure: "), formatUserVarNoCheck(event, 1)));
-          }
-          success = true;
-        }
+        // Starts a new measurement, values are set when the measurement is finished.
+        success = P006_data->plugin_read(event);
+      }
+      break;
+    }
+
+    case PLUGIN_TASKTIMER_IN:
+    {
+      P006_data_struct *P006_data =
+        static_cast<P006_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P006_data) {
+        success = P006_data->plugin_tasktimer_in(event);
       }
       break;
     }
@@ -88,7 +88,7 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
     {
       if (P020_Emulate_P044) {
         Device[++deviceCount].Number       = PLUGIN_ID_020_044;
-        Device[deviceCount].SendDataOption = false;
+        Device[deviceCount].SendDataOption = P020_FEATURE_OBIS_PARSER; // Only the OBIS values are sent
       } else {
         Device[++deviceCount].Number       = PLUGIN_ID_020;
         Device[deviceCount].SendDataOption = true;
@@ -110,6 +110,45 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    # if P020_FEATURE_OBIS_PARSER
+    case PLUGIN_GET_DEVICEVALUECOUNT:
+    {
+      event->Par1 = P020_Events::P1WiFiGateway == static_cast<P020_Events>(P020_SERIAL_PROCESSING) ? P020_GET_OBIS_COUNT : 0;
+      success     = true;
+      break;
+    }
+
+    case PLUGIN_GET_DEVICEVTYPE:
+    {
+      const uint8_t valueCount = P020_Events::P1WiFiGateway == static_cast<P020_Events>(P020_SERIAL_PROCESSING) ? P020_GET_OBIS_COUNT : 0;
+
+      if ((valueCount > 0) && (valueCount <= VARS_PER_TASK)) {
+        const Sensor_VType vtypes[] = {
+          Sensor_VType::SENSOR_TYPE_SINGLE,
+          Sensor_VType::SENSOR_TYPE_DUAL,
+          Sensor_VType::SENSOR_TYPE_TRIPLE,
+          Sensor_VType::SENSOR_TYPE_QUAD
+        };
+        event->sensorType = vtypes[valueCount - 1];
+        success           = true;
+      }
+      break;
+    }
+
+    case PLUGIN_GET_DEVICEVALUENAMES:
+    {
+      if (P020_Events::P1WiFiGateway == static_cast<P020_Events>(P020_SERIAL_PROCESSING)) {
+        const uint8_t valueCount = P020_GET_OBIS_COUNT;
+
+        for (uint8_t i = 0; i < valueCount && i < VARS_PER_TASK; ++i) {
+          ExtraTaskSettings.setTaskDeviceValueName(i, concat(F("Obis"), i + 1));
+          ExtraTaskSettings.TaskDeviceValueDecimals[i] = 3;
+        }
+      }
+      break;
+    }
+    # endif // if P020_FEATURE_OBIS_PARSER
+
 
     case PLUGIN_SET_DEFAULTS:
     {
@@ -255,6 +294,25 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
           # endif // ifndef LIMIT_BUILD_SIZE
         }
       }
+      # if P020_FEATURE_OBIS_PARSER
+
+      if (P020_Events::P1WiFiGateway == static_cast<P020_Events>(P020_SERIAL_PROCESSING)) { // P1 values
+        addFormSubHeader(F("P1 values"));
+
+        const uint8_t obisCount = P020_GET_OBIS_COUNT;
+
+        for (uint8_t i = 0; i < P020_OBIS_MAX_CODES; ++i) {
+          addFormTextBox(concat(F("OBIS code "), i + 1),
+                         concat(F("pobis"), i),
+                         i < obisCount ? P020_ObisParser::obisCodeToString(P020_GET_OBIS_CODE(i)) : EMPTY_STRING,
+                         15);
+        }
+        # ifndef LIMIT_BUILD_SIZE
+        addFormNote(F("Format: A-B:C.D.E, like 1-0:1.8.1. The numeric value of each code is stored in the next task value."));
+        # endif // ifndef LIMIT_BUILD_SIZE
+      }
+      # endif // if P020_FEATURE_OBIS_PARSER
+
       { // Led settings
         addFormSubHeader(F("Led"));
 
@@ -263,6 +321,13 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         addFormCheckBox(F("Led inverted"), F("pledinv"), P020_GET_LED_INVERTED == 1);
       }
 
+      P020_Task *task = static_cast<P020_Task *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != task) {
+        addFormSubHeader(F("Statistics"));
+        task->_bridge.webformShowStats();
+      }
+
       success = true;
       break;
     }
@@ -305,6 +370,28 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
         bitWrite(lSettings, P020_FLAG_MULTI_LINE, isFormItemChecked(F("pmultiline")));
       }
 
+      # if P020_FEATURE_OBIS_PARSER
+
+      if (P020_Events::P1WiFiGateway == static_cast<P020_Events>(P020_SERIAL_PROCESSING)) {
+        uint8_t obisCount = 0;
+
+        for (uint8_t i = 0; i < P020_OBIS_MAX_CODES; ++i) {
+          // Store the valid codes without gaps
+          const uint32_t code = P020_ObisParser::parseObisCode(webArg(concat(F("pobis"), i)));
+
+          if (code != 0) {
+            P020_SET_OBIS_CODE(obisCount) = static_cast<long>(code);
+            ++obisCount;
+          }
+        }
+
+        for (uint8_t i = obisCount; i < P020_OBIS_MAX_CODES; ++i) {
+          P020_SET_OBIS_CODE(i) = 0;
+        }
+        set3BitToUL(lSettings, P020_FLAG_OBIS_COUNT, obisCount);
+      }
+      # endif // if P020_FEATURE_OBIS_PARSER
+
       P020_FLAGS = lSettings;
 
       success = true;
@@ -401,6 +488,10 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
       task->serial_processing = static_cast<P020_Events>(P020_SERIAL_PROCESSING);
       task->_P1EventData      = P020_GET_P1_EVENT_DATA;
+      task->bridgeBegin(P020_RX_BUFFER, P020_RX_WAIT);
+      # if P020_FEATURE_OBIS_PARSER
+      task->setObisCodes(event);
+      # endif // if P020_FEATURE_OBIS_PARSER
 
       task->blinkLED();
 
@@ -438,6 +529,7 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
 
       if (nullptr != task) {
         task->checkServer();
+        task->_bridge.updateStats();
         success = true;
       }
       break;
@@ -494,8 +586,7 @@ boolean Plugin_020(uint8_t function, struct EventStruct *event, String& string)
           task->ser2netSerial->flush();
           success = true;
         } else if ((equals(command, F("ser2netclientsend"))) && (task->hasClientConnected())) {
-          task->ser2netClient.print(string.substring(18));
-          task->ser2netClient.PR_9453_FLUSH_TO_CLEAR();
+          task->_bridge.send(string.substring(18));
           success = true;
         }
         break;
@@ -101,7 +101,7 @@ boolean Plugin_032(uint8_t function, struct EventStruct *event, String& string)
     {
       success = initPluginTaskData(
         event->TaskIndex,
-        new (std::nothrow) P032_data_struct(PCONFIG(0)));
+        new (std::nothrow) P032_data_struct(event->TaskIndex, PCONFIG(0), PCONFIG(1)));
       break;
     }
 
@@ -111,29 +111,19 @@ boolean Plugin_032(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P032_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P032_data) {
-        if (P032_data->begin()) {
-          P032_data->read_prom();
-          P032_data->readout();
-
-          UserVar.setFloat(event->TaskIndex, 0, P032_data->ms5611_temperature / 100);
-
-          const int elev = PCONFIG(1);
-
-          if (elev != 0)
-          {
-            UserVar.setFloat(event->TaskIndex, 1, pressureElevation(P032_data->ms5611_pressure, elev));
-          } else {
-            UserVar.setFloat(event->TaskIndex, 1, P032_data->ms5611_pressure);
-          }
-
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            addLog(LOG_LEVEL_INFO,
-                   concat(F("MS5611  : Temperature: "), formatUserVarNoCheck(event, 0)));
-            addLog(LOG_LEVEL_INFO,
-                   concat(F("MS5611  : Barometric Pressure: "), formatUserVarNoCheck(event, 1)));
-          }
-          success = true;
-        }
+        // Starts a new measurement, values are set when the measurement is finished.
+        success = P032_data->plugin_read(event);
+      }
+      break;
+    }
+
+    case PLUGIN_TASKTIMER_IN:
+    {
+      P032_data_struct *P032_data =
+        static_cast<P032_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P032_data) {
+        success = P032_data->plugin_tasktimer_in(event);
       }
       break;
     }
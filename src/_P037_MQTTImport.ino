@@ -11,6 +11,7 @@
 // This task reads data from the MQTT Import input stream and saves the value
 
 /**
+ * 2026-10-18, agent: Extract JSON attributes directly from the payload, supporting multiple sub-levels and array indices
  * 2023-06-17, tonhuisman: Replace Device[].FormulaOption by Device[].DecimalsOnly option, as no (successful) PLUGIN_READ is done
  * 2023-03-06, tonhuisman: Fix PLUGIN_INIT behavior to now always return success = true
  * 2022-12-13, tonhuisman: Implement separator character input selector
@@ -349,29 +350,12 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
       bool checkJson = false;
 
-      String subscriptionTopicParsed;
+      // The event is only dispatched to this task when at least one of its subscriptions matches the topic.
+      // Par1 holds the bitmask of the matching values, as found in MQTTimport_subscriptions.
+      const uint8_t matchedValues = event->Par1;
       # if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
-      bool processData = false;  // Don't do the for loop again if we're not going to match
-      // As we can receive quite a lot of topics not intended for this plugin,
-      // first do a quick check if the topic matches here, to try and avoid a bunch of unneeded mapping, filtering and logging
-      bool matchedTopic = false; // Ignore by default
-      subscriptionTopicParsed.reserve(80);
-
-      for (uint8_t x = 0; x < VARS_PER_TASK; x++)
-      {
-        if (P037_data->mqttTopics[x].length() == 0) {
-          continue; // skip blank subscriptions
-        }
-
-        // Now check if the incoming topic matches one of our subscriptions
-        subscriptionTopicParsed = P037_data->getFullMQTTTopic(x);
-        parseSystemVariables(subscriptionTopicParsed, false);
-
-        if (MQTTCheckSubscription_037(event->String1, subscriptionTopicParsed)) {
-          matchedTopic = true; // Yes we should process it here
-          processData  = true; // Allow going into second for loop
-        }
-      }
+      const bool matchedTopic = matchedValues != 0;
+      bool processData        = matchedTopic; // Don't do the for loop if we're not going to match
       # else // if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
       bool processData = true;
       # endif // if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
@@ -440,8 +424,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
         // json filter check
         if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
           do {
-            key     = P037_data->iter->key().c_str();
-            Payload = P037_data->iter->value().as<String>();
+            P037_data->json.next(key, Payload);
             #    if P037_MAPPING_SUPPORT
 
             if (P037_APPLY_MAPPINGS) {
@@ -449,8 +432,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             }
             #    endif // if P037_MAPPING_SUPPORT
             processData = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
-            ++P037_data->iter;
-          } while (processData && P037_data->iter != P037_data->doc.end());
+          } while (processData && !P037_data->json.atEnd());
         }
         #   endif // P037_FILTER_PER_TOPIC
         #  endif  // if P037_JSON_SUPPORT
@@ -474,15 +456,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
       // Get the Topic and see if it matches any of the subscriptions
       for (uint8_t x = 0; x < VARS_PER_TASK && processData; x++)
       {
-        if (P037_data->mqttTopics[x].length() == 0) {
-          continue; // skip blank subscriptions
-        }
-
-        // Now check if the incoming topic matches one of our subscriptions
-        subscriptionTopicParsed = P037_data->getFullMQTTTopic(x);
-        parseSystemVariables(subscriptionTopicParsed, false);
-
-        if (MQTTCheckSubscription_037(event->String1, subscriptionTopicParsed)) {
+        // Check if the incoming topic matches this subscription
+        if (bitRead(matchedValues, x)) {
           # if P037_JSON_SUPPORT
           #  ifdef P037_FILTER_PER_TOPIC
 
@@ -490,11 +465,10 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
           bool passFilter = true;
 
           if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
-            P037_data->iter = P037_data->doc.begin();
+            P037_data->json.rewind();
 
             do {
-              key     = P037_data->iter->key().c_str();
-              Payload = P037_data->iter->value().as<String>();
+              P037_data->json.next(key, Payload);
               #   if P037_MAPPING_SUPPORT
 
               if (P037_APPLY_MAPPINGS) {
@@ -502,10 +476,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
               }
               #   endif // if P037_MAPPING_SUPPORT
               passFilter = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
-
-              ++P037_data->iter;
-            } while (passFilter && P037_data->iter != P037_data->doc.end());
-            P037_data->iter = P037_data->doc.begin();
+            } while (passFilter && !P037_data->json.atEnd());
+            P037_data->json.rewind();
           }
 
           if (passFilter) // Watch it!
@@ -515,7 +487,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             do {
               # if P037_JSON_SUPPORT
 
-              if (checkJson && (P037_data->iter != P037_data->doc.end())) {
+              if (checkJson && !P037_data->json.atEnd()) {
                 String jsonIndex     = parseString(P037_data->jsonAttributes[x], 2, ';');
                 String jsonAttribute = parseStringKeepCase(P037_data->jsonAttributes[x], 1, ';');
                 jsonAttribute.trim();
@@ -523,13 +495,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                 if (!jsonAttribute.isEmpty()) {
                   key = jsonAttribute;
 
-                  if (key.indexOf('.') > -1) {
-                    String part1 = parseStringKeepCase(key, 1, '.');
-                    String part2 = parseStringKeepCase(key, 2, '.');
-                    Payload = P037_data->doc[part1][part2].as<String>();
-                  } else {
-                    Payload = P037_data->doc[key].as<String>();
-                  }
+                  // Nested attributes are separated by a '.'
+                  P037_data->json.getValue(key, Payload);
                   unparsedPayload = Payload;
                   int8_t jIndex = jsonIndex.toInt();
 
@@ -555,8 +522,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   #  endif // if !defined(P037_LIMIT_BUILD_SIZE) || defined(P037_OVERRIDE)
                   continueProcessing = false; // no need to loop over all attributes, the configured one is found
                 } else {
-                  key             = P037_data->iter->key().c_str();
-                  Payload         = P037_data->iter->value().as<String>();
+                  P037_data->json.next(key, Payload);
                   unparsedPayload = Payload;
                 }
                 #  ifdef PLUGIN_037_DEBUG
@@ -574,7 +540,6 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   addLogMove(LOG_LEVEL_INFO, log);
                 }
                 #  endif // ifdef PLUGIN_037_DEBUG
-                ++P037_data->iter;
               }
               #  if P037_MAPPING_SUPPORT
 
@@ -688,7 +653,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                 }
                 # if P037_JSON_SUPPORT
 
-                if (checkJson && (P037_data->iter == P037_data->doc.end())) {
+                if (checkJson && P037_data->json.atEnd()) {
                   continueProcessing = false;
                 }
                 # endif // if P037_JSON_SUPPORT
@@ -715,6 +680,9 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
 bool MQTT_unsubscribe_037(struct EventStruct *event)
 {
+  // No longer route incoming messages to this task
+  MQTTimport_subscriptions.removeTask(event->TaskIndex);
+
   P037_data_struct *P037_data = static_cast<P037_data_struct *>(getPluginTaskData(event->TaskIndex));
 
   if (nullptr == P037_data) {
@@ -791,6 +759,9 @@ bool MQTTSubscribe_037(struct EventStruct *event)
   // FIXME TD-er: Should not be needed to load, as it is loaded when constructing it.
   P037_data->loadSettings();
 
+  // Subscriptions are registered again, as topics may have changed
+  MQTTimport_subscriptions.removeTask(event->TaskIndex);
+
   // Now loop over all import variables and subscribe to those that are not blank
   for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
     String subscribeTo = P037_data->getFullMQTTTopic(x);
@@ -798,6 +769,9 @@ bool MQTTSubscribe_037(struct EventStruct *event)
     if (!subscribeTo.isEmpty()) {
       parseSystemVariables(subscribeTo, false);
 
+      // Incoming messages are routed to this task value via the topic trie
+      MQTTimport_subscriptions.add(subscribeTo, event->TaskIndex, x);
+
       if (MQTTclient.subscribe(subscribeTo.c_str())) {
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
           String log = F("IMPT : [");
@@ -821,93 +795,4 @@ bool MQTTSubscribe_037(struct EventStruct *event)
   return true;
 }
 
-//
-// Check to see if Topic matches the MQTT subscription
-//
-bool MQTTCheckSubscription_037(const String& Topic, const String& Subscription) {
-  if (Topic.isEmpty() || Subscription.isEmpty())  {
-    return false;
-  }
-
-  String tmpTopic = Topic;
-  String tmpSub   = Subscription;
-
-  tmpTopic.trim();
-  tmpSub.trim();
-
-  // Get rid of leading '/'
-  if (tmpTopic[0] == '/') { tmpTopic = tmpTopic.substring(1); }
-
-  if (tmpSub[0] == '/') { tmpSub = tmpSub.substring(1); }
-
-  // Test for multi-level wildcard (#) see: http://docs.oasis-open.org/mqtt/mqtt/v3.1.1/os/mqtt-v3.1.1-os.html#_Toc398718107 (for MQTT 3 and
-  // MQTT 5)
-
-  if (equals(tmpSub, '#')) { return true; } // If the subscription is for '#' then all topics are accepted
-
-  if (tmpSub.endsWith(F("/#"))) {           // A valid MQTT multi-level wildcard is a # at the end of the topic that's preceded by a /
-    bool multiLevelWildcard = tmpTopic.startsWith(tmpSub.substring(0, tmpSub.length() - 1));
-
-    if (tmpSub.indexOf('+') == -1) {
-      return multiLevelWildcard;                   // It matched, or not
-    }
-  } else {
-    if (tmpSub.indexOf('#') != -1) { return false; // Invalid topic
-    }
-  }
-
-  // Add trailing / if required
-
-  int lenTopic = tmpTopic.length();
-
-  if (tmpTopic.substring(lenTopic - 1, lenTopic) != "/") { tmpTopic += '/'; }
-
-  int lenSub = tmpSub.length();
-
-  if (tmpSub.substring(lenSub - 1, lenSub) != "/") { tmpSub += '/'; }
-
-  // Now get first part
-
-  int SlashTopic;
-  int SlashSub;
-  int count = 0;
-
-  String pTopic;
-  String pSub;
-
-  while (count < 10) {
-    //  Get locations of the first /
-
-    SlashTopic = tmpTopic.indexOf('/');
-    SlashSub   = tmpSub.indexOf('/');
-
-    //  If no slashes found then match is OK
-    //  If only one slash found then not OK
-
-    if ((SlashTopic == -1) && (SlashSub == -1)) { return true; }
-
-    if ((SlashTopic == -1) && (SlashSub != -1)) { return false; }
-
-    if ((SlashTopic != -1) && (SlashSub == -1)) { return false; }
-
-    //  Get the values for the current subtopic
-
-    pTopic = tmpTopic.substring(0, SlashTopic);
-    pSub   = tmpSub.substring(0, SlashSub);
-
-    //  And strip the subtopic from the topic
-
-    tmpTopic = tmpTopic.substring(SlashTopic + 1);
-    tmpSub   = tmpSub.substring(SlashSub + 1);
-
-    //  If the subtopics match then OK - otherwise fail
-    if (pSub == "#") { return true; }
-
-    if ((pTopic != pSub) && (!equals(pSub, '+'))) { return false; }
-
-    count = count + 1;
-  }
-  return false;
-}
-
 #endif // USES_P037
@@ -1,6 +1,8 @@
 #include "_Plugin_Helper.h"
 #ifdef USES_P072
 
+# include "src/PluginStructs/P072_data_struct.h"
+
 // ######################################################################################################
 // ####################### Plugin 072: Temperature and Humidity sensor HDC10xx (I2C) ####################
 // ######################################################################################################
@@ -17,9 +19,6 @@
 # define PLUGIN_VALUENAME1_072 "Temperature"
 # define PLUGIN_VALUENAME2_072 "Humidity"
 
-
-# define HDC1080_I2C_ADDRESS      0x40 // I2C address for the sensor
-
 boolean Plugin_072(uint8_t function, struct EventStruct *event, String& string)
 {
   boolean success = false;
@@ -74,51 +73,30 @@ boolean Plugin_072(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_INIT:
     {
-      success = true;
+      success = initPluginTaskData(event->TaskIndex, new (std::nothrow) P072_data_struct(event->TaskIndex));
       break;
     }
 
     case PLUGIN_READ:
     {
-      uint8_t  hdc1080_msb, hdc1080_lsb;
-      uint16_t hdc1080_rawtemp, hdc1080_rawhum;
-      float    hdc1080_temp, hdc1080_hum;
-
-      Wire.beginTransmission(HDC1080_I2C_ADDRESS); // start transmission to device
-      Wire.write(0x02);                            // sends HDC1080_CONFIGURATION
-      Wire.write(0b00000000);                      // set resolution to 14bits both for T and H
-      Wire.write(0x00);                            // **reserved**
-      Wire.endTransmission();                      // end transmission
-      delay(10);
-
-      Wire.beginTransmission(HDC1080_I2C_ADDRESS); // start transmission to device
-      Wire.write(0x00);                            // sends HDC1080_TEMPERATURE
-      Wire.endTransmission();                      // end transmission
-      delay(9);
-      Wire.requestFrom(HDC1080_I2C_ADDRESS, 2);    // read 2 bytes for temperature
-      hdc1080_msb     = Wire.read();
-      hdc1080_lsb     = Wire.read();
-      hdc1080_rawtemp = hdc1080_msb << 8 | hdc1080_lsb;
-      hdc1080_temp    = (static_cast<float>(hdc1080_rawtemp) / 65536.0f) * 165.0f - 40.0f;
-
-      Wire.beginTransmission(HDC1080_I2C_ADDRESS); // start transmission to device
-      Wire.write(0x01);                            // sends HDC1080_HUMIDITY
-      Wire.endTransmission();                      // end transmission
-      delay(9);
-      Wire.requestFrom(HDC1080_I2C_ADDRESS, 2);    // read 2 bytes for humidity
-      hdc1080_msb    = Wire.read();
-      hdc1080_lsb    = Wire.read();
-      hdc1080_rawhum = hdc1080_msb << 8 | hdc1080_lsb;
-      hdc1080_hum    = (static_cast<float>(hdc1080_rawhum) / 65536.0f) * 100.0f;
-
-      UserVar.setFloat(event->TaskIndex, 0, hdc1080_temp);
-      UserVar.setFloat(event->TaskIndex, 1, hdc1080_hum);
-
-      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-        addLogMove(LOG_LEVEL_INFO, concat(F("HDC10xx: Temperature: "), formatUserVarNoCheck(event, 0)));
-        addLogMove(LOG_LEVEL_INFO, concat(F("HDC10xx: Humidity: "), formatUserVarNoCheck(event, 1)));
+      P072_data_struct *P072_data =
+        static_cast<P072_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P072_data) {
+        // Starts a new measurement, values are set when the measurement is finished.
+        success = P072_data->plugin_read(event);
+      }
+      break;
+    }
+
+    case PLUGIN_TASKTIMER_IN:
+    {
+      P072_data_struct *P072_data =
+        static_cast<P072_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if (nullptr != P072_data) {
+        success = P072_data->plugin_tasktimer_in(event);
       }
-      success = true;
       break;
     }
   }
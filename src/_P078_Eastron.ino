@@ -146,6 +146,12 @@ boolean Plugin_078(uint8_t function, struct EventStruct *event, String& string)
         addRowLabel(F("Checksum (pass/fail)"));
         addHtml(strformat(F("%d/%d"),
                           Plugin_078_SDM->getSuccCount(), Plugin_078_SDM->getErrCount()));
+
+        uint32_t requests{};
+        uint32_t values{};
+        SDM_getRegisterReadQueueStats(requests, values);
+        addRowLabel(F("Requests (values read/saved requests)"));
+        addHtml(strformat(F("%u (%u/%u)"), requests, values, values - requests));
       }
 
       break;
@@ -293,6 +293,10 @@ boolean Plugin_095(uint8_t function, struct EventStruct *event, String& string)
 
       addFormCheckBox(F("Clear display on exit"), F("clearOnExit"), bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_CLEAR_ON_EXIT));
 
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      AdaGFXFormShadowBuffer(F("shadow"), bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_SHADOW_BUFFER));
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
       {
         const __FlashStringHelper *commandTriggers[] = { // Be sure to use all options available in the enum (except MAX)!
           F("tft"),
@@ -399,6 +403,9 @@ boolean Plugin_095(uint8_t function, struct EventStruct *event, String& string)
       set4BitToUL(lSettings, P095_CONFIG_FLAG_FONTSCALE,   getFormItemInt(F("fontscale")));       // Bit 12..15 Font scale
       set4BitToUL(lSettings, P095_CONFIG_FLAG_MODE,        getFormItemInt(F("tpmode")));          // Bit 16..19 Text print mode
       set4BitToUL(lSettings, P095_CONFIG_FLAG_TYPE,        getFormItemInt(F("dsptype")));         // Bit 20..24 Hardwaretype
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      bitWrite(lSettings, P095_CONFIG_FLAG_SHADOW_BUFFER, isFormItemChecked(F("shadow")));        // Bit 25 Shadow buffer
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
       P095_CONFIG_FLAGS = lSettings;
 
       {
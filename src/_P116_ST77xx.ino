@@ -206,6 +206,10 @@ boolean Plugin_116(uint8_t function, struct EventStruct *event, String& string)
 
       addFormCheckBox(F("Clear display on exit"), F("clearOnExit"), bitRead(P116_CONFIG_FLAGS, P116_CONFIG_FLAG_CLEAR_ON_EXIT));
 
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      AdaGFXFormShadowBuffer(F("shadow"), bitRead(P116_CONFIG_FLAGS, P116_CONFIG_FLAG_SHADOW_BUFFER));
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
       {
         const __FlashStringHelper *commandTriggers[] = { // Be sure to use all options available in the enum (except MAX)!
           P116_CommandTrigger_toString(P116_CommandTrigger::tft),
@@ -289,6 +293,9 @@ boolean Plugin_116(uint8_t function, struct EventStruct *event, String& string)
       set4BitToUL(lSettings, P116_CONFIG_FLAG_CMD_TRIGGER, getFormItemInt(F("commandtrigger")));  // Bit 20..23 Command trigger
 
       bitWrite(lSettings, P116_CONFIG_FLAG_BACK_FILL, !isFormItemChecked(F("backfill")));         // Bit 28 Back fill text (inv)
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      bitWrite(lSettings, P116_CONFIG_FLAG_SHADOW_BUFFER, isFormItemChecked(F("shadow")));        // Bit 29 Shadow buffer
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
       P116_CONFIG_FLAGS = lSettings;
 
       String   color   = webArg(F("foregroundcolor"));
@@ -83,7 +83,7 @@ ExecuteCommandArgs::ExecuteCommandArgs(
   _tryRemoteConfig(tryRemoteConfig) {}
 
 
-std::list<ExecuteCommandArgs> ExecuteCommand_queue;
+PooledList<ExecuteCommandArgs, ObjectPool_e::ExecuteCommand> ExecuteCommand_queue;
 
 bool processExecuteCommandQueue()
 {
@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/ObjectPool.h"
 #include "../DataTypes/EventValueSource.h"
 #include "../DataTypes/TaskIndex.h"
 
@@ -48,7 +49,7 @@ struct ExecuteCommandArgs {
   bool                   _tryRemoteConfig = false;
 };
 
-extern std::list<ExecuteCommandArgs> ExecuteCommand_queue;
+extern PooledList<ExecuteCommandArgs, ObjectPool_e::ExecuteCommand> ExecuteCommand_queue;
 
 bool processExecuteCommandQueue();
 
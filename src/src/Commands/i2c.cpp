@@ -41,6 +41,12 @@ const __FlashStringHelper* Command_i2c_Scanner(struct EventStruct *event, const
     const bool dbg = equals(parseString(Line, 2), F("1"));
     I2CSelect_Max100kHz_ClockSpeed(); // Scan bus using low speed
 
+    #if FEATURE_I2CMULTIPLEXER
+
+    // The channel selected last is kept, deselect it so only devices on the base bus are found
+    I2CMultiplexerOff();
+    #endif // if FEATURE_I2CMULTIPLEXER
+
     i2c_scanI2Cbus(dbg, -1);          // Base I2C bus
 
     #if FEATURE_I2CMULTIPLEXER
@@ -1,5 +1,10 @@
 #include "../ControllerQueue/ControllerDelayHandlerStruct.h"
 
+#if FEATURE_CONTROLLER_WORKER_TASK
+# include "../ControllerQueue/ControllerWorker.h"
+# include "../Globals/ESPEasyWiFiEvent.h"
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+
 
 ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   lastSend(0),
@@ -11,7 +16,16 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
-  useLocalSystemTime(false) {}
+  useLocalSystemTime(false),
+  dropped_count(0) {}
+
+#if FEATURE_CONTROLLER_WORKER_TASK
+ControllerDelayHandlerStruct::~ControllerDelayHandlerStruct() {
+  // Worker task may still be referring to the front element of the queue.
+  ControllerWorker_waitIdle(this);
+}
+
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
 
 bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t ControllerIndex)
 {
@@ -22,6 +36,9 @@ bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t Con
   }
   LoadControllerSettings(ControllerIndex, *ControllerSettings);
   cacheControllerSettings(*ControllerSettings);
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  configureSpill(ControllerIndex, ControllerSettings->spillToFlash());
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   return true;
 }
 
@@ -53,10 +70,30 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
 
   // No less than 10 msec between messages.
   if (minTimeBetweenMessages < 10) { minTimeBetweenMessages = 10; }
+
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  adaptive_interval      = settings.adaptiveSendInterval();
+  maxTimeBetweenMessages = settings.MaxTimeBetweenMessages;
+
+  if (maxTimeBetweenMessages == 0) { maxTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT; }
+
+  if (maxTimeBetweenMessages < minTimeBetweenMessages) { maxTimeBetweenMessages = minTimeBetweenMessages; }
+
+  // Keep the current interval when still within the (possibly changed) limits.
+  if (!adaptive_interval || (sendInterval < minTimeBetweenMessages)) {
+    sendInterval = minTimeBetweenMessages;
+  } else if (sendInterval > maxTimeBetweenMessages) {
+    sendInterval = maxTimeBetweenMessages;
+  }
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
 }
 
 bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& element) const {
-  const protocolIndex_t protocolIndex = getProtocolIndex_from_ControllerIndex(element._controller_idx);
+  return readyToProcess(element._controller_idx);
+}
+
+bool ControllerDelayHandlerStruct::readyToProcess(controllerIndex_t controller_idx) const {
+  const protocolIndex_t protocolIndex = getProtocolIndex_from_ControllerIndex(controller_idx);
 
   if (protocolIndex == INVALID_PROTOCOL_INDEX) {
     return false;
@@ -69,6 +106,17 @@ bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& elem
 }
 
 bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) const {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (spill) {
+    // Elements will be stored on flash when the queue in RAM is full.
+    return false;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+  return memoryQueueFull(controller_idx);
+}
+
+bool ControllerDelayHandlerStruct::memoryQueueFull(controllerIndex_t controller_idx) const {
   if (sendQueue.size() >= max_queue_depth) { return true; }
 
   // Number of elements is not exceeding the limit, check memory
@@ -153,17 +201,46 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (isDuplicate(*element)) {
     return true;
   }
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (spill) {
+    // As long as there are elements stored on flash, new ones must be appended there too to keep the order.
+    if (!spill->empty() || memoryQueueFull(element->_controller_idx)) {
+      if (spill->write(*element, delete_oldest)) {
+        return true;
+      }
+
+      if (!spill->empty()) {
+        ++dropped_count;
+        return false;
+      }
+
+      // Element type cannot be stored on flash, use the queue in RAM.
+    }
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-    while (queueFull(element->_controller_idx)) {
+    while (memoryQueueFull(element->_controller_idx) && !sendQueue.empty()) {
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+      if (in_flight) {
+        // Front element is still being processed by the worker task, remove the next one.
+        if (sendQueue.size() < 2) { break; }
+        sendQueue.erase(std::next(sendQueue.begin()));
+        ++dropped_count;
+        continue;
+      }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
       sendQueue.pop_front();
       attempt = 0;
+      ++dropped_count;
     }
   }
 
-  if (!queueFull(element->_controller_idx)) {
+  if (!memoryQueueFull(element->_controller_idx)) {
     #ifdef USE_SECOND_HEAP
     // Do not store in 2nd heap, std::list cannot handle 2nd heap well
     HeapSelectDram ephemeral;
@@ -173,6 +250,7 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
 
     return true;
   }
+  ++dropped_count;
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -191,6 +269,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
   if (attempt > max_retries) {
     sendQueue.pop_front();
     attempt = 0;
+    ++dropped_count;
   }
 
   if (expire_timeout != 0) {
@@ -202,6 +281,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
       } else {
         sendQueue.pop_front();
         attempt = 0;
+        ++dropped_count;
       }
     }
   }
@@ -227,8 +307,16 @@ unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue
 }
 
 unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
-  if (sendQueue.empty()) { return 0; }
-  unsigned long nextTime = lastSend + minTimeBetweenMessages;
+  if (sendQueue.empty()) {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+    if (!spill || spill->empty())
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+    {
+      return 0;
+    }
+  }
+  unsigned long nextTime = lastSend + getSendInterval();
 
   if (timePassedSince(nextTime) > 0) {
     nextTime = millis();
@@ -239,6 +327,62 @@ unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
   return nextTime;
 }
 
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+void ControllerDelayHandlerStruct::registerSendResult(bool success, uint64_t duration_usec)
+{
+  const uint32_t duration = duration_usec > 0xFFFFFFFFull ? 0xFFFFFFFFul : static_cast<uint32_t>(duration_usec);
+
+  // Smoothed success rate with a gain of 1/16, in 0.01% units.
+  success_rate -= success_rate / 16;
+
+  if (success) {
+    success_rate += 10000 / 16;
+  }
+
+  // Only successful sends are used for the round trip time,
+  // as failed sends are typically aborted by a timeout.
+  // A send taking more than twice the usual round trip time indicates the server is getting busy.
+  const bool fast = success && ((rtt_usec == 0) || (duration <= 2 * rtt_usec));
+
+  if (success) {
+    // Smoothed round trip time with a gain of 1/8, like TCP SRTT.
+    if (rtt_usec == 0) {
+      rtt_usec = duration;
+    } else {
+      rtt_usec = rtt_usec - (rtt_usec / 8) + (duration / 8);
+    }
+  }
+
+  if (!adaptive_interval) {
+    return;
+  }
+
+  if (success) {
+    if (fast) {
+      // Additive decrease of the interval, thus increase of the send rate.
+      unsigned int step = (maxTimeBetweenMessages - minTimeBetweenMessages) / CONTROLLER_ADAPTIVE_INTERVAL_STEPS;
+
+      if (step == 0) { step = 1; }
+
+      sendInterval = (sendInterval > (minTimeBetweenMessages + step))
+                     ? sendInterval - step
+                     : minTimeBetweenMessages;
+    }
+  } else {
+    // Exponential back-off
+    sendInterval = (sendInterval > (maxTimeBetweenMessages / 2))
+                   ? maxTimeBetweenMessages
+                   : 2 * sendInterval;
+
+    // Also wait before retrying, lastSend is only updated on success.
+    if (timePassedSince(lastSend) >= 0) {
+      lastSend = millis();
+    }
+  }
+}
+
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
 // Set the "lastSend" to "now" + some additional delay.
 // This will cause the next schedule time to be delayed to
 // msecFromNow + minTimeBetweenMessages
@@ -263,18 +407,80 @@ void ControllerDelayHandlerStruct::process(
   TimingStatsElements                timerstats_id,
   SchedulerIntervalTimer_e timerID) 
 {
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+  if (in_flight) {
+    // Will be scheduled again when the worker task has finished.
+    return;
+  }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  restoreFromSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   Queue_element_base *element(static_cast<Queue_element_base *>(getNext()));
 
-  if (element == nullptr) { return; }
+  if (element == nullptr) {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+    if (spill && !spill->empty()) {
+      // Check again later whether the controller is able to send the stored elements.
+      Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+    return;
+  }
 
   if (readyToProcess(*element)) {
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+    if (ControllerWorker_active() && ControllerWorker_allowed(cpluginID)) {
+      // Settings object is owned by the job and deleted when the result is handled.
+      ControllerSettingsStruct *settings = new (std::nothrow) ControllerSettingsStruct;
+
+      if (settings != nullptr) {
+        LoadControllerSettings(element->_controller_idx, *settings);
+        cacheControllerSettings(*settings);
+
+        ControllerWorkerJob job;
+        job.handler       = this;
+        job.func          = func;
+        job.element       = element;
+        job.settings      = settings;
+        job.cpluginID     = cpluginID;
+        job.timerstats_id = timerstats_id;
+        job.timerID       = timerID;
+
+        // WiFiEventData is only accessed from the main loop.
+        job.suggestedTimeout = WiFiEventData.getSuggestedTimeout(cpluginID, settings->ClientTimeout);
+# if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+        job.partsSent     = element->getPartsSent();
+# endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+        if (ControllerWorker_submit(job)) {
+          in_flight = true;
+          return;
+        }
+        delete settings;
+      }
+    }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
     MakeControllerSettings(ControllerSettings);
 
     if (AllocatedControllerSettings()) {
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
       START_TIMER;
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+      const uint8_t  partsSent = element->getPartsSent();
+      const uint64_t sendStart = getMicros64();
+      const bool     success   = func(cpluginID, *element, *ControllerSettings);
+
+      // Only a send call which delivered nothing counts as failed.
+      registerSendResult(success || (element->getPartsSent() != partsSent), usecPassedSince(sendStart));
+      markProcessed(success);
+#else // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
       markProcessed(func(cpluginID, *element, *ControllerSettings));
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
       #if FEATURE_TIMING_STATS
       STOP_TIMER_VAR(timerstats_id);
       #endif
@@ -282,3 +488,62 @@ void ControllerDelayHandlerStruct::process(
   }
   Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
 }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+void ControllerDelayHandlerStruct::configureSpill(controllerIndex_t ControllerIndex, bool enabled)
+{
+  if (enabled) {
+    if (spill && (spill->getControllerIndex() == ControllerIndex)) {
+      return;
+    }
+    spill.reset(new (std::nothrow) ControllerQueueSpill(ControllerIndex));
+
+    if (spill) {
+      spill->begin();
+    }
+    return;
+  }
+
+  if (!spill || (spill->getControllerIndex() != ControllerIndex)) {
+    // Elements may still be present on flash from before a reboot
+    spill.reset(new (std::nothrow) ControllerQueueSpill(ControllerIndex));
+  }
+
+  if (spill) {
+    spill->clear();
+    spill.reset();
+  }
+}
+
+void ControllerDelayHandlerStruct::restoreFromSpill()
+{
+  if (!spill || spill->empty()) {
+    return;
+  }
+
+  // Only refill when at most half the queue is in use, to limit the number of flash accesses.
+  if (sendQueue.size() > (max_queue_depth / 2)) {
+    return;
+  }
+
+  if (!readyToProcess(spill->getControllerIndex())) {
+    return;
+  }
+
+  while (!spill->empty() && !memoryQueueFull(spill->getControllerIndex())) {
+    std::unique_ptr<Queue_element_base> element = spill->read();
+
+    if (!element) {
+      break;
+    }
+    # ifdef USE_SECOND_HEAP
+
+    // Do not store in 2nd heap, std::list cannot handle 2nd heap well
+    HeapSelectDram ephemeral;
+    # endif // ifdef USE_SECOND_HEAP
+
+    sendQueue.push_back(std::move(element));
+  }
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
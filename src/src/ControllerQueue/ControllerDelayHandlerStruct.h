@@ -4,8 +4,12 @@
 #include "../../ESPEasy_common.h"
 
 #include "../ControllerQueue/Queue_element_base.h"
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/ControllerQueueSpill.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
 #include "../DataStructs/ControllerSettingsStruct.h"
+#include "../DataStructs/ObjectPool.h"
 #include "../DataStructs/TimingStats.h"
 #include "../DataStructs/UnitMessageCount.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
@@ -28,6 +32,14 @@
   # define CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME 10000
 #endif // ifndef CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME
 
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+// Number of successful sends needed to go from the maximum to the minimum send interval.
+# ifndef CONTROLLER_ADAPTIVE_INTERVAL_STEPS
+#  define CONTROLLER_ADAPTIVE_INTERVAL_STEPS 32
+# endif // ifndef CONTROLLER_ADAPTIVE_INTERVAL_STEPS
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
 typedef bool (*do_process_function)(cpluginID_t,
                                     const Queue_element_base&,
                                     ControllerSettingsStruct&);
@@ -38,13 +50,23 @@ typedef bool (*do_process_function)(cpluginID_t,
 struct ControllerDelayHandlerStruct {
   ControllerDelayHandlerStruct();
 
+#if FEATURE_CONTROLLER_WORKER_TASK
+  ~ControllerDelayHandlerStruct();
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+
   bool cacheControllerSettings(controllerIndex_t ControllerIndex);
   void cacheControllerSettings(const ControllerSettingsStruct& settings);
 
   bool readyToProcess(const Queue_element_base& element) const;
 
+  bool readyToProcess(controllerIndex_t controller_idx) const;
+
+  // Return true when no more elements can be accepted.
   bool queueFull(controllerIndex_t controller_idx) const;
 
+  // Return true when the queue in RAM cannot hold more elements.
+  bool memoryQueueFull(controllerIndex_t controller_idx) const;
+
   // Return true if message is already present in the queue
   bool isDuplicate(const Queue_element_base& element) const;
 
@@ -63,6 +85,39 @@ struct ControllerDelayHandlerStruct {
 
   unsigned long getNextScheduleTime() const;
 
+  // Time between messages currently in use.
+  unsigned int  getSendInterval() const {
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+    if (adaptive_interval) {
+      return sendInterval;
+    }
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    return minTimeBetweenMessages;
+  }
+
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+  // Register the result and duration of a send attempt.
+  // With adaptive send interval enabled (AIMD):
+  // - Successful send, not slower than usual: decrease the interval by a fixed step
+  // - Failed send: double the interval
+  // The interval is kept between minTimeBetweenMessages and maxTimeBetweenMessages.
+  void     registerSendResult(bool     success,
+                              uint64_t duration_usec);
+
+  // Smoothed round trip time of successful sends
+  uint32_t getRoundTripTime_usec() const {
+    return rtt_usec;
+  }
+
+  // Smoothed ratio of successful sends in 0.01% units
+  uint16_t getSuccessRate() const {
+    return success_rate;
+  }
+
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
   // Set the "lastSend" to "now" + some additional delay.
   // This will cause the next schedule time to be delayed to
   // msecFromNow + minTimeBetweenMessages
@@ -70,13 +125,47 @@ struct ControllerDelayHandlerStruct {
 
   size_t getQueueMemorySize() const;
 
+  // Number of messages removed from the queue without being processed successfully.
+  // (queue full, expired or max retries reached)
+  uint32_t getDroppedCount() const {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+    if (spill) {
+      return dropped_count + spill->getDroppedCount();
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+    return dropped_count;
+  }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Enable or disable storing elements on flash when the queue in RAM is full.
+  // When disabled, all elements stored on flash for this controller are removed.
+  void configureSpill(controllerIndex_t ControllerIndex,
+                      bool              enabled);
+
+  // Number of elements stored on flash
+  uint32_t getSpillCount() const {
+    return spill ? spill->size() : 0;
+  }
+
+  size_t getSpillFlashUsage() const {
+    return spill ? spill->getFlashUsage() : 0;
+  }
+
+  // Move elements stored on flash back into the queue, when the controller is ready to send.
+  // Called from process(), controllers not using process() must call this before getNext().
+  void restoreFromSpill();
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   void   process(
     cpluginID_t                        cpluginID,
     do_process_function                func,
     TimingStatsElements                timerstats_id,
     SchedulerIntervalTimer_e timerID);
 
-  std::list<std::unique_ptr<Queue_element_base> >sendQueue;
+  PooledList<std::unique_ptr<Queue_element_base>, ObjectPool_e::ControllerQueue>sendQueue;
   mutable UnitLastMessageCount_map               unitLastMessageCount;
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
@@ -88,6 +177,29 @@ struct ControllerDelayHandlerStruct {
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
   bool                                           useLocalSystemTime     = false;
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  bool                                           adaptive_interval      = false;
+  unsigned int                                   maxTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT;
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+  // Front element of the queue is being processed by the controller worker task
+  bool in_flight = false;
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+
+private:
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  std::unique_ptr<ControllerQueueSpill> spill;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  uint32_t dropped_count = 0;
+
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  unsigned int sendInterval = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
+  uint32_t     rtt_usec     = 0;
+  uint16_t     success_rate = 10000;
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
 };
 
 
@@ -0,0 +1,477 @@
+#include "../ControllerQueue/ControllerQueueSpill.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/StringConverter.h"
+
+# if FEATURE_MQTT
+#  include "../ControllerQueue/MQTT_queue_element.h"
+# endif // if FEATURE_MQTT
+# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
+# include "../ControllerQueue/SimpleQueueElement_string_only.h"
+
+# include <vector>
+
+# define CONTROLLER_QUEUE_SPILL_VERSION      1
+# define CONTROLLER_QUEUE_SPILL_HEADER_SIZE  8
+
+// Record: uint16_t length, uint8_t type, data, uint16_t CRC16
+# define CONTROLLER_QUEUE_SPILL_RECORD_OVERHEAD  5
+
+static_assert(CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS >= 2, "Need at least 2 segments to rotate");
+static_assert(CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE <= 65535, "Segment size must fit in uint16_t record length");
+
+
+ControllerQueueSpill::ControllerQueueSpill(controllerIndex_t controllerIndex) :
+  _controllerIndex(controllerIndex),
+  _cpluginID(getCPluginID_from_ControllerIndex(controllerIndex))
+{}
+
+ControllerQueueSpill::~ControllerQueueSpill()
+{
+  if (_readFile) {
+    _readFile.close();
+  }
+}
+
+void ControllerQueueSpill::begin()
+{
+  _hasSegments = false;
+  _nrElements  = 0;
+
+  uint32_t lowest       = 0;
+  uint32_t highest      = 0;
+  size_t   highest_size = 0;
+  bool     corrupt_tail = false;
+
+  for (uint32_t slot = 0; slot < CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS; ++slot) {
+    _segmentElements[slot] = 0;
+    const String fname = getFilename(slot);
+
+    if (!fileExists(fname)) { continue; }
+
+    fs::File f = tryOpenFile(fname, F("r"), FileDestination_e::FLASH);
+    uint8_t  header[CONTROLLER_QUEUE_SPILL_HEADER_SIZE]{};
+    bool     valid = false;
+
+    if (f && (f.read(header, sizeof(header)) == sizeof(header))) {
+      valid = header[0] == 'C' &&
+              header[1] == 'Q' &&
+              header[2] == CONTROLLER_QUEUE_SPILL_VERSION &&
+              header[3] == _cpluginID;
+    }
+
+    if (valid) {
+      const uint32_t sequence =
+        header[4] | (header[5] << 8) | (header[6] << 16) | (static_cast<uint32_t>(header[7]) << 24);
+
+      if ((sequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS) != slot) {
+        valid = false;
+      } else {
+        uint16_t nrRecords    = 0;
+        const size_t validEnd = scanSegment(f, nrRecords);
+
+        if (nrRecords == 0) {
+          valid = false;
+        } else {
+          if (!_hasSegments || (static_cast<int32_t>(sequence - lowest) < 0)) {
+            lowest = sequence;
+          }
+
+          if (!_hasSegments || (static_cast<int32_t>(sequence - highest) > 0)) {
+            highest      = sequence;
+            highest_size = validEnd;
+            corrupt_tail = validEnd < f.size();
+          }
+          _segmentElements[slot] = nrRecords;
+          _nrElements           += nrRecords;
+          _hasSegments           = true;
+        }
+      }
+    }
+
+    if (f) {
+      f.close();
+    }
+
+    if (!valid) {
+      tryDeleteFile(fname, FileDestination_e::FLASH);
+    }
+  }
+
+  if (!_hasSegments) {
+    return;
+  }
+
+  if ((highest - lowest) >= CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS) {
+    // Should not happen, the segments do not belong together.
+    clear();
+    return;
+  }
+
+  for (uint32_t sequence = lowest; sequence != highest; ++sequence) {
+    if (_segmentElements[sequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS] == 0) {
+      // Gap in the sequence, thus not a single run of segments.
+      clear();
+      return;
+    }
+  }
+
+  _readSequence  = lowest;
+  _readPos       = CONTROLLER_QUEUE_SPILL_HEADER_SIZE;
+  _writeSequence = highest;
+
+  // Do not append after a corrupt record, as those records cannot be read.
+  _writePos = corrupt_tail ? CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE : highest_size;
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("Spill: Controller %d: %u queued messages found on flash"),
+                 _controllerIndex + 1,
+                 static_cast<unsigned int>(_nrElements)));
+  }
+}
+
+bool ControllerQueueSpill::write(const Queue_element_base& element, bool deleteOldest)
+{
+  const Queue_element_type_e type = element.getType();
+
+  if (type == Queue_element_type_e::NotSupported) {
+    return false;
+  }
+
+  std::vector<uint8_t> record;
+
+  record.reserve(element.getSize());
+
+  // Placeholder for length
+  record.push_back(0);
+  record.push_back(0);
+  record.push_back(static_cast<uint8_t>(type));
+  {
+    Queue_element_writer writer(record);
+
+    if (!element.serialize(writer)) {
+      return false;
+    }
+  }
+  const size_t length = record.size() - 3;
+
+  if ((length + CONTROLLER_QUEUE_SPILL_RECORD_OVERHEAD + CONTROLLER_QUEUE_SPILL_HEADER_SIZE) > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE) {
+    return false;
+  }
+  record[0] = length & 0xFF;
+  record[1] = length >> 8;
+  {
+    // CRC of type + data
+    const uint16_t crc = calc_CRC16(reinterpret_cast<const char *>(&record[2]), record.size() - 2);
+    record.push_back(crc & 0xFF);
+    record.push_back(crc >> 8);
+  }
+
+  if (!_hasSegments) {
+    if (!startSegment(_writeSequence + 1)) {
+      return false;
+    }
+  } else if ((_writePos + record.size()) > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE) {
+    const uint32_t nextSequence = _writeSequence + 1;
+
+    if ((nextSequence - _readSequence) >= CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS) {
+      if (!deleteOldest) {
+        return false;
+      }
+
+      // Make room by removing the oldest segment
+      removeReadSegment();
+    }
+
+    if (SpiffsFreeSpace() < (CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE + SpiffsBlocksize())) {
+      if (!deleteOldest || (_readSequence == _writeSequence)) {
+        return false;
+      }
+      removeReadSegment();
+    }
+
+    if (!startSegment(nextSequence)) {
+      return false;
+    }
+  }
+
+  if (_readFile && (_readSequence == _writeSequence)) {
+    // Re-open the file for reading after appending
+    _readFile.close();
+  }
+
+  fs::File f = tryOpenFile(getFilename(_writeSequence), F("a"), FileDestination_e::FLASH);
+
+  if (!f) {
+    return false;
+  }
+  const size_t written = f.write(&record[0], record.size());
+
+  f.close();
+
+  if (written != record.size()) {
+    // Do not append to a segment with an incomplete record.
+    _writePos = CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE;
+    return false;
+  }
+  _writePos += record.size();
+  ++_segmentElements[_writeSequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS];
+  ++_nrElements;
+  return true;
+}
+
+std::unique_ptr<Queue_element_base> ControllerQueueSpill::read()
+{
+  while (_hasSegments && (_nrElements > 0)) {
+    const uint32_t slot = _readSequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS;
+
+    if (_segmentElements[slot] == 0) {
+      removeReadSegment();
+      continue;
+    }
+
+    if (!openReadSegment()) {
+      removeReadSegment();
+      continue;
+    }
+
+    uint8_t recordHeader[3]{};
+
+    if (_readFile.read(recordHeader, sizeof(recordHeader)) != sizeof(recordHeader)) {
+      removeReadSegment();
+      continue;
+    }
+    const uint16_t length = recordHeader[0] | (recordHeader[1] << 8);
+
+    if (length > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE) {
+      removeReadSegment();
+      continue;
+    }
+    std::vector<uint8_t> data;
+
+    // Type + data + CRC
+    data.resize(length + 3);
+    data[0] = recordHeader[2];
+
+    if (_readFile.read(&data[1], length + 2) != static_cast<size_t>(length + 2)) {
+      removeReadSegment();
+      continue;
+    }
+    const uint16_t crc = data[length + 1] | (data[length + 2] << 8);
+
+    if (crc != static_cast<uint16_t>(calc_CRC16(reinterpret_cast<const char *>(&data[0]), length + 1))) {
+      addLog(LOG_LEVEL_ERROR, F("Spill: CRC error, skip segment"));
+      removeReadSegment();
+      continue;
+    }
+
+    _readPos += length + CONTROLLER_QUEUE_SPILL_RECORD_OVERHEAD;
+    --_segmentElements[slot];
+    --_nrElements;
+
+    std::unique_ptr<Queue_element_base> element = createElement(static_cast<Queue_element_type_e>(data[0]));
+
+    if (element) {
+      Queue_element_reader reader(&data[1], length);
+
+      if (!element->deserialize(reader)) {
+        element.reset();
+      }
+    }
+
+    if (_segmentElements[slot] == 0) {
+      // Free the flash as soon as possible
+      removeReadSegment();
+    }
+
+    if (element) {
+      return element;
+    }
+    ++_droppedCount;
+  }
+  return nullptr;
+}
+
+void ControllerQueueSpill::clear()
+{
+  if (_readFile) {
+    _readFile.close();
+  }
+
+  for (uint32_t slot = 0; slot < CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS; ++slot) {
+    const String fname = getFilename(slot);
+
+    if (fileExists(fname)) {
+      tryDeleteFile(fname, FileDestination_e::FLASH);
+    }
+    _segmentElements[slot] = 0;
+  }
+  _nrElements  = 0;
+  _hasSegments = false;
+}
+
+size_t ControllerQueueSpill::getFlashUsage() const
+{
+  if (!_hasSegments) {
+    return 0;
+  }
+
+  // Approximate, as only the size of the last segment is known.
+  return (_writeSequence - _readSequence) * CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE + _writePos;
+}
+
+String ControllerQueueSpill::getFilename(uint32_t sequence) const
+{
+  String fname;
+
+  # ifdef ESP32
+  fname = '/';
+  # endif // ifdef ESP32
+  fname += strformat(F("ctrlq%d_%d.bin"), _controllerIndex, static_cast<int>(sequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS));
+  return fname;
+}
+
+bool ControllerQueueSpill::startSegment(uint32_t sequence)
+{
+  const String fname = getFilename(sequence);
+
+  if (fileExists(fname)) {
+    tryDeleteFile(fname, FileDestination_e::FLASH);
+  }
+  fs::File f = tryOpenFile(fname, F("w"), FileDestination_e::FLASH);
+
+  if (!f) {
+    return false;
+  }
+  const uint8_t header[CONTROLLER_QUEUE_SPILL_HEADER_SIZE] = {
+    'C', 'Q', CONTROLLER_QUEUE_SPILL_VERSION, _cpluginID,
+    static_cast<uint8_t>(sequence & 0xFF),
+    static_cast<uint8_t>((sequence >> 8) & 0xFF),
+    static_cast<uint8_t>((sequence >> 16) & 0xFF),
+    static_cast<uint8_t>((sequence >> 24) & 0xFF)
+  };
+  const bool success = f.write(header, sizeof(header)) == sizeof(header);
+
+  f.close();
+
+  if (!success) {
+    tryDeleteFile(fname, FileDestination_e::FLASH);
+    return false;
+  }
+
+  _writeSequence = sequence;
+  _writePos      = CONTROLLER_QUEUE_SPILL_HEADER_SIZE;
+  _segmentElements[sequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS] = 0;
+
+  if (!_hasSegments) {
+    _readSequence = sequence;
+    _readPos      = CONTROLLER_QUEUE_SPILL_HEADER_SIZE;
+    _hasSegments  = true;
+  }
+  return true;
+}
+
+bool ControllerQueueSpill::openReadSegment()
+{
+  if (_readFile) {
+    return true;
+  }
+  _readFile = tryOpenFile(getFilename(_readSequence), F("r"), FileDestination_e::FLASH);
+
+  if (!_readFile) {
+    return false;
+  }
+  return _readFile.seek(_readPos);
+}
+
+void ControllerQueueSpill::removeReadSegment()
+{
+  if (_readFile) {
+    _readFile.close();
+  }
+  tryDeleteFile(getFilename(_readSequence), FileDestination_e::FLASH);
+
+  uint16_t& count = _segmentElements[_readSequence % CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS];
+
+  // Any elements left were not read, thus lost
+  _droppedCount += count;
+  _nrElements   -= count;
+  count          = 0;
+
+  if (_readSequence == _writeSequence) {
+    _hasSegments = false;
+    _nrElements  = 0;
+  } else {
+    ++_readSequence;
+  }
+  _readPos = CONTROLLER_QUEUE_SPILL_HEADER_SIZE;
+}
+
+size_t ControllerQueueSpill::scanSegment(fs::File& file, uint16_t& nrRecords) const
+{
+  size_t pos = CONTROLLER_QUEUE_SPILL_HEADER_SIZE;
+
+  nrRecords = 0;
+
+  if (!file.seek(pos)) {
+    return pos;
+  }
+  std::vector<uint8_t> data;
+
+  while (true) {
+    uint8_t recordHeader[3]{};
+
+    if (file.read(recordHeader, sizeof(recordHeader)) != sizeof(recordHeader)) {
+      return pos;
+    }
+    const uint16_t length = recordHeader[0] | (recordHeader[1] << 8);
+
+    if (length > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE) {
+      return pos;
+    }
+    data.resize(length + 3);
+    data[0] = recordHeader[2];
+
+    if (file.read(&data[1], length + 2) != static_cast<size_t>(length + 2)) {
+      return pos;
+    }
+    const uint16_t crc = data[length + 1] | (data[length + 2] << 8);
+
+    if (crc != static_cast<uint16_t>(calc_CRC16(reinterpret_cast<const char *>(&data[0]), length + 1))) {
+      return pos;
+    }
+    pos += length + CONTROLLER_QUEUE_SPILL_RECORD_OVERHEAD;
+    ++nrRecords;
+    delay(0);
+  }
+}
+
+std::unique_ptr<Queue_element_base> ControllerQueueSpill::createElement(Queue_element_type_e type)
+{
+  # ifdef USE_SECOND_HEAP
+
+  // Do not store in 2nd heap, std::list cannot handle 2nd heap well
+  HeapSelectDram ephemeral;
+  # endif // ifdef USE_SECOND_HEAP
+
+  switch (type) {
+  # if FEATURE_MQTT
+    case Queue_element_type_e::MQTT:
+      return std::unique_ptr<Queue_element_base>(new (std::nothrow) MQTT_queue_element());
+  # endif // if FEATURE_MQTT
+    case Queue_element_type_e::StringOnly:
+      return std::unique_ptr<Queue_element_base>(new (std::nothrow) simple_queue_element_string_only());
+    case Queue_element_type_e::FormattedStrings:
+      return std::unique_ptr<Queue_element_base>(new (std::nothrow) SimpleQueueElement_formatted_Strings());
+    default:
+      break;
+  }
+  return nullptr;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
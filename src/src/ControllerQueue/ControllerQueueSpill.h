@@ -0,0 +1,115 @@
+#ifndef CONTROLLERQUEUE_CONTROLLERQUEUESPILL_H
+#define CONTROLLERQUEUE_CONTROLLERQUEUESPILL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/Queue_element_base.h"
+
+# include <FS.h>
+# include <memory>
+
+# ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+#  define CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE  4096
+# endif // ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+
+# ifndef CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS
+#  define CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS  8
+# endif // ifndef CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS
+
+
+/*********************************************************************************************\
+* ControllerQueueSpill
+*
+* Store controller queue elements on the file system when the queue in RAM is full.
+* Elements are read back in the same order they were written.
+*
+* Elements are appended to segment files of at most CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE bytes.
+* A segment file is only deleted when all its elements have been read,
+* so stored data is never rewritten.
+* The segment files are used in a round robin fashion to spread the wear,
+* with at most CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS files per controller.
+*
+* Segment file:
+*  - header: "CQ", version, CPlugin ID, uint32_t sequence nr of the segment
+*  - records: uint16_t length, uint8_t element type, element data, uint16_t CRC16 of type + data
+*
+* N.B. The read position is only kept in RAM, so after a reboot the elements of
+*      a partially read segment will be sent again.
+\*********************************************************************************************/
+class ControllerQueueSpill {
+public:
+
+  explicit ControllerQueueSpill(controllerIndex_t controllerIndex);
+
+  ~ControllerQueueSpill();
+
+  ControllerQueueSpill(const ControllerQueueSpill& other)            = delete;
+  ControllerQueueSpill& operator=(const ControllerQueueSpill& other) = delete;
+
+  // Look for segments left on the file system, e.g. from before a reboot.
+  void                                begin();
+
+  // Append the element.
+  // When all segments are in use, the oldest segment is removed if deleteOldest is set.
+  // Returns false when the element could not be stored.
+  bool                                write(const Queue_element_base& element,
+                                            bool                      deleteOldest);
+
+  // Read the oldest stored element, nullptr when empty.
+  std::unique_ptr<Queue_element_base> read();
+
+  // Remove all stored elements.
+  void                                clear();
+
+  bool                                empty() const {
+    return _nrElements == 0;
+  }
+
+  uint32_t size() const {
+    return _nrElements;
+  }
+
+  size_t   getFlashUsage() const;
+
+  uint32_t getDroppedCount() const {
+    return _droppedCount;
+  }
+
+  controllerIndex_t getControllerIndex() const {
+    return _controllerIndex;
+  }
+
+private:
+
+  String   getFilename(uint32_t sequence) const;
+
+  bool     startSegment(uint32_t sequence);
+
+  bool     openReadSegment();
+
+  void     removeReadSegment();
+
+  // Count the records in the segment file, returns the file size.
+  size_t   scanSegment(fs::File& file,
+                       uint16_t& nrRecords) const;
+
+  static std::unique_ptr<Queue_element_base> createElement(Queue_element_type_e type);
+
+  fs::File          _readFile;
+  controllerIndex_t _controllerIndex;
+  cpluginID_t       _cpluginID;
+  uint32_t          _readSequence  = 0;
+  uint32_t          _writeSequence = 0;
+  uint32_t          _readPos       = 0;
+  uint32_t          _writePos      = 0;
+  uint32_t          _nrElements    = 0;
+  uint32_t          _droppedCount  = 0;
+  uint16_t          _segmentElements[CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS]{};
+  bool              _hasSegments = false;
+};
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+#endif // ifndef CONTROLLERQUEUE_CONTROLLERQUEUESPILL_H
@@ -0,0 +1,210 @@
+#include "../ControllerQueue/ControllerWorker.h"
+
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+# include "../DataStructs/TimingStats.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Globals/ESPEasy_Scheduler.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/_CPlugin_Helper.h"
+
+# ifndef CONTROLLER_WORKER_LOG_QUEUE_SIZE
+#  define CONTROLLER_WORKER_LOG_QUEUE_SIZE 16 // Must be a power of 2
+# endif // ifndef CONTROLLER_WORKER_LOG_QUEUE_SIZE
+
+struct ControllerWorkerLogLine {
+  String  line;
+  uint8_t logLevel = 0;
+};
+
+static SPSC_Queue<ControllerWorkerJob, CONTROLLER_WORKER_QUEUE_SIZE> controllerWorker_requests;
+static SPSC_Queue<ControllerWorkerJob, CONTROLLER_WORKER_QUEUE_SIZE> controllerWorker_results;
+static SPSC_Queue<ControllerWorkerLogLine, CONTROLLER_WORKER_LOG_QUEUE_SIZE> controllerWorker_log;
+
+// Only accessed from the main loop
+static uint8_t controllerWorker_inFlight = 0;
+
+// Only accessed from the worker task
+static ControllerWorkerJob *controllerWorker_currentJob = nullptr;
+
+static TaskHandle_t controllerWorker_taskHandle = nullptr;
+static volatile bool controllerWorker_running   = false;
+
+
+static void controllerWorker_notify() {
+  if (controllerWorker_taskHandle != nullptr) {
+    xTaskNotifyGive(controllerWorker_taskHandle);
+  }
+}
+
+static void controllerWorker_wait(uint32_t timeout_ms) {
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+}
+
+static void controllerWorker_loop(void *parameter) {
+  while (controllerWorker_running) {
+    controllerWorker_wait(100);
+
+    ControllerWorkerJob job;
+
+    while (controllerWorker_requests.pop(job)) {
+      const uint64_t start = getMicros64();
+
+      if ((job.func != nullptr) && (job.element != nullptr) && (job.settings != nullptr)) {
+        controllerWorker_currentJob = &job;
+        job.success                 = job.func(job.cpluginID, *job.element, *job.settings);
+        controllerWorker_currentJob = nullptr;
+      }
+      job.duration_usec = usecPassedSince(start);
+
+      // The results queue is as large as the requests queue,
+      // and the main loop never has more jobs in flight than it can hold.
+      while (!controllerWorker_results.push(job)) {
+        delay(1);
+      }
+    }
+  }
+  controllerWorker_taskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+bool ControllerWorker_start() {
+  if (controllerWorker_running) { return true; }
+  controllerWorker_running = true;
+
+  if (xTaskCreatePinnedToCore(
+        controllerWorker_loop,
+        "ControllerWorker",
+        CONTROLLER_WORKER_STACK_SIZE,
+        nullptr,
+        CONTROLLER_WORKER_PRIORITY,
+        &controllerWorker_taskHandle,
+        CONTROLLER_WORKER_CORE) != pdPASS) {
+    controllerWorker_taskHandle = nullptr;
+    controllerWorker_running    = false;
+    addLog(LOG_LEVEL_ERROR, F("Ctrl : Could not start controller worker task"));
+    return false;
+  }
+  addLog(LOG_LEVEL_INFO, F("Ctrl : Controller worker task started"));
+  return true;
+}
+
+void ControllerWorker_stop() {
+  if (!controllerWorker_running) { return; }
+
+  // Finish all jobs in flight
+  ControllerWorker_waitIdle(nullptr);
+  controllerWorker_running = false;
+  controllerWorker_notify();
+}
+
+bool ControllerWorker_active() {
+  return controllerWorker_running;
+}
+
+bool ControllerWorker_allowed(cpluginID_t cpluginID) {
+  switch (cpluginID) {
+    case 1:  // Domoticz HTTP
+    case 3:  // Nodo telnet
+    case 8:  // Generic HTTP
+    case 10: // Generic UDP
+    case 11: // Generic HTTP Advanced
+      return true;
+  }
+
+  // e.g. C012/C015 use the Blynk client, C016 writes to the cache files
+  // and C018 uses the LoRa module, which are also accessed from the main loop.
+  return false;
+}
+
+bool ControllerWorker_inWorkerTask() {
+  if (!controllerWorker_running) { return false; }
+  return xTaskGetCurrentTaskHandle() == controllerWorker_taskHandle;
+}
+
+bool ControllerWorker_submit(const ControllerWorkerJob& job) {
+  if (!controllerWorker_running || (job.handler == nullptr)) {
+    return false;
+  }
+
+  if (!controllerWorker_requests.push(job)) {
+    return false;
+  }
+  ++controllerWorker_inFlight;
+  controllerWorker_notify();
+  return true;
+}
+
+bool ControllerWorker_processResult() {
+  {
+    // Log lines added from the worker task are processed in the main loop.
+    ControllerWorkerLogLine logLine;
+
+    while (controllerWorker_log.pop(logLine)) {
+      addLogMove(logLine.logLevel, logLine.line);
+    }
+  }
+  ControllerWorkerJob job;
+
+  if (!controllerWorker_results.pop(job)) {
+    return false;
+  }
+
+  if (controllerWorker_inFlight > 0) {
+    --controllerWorker_inFlight;
+  }
+
+  if (job.connectResult != 0) {
+    register_connection_result(job.connectResult > 0, job.connectLabel, job.cpluginID, job.connectDuration_ms);
+  }
+
+  if (job.handler != nullptr) {
+    job.handler->in_flight = false;
+# if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    // Only a send call which delivered nothing counts as failed.
+    const bool delivered = job.success ||
+                           ((job.element != nullptr) && (job.element->getPartsSent() != job.partsSent));
+    job.handler->registerSendResult(delivered, job.duration_usec);
+# endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    job.handler->markProcessed(job.success);
+    # if FEATURE_TIMING_STATS
+    addMiscTimerStat(job.timerstats_id, job.duration_usec);
+    # endif // if FEATURE_TIMING_STATS
+    Scheduler.scheduleNextDelayQueue(job.timerID, job.handler->getNextScheduleTime());
+  }
+  delete job.settings;
+  return true;
+}
+
+void ControllerWorker_waitIdle(const ControllerDelayHandlerStruct *handler) {
+  while (controllerWorker_inFlight > 0 &&
+         (handler == nullptr || handler->in_flight)) {
+    if (!ControllerWorker_processResult()) {
+      delay(1);
+    }
+  }
+}
+
+void ControllerWorker_registerConnectResult(bool success, const __FlashStringHelper *prefix, uint32_t connectDuration_ms) {
+  if (controllerWorker_currentJob == nullptr) { return; }
+  controllerWorker_currentJob->connectResult      = success ? 1 : -1;
+  controllerWorker_currentJob->connectLabel       = prefix;
+  controllerWorker_currentJob->connectDuration_ms = connectDuration_ms;
+}
+
+uint32_t ControllerWorker_getSuggestedTimeout(uint32_t minimum_timeout) {
+  if ((controllerWorker_currentJob == nullptr) || (controllerWorker_currentJob->suggestedTimeout == 0)) {
+    return minimum_timeout;
+  }
+  return controllerWorker_currentJob->suggestedTimeout;
+}
+
+bool ControllerWorker_addLog(uint8_t logLevel, String&& line) {
+  ControllerWorkerLogLine logLine;
+
+  logLine.logLevel = logLevel;
+  logLine.line     = std::move(line);
+  return controllerWorker_log.push(std::move(logLine));
+}
+
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
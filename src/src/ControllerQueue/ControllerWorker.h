@@ -0,0 +1,107 @@
+#ifndef CONTROLLERQUEUE_CONTROLLERWORKER_H
+#define CONTROLLERQUEUE_CONTROLLERWORKER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+# include "../ControllerQueue/ControllerDelayHandlerStruct.h"
+# include "../DataStructs/SPSC_Queue.h"
+
+# ifndef CONTROLLER_WORKER_CORE
+#  define CONTROLLER_WORKER_CORE        0 // Arduino loop() runs on core 1 (when present)
+# endif // ifndef CONTROLLER_WORKER_CORE
+# ifndef CONTROLLER_WORKER_STACK_SIZE
+#  define CONTROLLER_WORKER_STACK_SIZE  8192
+# endif // ifndef CONTROLLER_WORKER_STACK_SIZE
+# ifndef CONTROLLER_WORKER_PRIORITY
+#  define CONTROLLER_WORKER_PRIORITY    1
+# endif // ifndef CONTROLLER_WORKER_PRIORITY
+# ifndef CONTROLLER_WORKER_QUEUE_SIZE
+#  define CONTROLLER_WORKER_QUEUE_SIZE  8 // Must be a power of 2, at least the number of controllers
+# endif // ifndef CONTROLLER_WORKER_QUEUE_SIZE
+
+
+/*********************************************************************************************\
+* ControllerWorker
+*
+* Runs the 'do_process_cXXX_delay_queue' functions of the controller delay queues in a separate task.
+* This way blocking network I/O of a controller (e.g. HTTP POST, TLS handshake)
+* will not stall the main loop.
+*
+* The main loop and the worker communicate via 2 lock-free single-producer/single-consumer queues:
+* - requests: main loop -> worker
+* - results:  worker -> main loop
+*
+* Each ControllerDelayHandlerStruct can only have a single job in flight.
+* The element being processed stays at the front of its queue until the result is handled in the main loop.
+*
+* The connection statistics in WiFiEventData are not thread safe,
+* so the connect result is returned in the job and applied in the main loop.
+*
+* A FreeRTOS task is used, pinned to CONTROLLER_WORKER_CORE.
+\*********************************************************************************************/
+
+struct ControllerWorkerJob {
+  ControllerDelayHandlerStruct *handler  = nullptr;
+  do_process_function           func     = nullptr;
+  const Queue_element_base     *element  = nullptr;
+  ControllerSettingsStruct     *settings = nullptr; // Owned by the job, deleted when result is handled
+  uint64_t                      duration_usec = 0;
+  cpluginID_t                   cpluginID     = INVALID_C_PLUGIN_ID;
+  TimingStatsElements           timerstats_id = TimingStatsElements::C001_DELAY_QUEUE;
+  SchedulerIntervalTimer_e      timerID       = SchedulerIntervalTimer_e::TIMER_C001_DELAY_QUEUE;
+  uint32_t                      suggestedTimeout   = 0;       // Connect timeout, set by the main loop
+  uint32_t                      connectDuration_ms = 0;
+  const __FlashStringHelper    *connectLabel       = nullptr; // Log prefix of the connection attempt
+  int8_t                        connectResult      = 0;       // 0: No connection attempt, 1: Connected, -1: Failed
+  bool                          success       = false;
+# if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  uint8_t                       partsSent     = 0; // Parts of the element sent before this job
+# endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+};
+
+
+bool ControllerWorker_start();
+
+void ControllerWorker_stop();
+
+bool ControllerWorker_active();
+
+// Return true when the delay queue of the controller may be processed by the worker task.
+// Only controllers doing a stateless network call are allowed,
+// as the other controllers share state with the main loop.
+bool ControllerWorker_allowed(cpluginID_t cpluginID);
+
+// Return true when called from the worker task.
+bool ControllerWorker_inWorkerTask();
+
+// Called from the main loop.
+// Return false when the job could not be queued. Caller then still owns the settings.
+bool ControllerWorker_submit(const ControllerWorkerJob& job);
+
+// Called from the main loop to handle finished jobs.
+// Return true when a result was handled.
+bool ControllerWorker_processResult();
+
+// Called from the main loop.
+// Block until no job is in flight for the given handler.
+void ControllerWorker_waitIdle(const ControllerDelayHandlerStruct *handler);
+
+// Called from the worker task.
+// Store the result of a connection attempt in the current job, to be applied in the main loop.
+void ControllerWorker_registerConnectResult(bool                       success,
+                                            const __FlashStringHelper *prefix,
+                                            uint32_t                   connectDuration_ms);
+
+// Called from the worker task.
+// Return the connect timeout suggested when the current job was submitted.
+uint32_t ControllerWorker_getSuggestedTimeout(uint32_t minimum_timeout);
+
+// Called from the worker task.
+// Log lines are handed over to the main loop, as log sinks are not thread safe.
+bool ControllerWorker_addLog(uint8_t logLevel, String&& line);
+
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+
+#endif // ifndef CONTROLLERQUEUE_CONTROLLERWORKER_H
@@ -129,6 +129,11 @@ void exit_mqtt_delay_queue();
 #endif // if FEATURE_MQTT
 
 
+// Return the delay queue handler used by the given controller, or nullptr when not used/allocated.
+// N.B. all MQTT controllers share the same MQTTDelayHandler
+ControllerDelayHandlerStruct* getControllerDelayHandler(controllerIndex_t ControllerIndex);
+
+
 /*********************************************************************************************\
 * C001_queue_element for queueing requests for C001.
 \*********************************************************************************************/
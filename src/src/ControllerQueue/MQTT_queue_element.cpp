@@ -60,12 +60,40 @@ bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
   return true;
 }
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+bool MQTT_queue_element::serialize(Queue_element_writer& writer) const {
+  serializeBase(writer);
+  writer.write(static_cast<uint8_t>(_retained ? 1 : 0));
+  writer.write(_topic);
+  writer.write(_payload);
+  return true;
+}
+
+bool MQTT_queue_element::deserialize(Queue_element_reader& reader) {
+  uint8_t retained{};
+
+  if (!deserializeBase(reader) ||
+      !reader.read(retained) ||
+      !reader.read(_topic) ||
+      !reader.read(_payload)) {
+    return false;
+  }
+  _retained = retained != 0;
+  return true;
+}
+
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 void MQTT_queue_element::removeEmptyTopics() {
+  removeEmptyTopics(_topic);
+}
+
+void MQTT_queue_element::removeEmptyTopics(String& topic) {
   // some parts of the topic may have been replaced by empty strings,
   // or "/status" may have been appended to a topic ending with a "/"
   // Get rid of "//"
-  while (_topic.indexOf(F("//")) != -1) {
-    _topic.replace(F("//"), F("/"));
+  while (topic.indexOf(F("//")) != -1) {
+    topic.replace(F("//"), F("/"));
   }
 }
 
@@ -49,6 +49,19 @@ public:
 
   void removeEmptyTopics();
 
+  // Also used for messages published without using the queue
+  static void removeEmptyTopics(String& topic);
+
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+  Queue_element_type_e getType() const {
+    return Queue_element_type_e::MQTT;
+  }
+
+  bool serialize(Queue_element_writer& writer) const;
+
+  bool deserialize(Queue_element_reader& reader);
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   String _topic{};
   String _payload{};
   UnitMessageCount_t UnitMessageCount{};
@@ -10,3 +10,33 @@ Queue_element_base::Queue_element_base() :
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+void Queue_element_base::serializeBase(Queue_element_writer& writer) const
+{
+  writer.write(static_cast<uint8_t>(_controller_idx));
+  writer.write(static_cast<uint8_t>(_taskIndex));
+  writer.write(static_cast<uint8_t>((_call_PLUGIN_PROCESS_CONTROLLER_DATA ? 1 : 0) |
+                                    (_processByController ? 2 : 0)));
+}
+
+bool Queue_element_base::deserializeBase(Queue_element_reader& reader)
+{
+  uint8_t controller_idx{};
+  uint8_t taskIndex{};
+  uint8_t flags{};
+
+  if (!reader.read(controller_idx) ||
+      !reader.read(taskIndex) ||
+      !reader.read(flags)) {
+    return false;
+  }
+  _controller_idx                      = controller_idx;
+  _taskIndex                           = taskIndex;
+  _call_PLUGIN_PROCESS_CONTROLLER_DATA = flags & 1;
+  _processByController                 = flags & 2;
+  _timestamp                           = millis();
+  return true;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -4,6 +4,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/Queue_element_serializer.h"
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
@@ -23,6 +24,36 @@ public:
   virtual const UnitMessageCount_t* getUnitMessageCount() const = 0;
   virtual UnitMessageCount_t      * getUnitMessageCount()       = 0;
 
+  // Nr of parts already delivered, for elements which are sent in multiple calls.
+  // A send call which delivered a part is not a failed transport, even when the element is not done yet.
+  virtual uint8_t                   getPartsSent() const {
+    return 0;
+  }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Element types which can be stored on flash must override these.
+  virtual Queue_element_type_e getType() const {
+    return Queue_element_type_e::NotSupported;
+  }
+
+  virtual bool serialize(Queue_element_writer& writer) const {
+    return false;
+  }
+
+  virtual bool deserialize(Queue_element_reader& reader) {
+    return false;
+  }
+
+protected:
+
+  // Members of the base class, except the timestamp as it is not valid after a reboot.
+  void serializeBase(Queue_element_writer& writer) const;
+  bool deserializeBase(Queue_element_reader& reader);
+
+public:
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   unsigned long _timestamp;
   controllerIndex_t _controller_idx;
   taskIndex_t _taskIndex;
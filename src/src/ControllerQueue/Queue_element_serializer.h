@@ -0,0 +1,115 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SERIALIZER_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_SERIALIZER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include <vector>
+
+/*********************************************************************************************\
+* Queue_element_type_e
+* Type of a controller queue element, used to restore elements stored on flash.
+* N.B. Stored on flash, so do not change the values.
+\*********************************************************************************************/
+enum class Queue_element_type_e : uint8_t {
+  NotSupported     = 0,
+  MQTT             = 1,
+  StringOnly       = 2,
+  FormattedStrings = 3
+};
+
+/*********************************************************************************************\
+* Queue_element_writer
+* Serialize the members of a controller queue element into a byte buffer.
+\*********************************************************************************************/
+class Queue_element_writer {
+public:
+
+  explicit Queue_element_writer(std::vector<uint8_t>& buffer) : _buffer(buffer) {}
+
+  void write(uint8_t value) {
+    _buffer.push_back(value);
+  }
+
+  void write(uint16_t value) {
+    _buffer.push_back(value & 0xFF);
+    _buffer.push_back(value >> 8);
+  }
+
+  void write(int32_t value) {
+    const uint32_t v = static_cast<uint32_t>(value);
+
+    write(static_cast<uint16_t>(v & 0xFFFF));
+    write(static_cast<uint16_t>(v >> 16));
+  }
+
+  // Strings are stored with a 16-bit length prefix
+  void write(const String& str) {
+    const uint16_t length = str.length();
+
+    write(length);
+    _buffer.insert(_buffer.end(), str.c_str(), str.c_str() + length);
+  }
+
+private:
+
+  std::vector<uint8_t>& _buffer;
+};
+
+/*********************************************************************************************\
+* Queue_element_reader
+* Read back the members written by Queue_element_writer.
+* All read functions return false when reading beyond the end of the data.
+\*********************************************************************************************/
+class Queue_element_reader {
+public:
+
+  Queue_element_reader(const uint8_t *data, size_t size) : _pos(data), _end(data + size) {}
+
+  bool read(uint8_t& value) {
+    if (_pos >= _end) { return false; }
+    value = *_pos++;
+    return true;
+  }
+
+  bool read(uint16_t& value) {
+    if ((_end - _pos) < 2) { return false; }
+    value = _pos[0] | (_pos[1] << 8);
+    _pos += 2;
+    return true;
+  }
+
+  bool read(int32_t& value) {
+    uint16_t low, high;
+
+    if (!read(low) || !read(high)) { return false; }
+    value = static_cast<int32_t>((static_cast<uint32_t>(high) << 16) | low);
+    return true;
+  }
+
+  bool read(String& str) {
+    uint16_t length = 0;
+
+    if (!read(length) || ((_end - _pos) < length)) { return false; }
+    str.clear();
+
+    if (!str.reserve(length)) { return false; }
+    str.concat(reinterpret_cast<const char *>(_pos), length);
+    _pos += length;
+    return true;
+  }
+
+  bool atEnd() const {
+    return _pos >= _end;
+  }
+
+private:
+
+  const uint8_t *_pos;
+  const uint8_t *_end;
+};
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SERIALIZER_H
@@ -91,3 +91,44 @@ bool SimpleQueueElement_formatted_Strings::isDuplicate(const Queue_element_base&
   }
   return true;
 }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool SimpleQueueElement_formatted_Strings::serialize(Queue_element_writer& writer) const {
+  serializeBase(writer);
+  writer.write(static_cast<int32_t>(idx));
+  writer.write(static_cast<uint8_t>(sensorType));
+  writer.write(valuesSent);
+  writer.write(valueCount);
+
+  for (uint8_t i = 0; i < valueCount && i < VARS_PER_TASK; ++i) {
+    writer.write(txt[i]);
+  }
+  return true;
+}
+
+bool SimpleQueueElement_formatted_Strings::deserialize(Queue_element_reader& reader) {
+  int32_t tmp_idx{};
+  uint8_t tmp_sensorType{};
+  uint8_t tmp_valuesSent{};
+
+  if (!deserializeBase(reader) ||
+      !reader.read(tmp_idx) ||
+      !reader.read(tmp_sensorType) ||
+      !reader.read(tmp_valuesSent) ||
+      !reader.read(valueCount) ||
+      (valueCount > VARS_PER_TASK)) {
+    return false;
+  }
+  idx        = tmp_idx;
+  sensorType = static_cast<Sensor_VType>(tmp_sensorType);
+  valuesSent = tmp_valuesSent;
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    if (!reader.read(txt[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
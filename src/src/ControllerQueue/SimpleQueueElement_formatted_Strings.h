@@ -51,6 +51,20 @@ public:
     return nullptr;
   }
 
+  uint8_t getPartsSent() const {
+    return valuesSent;
+  }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  Queue_element_type_e getType() const {
+    return Queue_element_type_e::FormattedStrings;
+  }
+
+  bool serialize(Queue_element_writer& writer) const;
+
+  bool deserialize(Queue_element_reader& reader);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   String txt[VARS_PER_TASK]  = {};
   int idx                    = 0;
   Sensor_VType sensorType    = Sensor_VType::SENSOR_TYPE_NONE;
@@ -24,3 +24,16 @@ bool simple_queue_element_string_only::isDuplicate(const Queue_element_base& oth
   }
   return true;
 }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool simple_queue_element_string_only::serialize(Queue_element_writer& writer) const {
+  serializeBase(writer);
+  writer.write(txt);
+  return true;
+}
+
+bool simple_queue_element_string_only::deserialize(Queue_element_reader& reader) {
+  return deserializeBase(reader) && reader.read(txt);
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -35,6 +35,16 @@ public:
     return nullptr;
   }
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  Queue_element_type_e getType() const {
+    return Queue_element_type_e::StringOnly;
+  }
+
+  bool serialize(Queue_element_writer& writer) const;
+
+  bool deserialize(Queue_element_reader& reader);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   String txt;
 };
 
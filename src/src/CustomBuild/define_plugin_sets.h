@@ -3628,4 +3628,68 @@ To create/register a plugin, you have to :
     #endif
   #endif
 
+// Keep HTTP connections of controllers alive between requests
+#ifndef FEATURE_HTTP_CONNECTION_POOL
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_HTTP_CONNECTION_POOL 0
+  #else
+    #define FEATURE_HTTP_CONNECTION_POOL 1
+  #endif
+#endif
+#if FEATURE_HTTP_CONNECTION_POOL && !FEATURE_HTTP_CLIENT
+  #undef FEATURE_HTTP_CONNECTION_POOL
+  #define FEATURE_HTTP_CONNECTION_POOL 0
+#endif
+
+// Use fixed size pools for the nodes of frequently used queues, to reduce heap fragmentation
+#ifndef FEATURE_OBJECT_POOL
+  #define FEATURE_OBJECT_POOL 1
+#endif
+
+// Experimental: Process controller delay queues in a separate RTOS task (ESP32 only)
+#ifndef FEATURE_CONTROLLER_WORKER_TASK
+  #define FEATURE_CONTROLLER_WORKER_TASK 0
+#endif
+#if FEATURE_CONTROLLER_WORKER_TASK && !defined(ESP32)
+  #undef FEATURE_CONTROLLER_WORKER_TASK
+  #define FEATURE_CONTROLLER_WORKER_TASK 0
+#endif
+
+// Store controller queue messages on the file system when the queue is full
+#ifndef FEATURE_CONTROLLER_QUEUE_SPILL
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 0
+  #else
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 1
+  #endif
+#endif
+
+// Adapt the interval between controller messages to the round trip time and send failures
+#ifndef FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL 0
+  #else
+    #define FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL 1
+  #endif
+#endif
+
+// Publish MQTT messages directly from the MQTT client buffer when the queue is empty
+#ifndef FEATURE_MQTT_DIRECT_PUBLISH
+  #define FEATURE_MQTT_DIRECT_PUBLISH 1
+#endif
+
+// Store the samples of the Cache Controller compressed in blocks in the cache files
+#ifndef FEATURE_RTC_CACHE_COMPRESSION
+  #define FEATURE_RTC_CACHE_COMPRESSION 1
+#endif
+
+// Sample the ADC in continuous (DMA) mode for the Analog input plugin
+#ifndef FEATURE_ADC_CONTINUOUS
+  #if defined(ESP32) && ESP_IDF_VERSION_MAJOR >= 5 && defined(USES_P002) && !defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_ADC_CONTINUOUS 1
+  #else
+    #define FEATURE_ADC_CONTINUOUS 0
+  #endif
+#endif
+
 #endif // CUSTOMBUILD_DEFINE_PLUGIN_SETS_H
\ No newline at end of file
@@ -0,0 +1,430 @@
+#include "../DataStructs/C013_p2p_CompactSensorData.h"
+
+#ifdef USES_C013
+
+# include "../DataStructs/NodeStruct.h"
+# include "../Globals/Cache.h"
+# include "../Globals/Nodes.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/CRC_functions.h"
+
+# include "../CustomBuild/CompiletimeDefines.h"
+
+# include <map>
+
+static_assert(VARS_PER_TASK <= 4, "Compact sensor data message supports up to 4 values per task");
+
+# define C013_COMPACT_FLAG_KEYFRAME   0x01
+# define C013_COMPACT_FLAG_TIMESTAMP  0x02
+
+namespace {
+enum class C013_ValueEncoding : uint8_t {
+  Raw32    = 0, // 4 bytes, little endian
+  Varint   = 1, // Zigzag varint of the word, interpreted as int32_t
+  Float16  = 2, // IEEE 754 half precision float
+  FloatInt = 3  // Float with integer value, as zigzag varint
+};
+
+struct C013_CompactSenderState {
+  uint32_t words[VARS_PER_TASK]{};
+  uint8_t  sequence        = 0;
+  uint8_t  sinceKeyframe   = 0;
+  uint8_t  sensorType      = 0;
+  bool     keyframeSent    = false;
+};
+
+// Sender state per local task
+std::map<taskIndex_t, C013_CompactSenderState> C013_compactSenderStates;
+
+// Last received sequence nr per (sourceUnit << 8 | sourceTaskIndex)
+std::map<uint16_t, uint8_t> C013_compactReceivedSequence;
+
+uint16_t floatToHalf(float value)
+{
+  uint32_t bits{};
+
+  memcpy(&bits, &value, sizeof(bits));
+
+  const uint16_t sign     = (bits >> 16) & 0x8000;
+  const int32_t  exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+  uint32_t mantissa       = bits & 0x7FFFFF;
+
+  if (((bits >> 23) & 0xFF) == 0xFF) {
+    // Inf or NaN
+    return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+  }
+
+  if (exponent >= 31) {
+    return sign | 0x7C00; // Overflow to Inf
+  }
+
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign; // Too small, flush to zero
+    }
+
+    // Subnormal
+    mantissa |= 0x800000;
+    const uint8_t  shift = 14 - exponent;
+    uint32_t half_mant   = mantissa >> shift;
+
+    // Round to nearest
+    if ((mantissa >> (shift - 1)) & 1) { ++half_mant; }
+    return sign | half_mant;
+  }
+
+  uint16_t half = sign | (exponent << 10) | (mantissa >> 13);
+
+  // Round to nearest, a carry into the exponent is fine
+  if (mantissa & 0x1000) { ++half; }
+  return half;
+}
+
+float halfToFloat(uint16_t half)
+{
+  const uint32_t sign     = static_cast<uint32_t>(half & 0x8000) << 16;
+  int32_t  exponent       = (half >> 10) & 0x1F;
+  uint32_t mantissa       = half & 0x3FF;
+  uint32_t bits{};
+
+  if (exponent == 0x1F) {
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  } else if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // Normalize subnormal
+      exponent = 1;
+
+      while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        --exponent;
+      }
+      mantissa &= 0x3FF;
+      bits      = sign | (static_cast<uint32_t>(exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+  } else {
+    bits = sign | (static_cast<uint32_t>(exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+  float res{};
+
+  memcpy(&res, &bits, sizeof(res));
+  return res;
+}
+
+uint8_t writeVarint(uint32_t value, uint8_t *buffer)
+{
+  uint8_t len = 0;
+
+  while (value >= 0x80) {
+    buffer[len++] = (value & 0x7F) | 0x80;
+    value       >>= 7;
+  }
+  buffer[len++] = value;
+  return len;
+}
+
+// Returns the nr of bytes read, or 0 on error
+uint8_t readVarint(const uint8_t *buffer, const uint8_t *end, uint32_t& value)
+{
+  value = 0;
+
+  for (uint8_t i = 0; i < 5 && (buffer + i) < end; ++i) {
+    value |= static_cast<uint32_t>(buffer[i] & 0x7F) << (7 * i);
+
+    if ((buffer[i] & 0x80) == 0) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+uint8_t varintSize(uint32_t value)
+{
+  uint8_t len = 1;
+
+  while (value >= 0x80) {
+    value >>= 7;
+    ++len;
+  }
+  return len;
+}
+
+uint32_t zigzagEncode(int32_t value)
+{
+  return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t zigzagDecode(uint32_t value)
+{
+  return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+C013_ValueEncoding selectEncoding(uint32_t word, bool isFloat, uint8_t nrDecimals)
+{
+  if (isFloat) {
+    float value{};
+    memcpy(&value, &word, sizeof(value));
+
+    if ((fabsf(value) < 16777216.0f) &&
+        (value == static_cast<float>(static_cast<int32_t>(value))) &&
+        (word != 0x80000000)) { // Keep -0.0 as raw
+      if (varintSize(zigzagEncode(static_cast<int32_t>(value))) < 4) {
+        return C013_ValueEncoding::FloatInt;
+      }
+    }
+
+    if (nrDecimals <= 3) {
+      const float decoded = halfToFloat(floatToHalf(value));
+      float maxError      = 0.5f;
+
+      for (uint8_t i = 0; i < nrDecimals; ++i) {
+        maxError /= 10.0f;
+      }
+
+      if (fabsf(decoded - value) < maxError) {
+        return C013_ValueEncoding::Float16;
+      }
+    }
+    return C013_ValueEncoding::Raw32;
+  }
+
+  if (varintSize(zigzagEncode(static_cast<int32_t>(word))) < 4) {
+    return C013_ValueEncoding::Varint;
+  }
+  return C013_ValueEncoding::Raw32;
+}
+} // namespace
+
+bool C013_allNodesSupportCompactSensorData()
+{
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if ((it->first != Settings.Unit) && !it->second.p2p_compactSensorData) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t C013_encodeCompactSensorData(const C013_SensorDataStruct& data, uint8_t *buffer)
+{
+  C013_CompactSenderState& state = C013_compactSenderStates[data.sourceTaskIndex];
+
+  const uint8_t sensorType = static_cast<uint8_t>(data.sensorType);
+  const bool    keyframe   = !state.keyframeSent ||
+                             (state.sensorType != sensorType) ||
+                             ((state.sinceKeyframe + 1) >= C013_COMPACT_KEYFRAME_INTERVAL);
+
+  const bool isFloat = isFloatOutputDataType(data.sensorType);
+
+  uint8_t flags     = keyframe ? C013_COMPACT_FLAG_KEYFRAME : 0;
+  uint8_t encodings = 0;
+  size_t  pos       = C013_COMPACT_HEADER_SIZE;
+
+  if (data.timestamp_sec != 0) {
+    flags |= C013_COMPACT_FLAG_TIMESTAMP;
+    memcpy(&buffer[pos], &data.timestamp_sec, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    memcpy(&buffer[pos], &data.timestamp_frac, sizeof(uint16_t));
+    pos += sizeof(uint16_t);
+  }
+
+  for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+    uint32_t word{};
+    memcpy(&word, &data.taskValues_Data[x * sizeof(uint32_t)], sizeof(word));
+
+    if (!keyframe && (word == state.words[x])) {
+      continue;
+    }
+    state.words[x] = word;
+    flags         |= (1 << (4 + x));
+
+    const C013_ValueEncoding encoding = selectEncoding(
+      word,
+      isFloat,
+      Cache.getTaskDeviceValueDecimals(data.sourceTaskIndex, x));
+
+    encodings |= static_cast<uint8_t>(encoding) << (2 * x);
+
+    switch (encoding) {
+      case C013_ValueEncoding::Raw32:
+        memcpy(&buffer[pos], &word, sizeof(word));
+        pos += sizeof(word);
+        break;
+      case C013_ValueEncoding::Varint:
+        pos += writeVarint(zigzagEncode(static_cast<int32_t>(word)), &buffer[pos]);
+        break;
+      case C013_ValueEncoding::Float16:
+      {
+        float value{};
+        memcpy(&value, &word, sizeof(value));
+        const uint16_t half = floatToHalf(value);
+        memcpy(&buffer[pos], &half, sizeof(half));
+        pos += sizeof(half);
+        break;
+      }
+      case C013_ValueEncoding::FloatInt:
+      {
+        float value{};
+        memcpy(&value, &word, sizeof(value));
+        pos += writeVarint(zigzagEncode(static_cast<int32_t>(value)), &buffer[pos]);
+        break;
+      }
+    }
+  }
+
+  buffer[0]  = 255;
+  buffer[1]  = C013_COMPACT_SENSORDATA_ID;
+  buffer[2]  = data.sourceUnit;
+  buffer[3]  = data.destUnit;
+  buffer[4]  = data.sourceTaskIndex;
+  buffer[5]  = data.destTaskIndex;
+  buffer[6]  = C013_COMPACT_SENSORDATA_VERSION;
+  buffer[7]  = ++state.sequence;
+  buffer[8]  = data.deviceNumber.value;
+  buffer[9]  = sensorType;
+  buffer[10] = flags;
+  buffer[11] = encodings;
+
+  const uint16_t crc = calc_CRC16(reinterpret_cast<const char *>(buffer), pos);
+
+  memcpy(&buffer[pos], &crc, sizeof(crc));
+  pos += sizeof(crc);
+
+  state.sensorType    = sensorType;
+  state.keyframeSent  = true;
+  state.sinceKeyframe = keyframe ? 0 : state.sinceKeyframe + 1;
+  return pos;
+}
+
+bool C013_decodeCompactSensorData(const uint8_t *buffer, size_t size, C013_SensorDataStruct& data, uint8_t& valueMask)
+{
+  valueMask = 0;
+  memset(&data, 0, sizeof(C013_SensorDataStruct));
+
+  if ((size < (C013_COMPACT_HEADER_SIZE + 2)) ||
+      (buffer[0] != 255) ||
+      (buffer[1] != C013_COMPACT_SENSORDATA_ID) ||
+      (buffer[6] != C013_COMPACT_SENSORDATA_VERSION)) {
+    return false;
+  }
+
+  {
+    uint16_t crc{};
+    memcpy(&crc, &buffer[size - 2], sizeof(crc));
+
+    if (crc != static_cast<uint16_t>(calc_CRC16(reinterpret_cast<const char *>(buffer), size - 2))) {
+      return false;
+    }
+  }
+
+  data.header          = 255;
+  data.ID              = 5;
+  data.sourceUnit      = buffer[2];
+  data.destUnit        = buffer[3];
+  data.sourceTaskIndex = buffer[4];
+  data.destTaskIndex   = buffer[5];
+  data.deviceNumber    = pluginID_t::toPluginID(buffer[8]);
+  data.sensorType      = static_cast<Sensor_VType>(buffer[9]);
+
+  const uint8_t  sequence  = buffer[7];
+  const uint8_t  flags     = buffer[10];
+  const uint8_t  encodings = buffer[11];
+  const uint8_t *pos       = &buffer[C013_COMPACT_HEADER_SIZE];
+  const uint8_t *end       = &buffer[size - 2];
+
+  if (flags & C013_COMPACT_FLAG_TIMESTAMP) {
+    if ((end - pos) < 6) { return false; }
+    memcpy(&data.timestamp_sec, pos, sizeof(uint32_t));
+    memcpy(&data.timestamp_frac, pos + 4, sizeof(uint16_t));
+    pos += 6;
+  }
+
+  for (uint8_t x = 0; x < VARS_PER_TASK; ++x) {
+    if ((flags & (1 << (4 + x))) == 0) {
+      continue;
+    }
+    uint32_t word{};
+
+    switch (static_cast<C013_ValueEncoding>((encodings >> (2 * x)) & 0x03)) {
+      case C013_ValueEncoding::Raw32:
+      {
+        if ((end - pos) < 4) { return false; }
+        memcpy(&word, pos, sizeof(word));
+        pos += sizeof(word);
+        break;
+      }
+      case C013_ValueEncoding::Varint:
+      {
+        uint32_t raw{};
+        const uint8_t len = readVarint(pos, end, raw);
+
+        if (len == 0) { return false; }
+        word = static_cast<uint32_t>(zigzagDecode(raw));
+        pos += len;
+        break;
+      }
+      case C013_ValueEncoding::Float16:
+      {
+        if ((end - pos) < 2) { return false; }
+        uint16_t half{};
+        memcpy(&half, pos, sizeof(half));
+        const float value = halfToFloat(half);
+        memcpy(&word, &value, sizeof(word));
+        pos += sizeof(half);
+        break;
+      }
+      case C013_ValueEncoding::FloatInt:
+      {
+        uint32_t raw{};
+        const uint8_t len = readVarint(pos, end, raw);
+
+        if (len == 0) { return false; }
+        const float value = static_cast<float>(zigzagDecode(raw));
+        memcpy(&word, &value, sizeof(word));
+        pos += len;
+        break;
+      }
+    }
+    memcpy(&data.taskValues_Data[x * sizeof(uint32_t)], &word, sizeof(word));
+    valueMask |= (1 << x);
+  }
+
+  if (pos != end) { return false; }
+
+  // Sequence nr is used to detect lost messages.
+  // After a lost message, values not present are only up-to-date again after the next keyframe.
+  const uint16_t key = (static_cast<uint16_t>(data.sourceUnit) << 8) | data.sourceTaskIndex;
+  auto it            = C013_compactReceivedSequence.find(key);
+
+  if (it != C013_compactReceivedSequence.end()) {
+    const uint8_t lost = sequence - it->second - 1;
+
+    if ((lost != 0) && loglevelActiveFor(LOG_LEVEL_INFO)) {
+      addLogMove(LOG_LEVEL_INFO, strformat(
+                   F("P2P data : Lost %d messages from unit %d task %d%s"),
+                   lost,
+                   data.sourceUnit,
+                   data.sourceTaskIndex + 1,
+                   (flags & C013_COMPACT_FLAG_KEYFRAME) ? "" : " (waiting for keyframe)"));
+    }
+    it->second = sequence;
+  } else {
+    C013_compactReceivedSequence[key] = sequence;
+  }
+
+  // Nodes sending this message always include the plugin ID and sensor type
+  const NodeStruct *sourceNode = Nodes.getNode(data.sourceUnit);
+
+  data.sourceNodeBuild = (sourceNode != nullptr) ? sourceNode->build : get_build_nr();
+
+  return validTaskIndex(data.sourceTaskIndex) &&
+         validTaskIndex(data.destTaskIndex);
+}
+
+void C013_resetCompactSensorData(taskIndex_t taskIndex)
+{
+  C013_compactSenderStates.erase(taskIndex);
+}
+
+#endif // ifdef USES_C013
@@ -0,0 +1,63 @@
+#ifndef DATASTRUCTS_C013_P2P_COMPACTSENSORDATA_H
+#define DATASTRUCTS_C013_P2P_COMPACTSENSORDATA_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USES_C013
+
+# include "../DataStructs/C013_p2p_SensorDataStruct.h"
+
+// Compact sensor data message, sent instead of C013_SensorDataStruct (ID 5)
+// when all known nodes announce support for it via NodeStruct::p2p_compactSensorData.
+//
+// Layout (version 1):
+//  0  header (255)
+//  1  ID (7)
+//  2  sourceUnit
+//  3  destUnit
+//  4  sourceTaskIndex
+//  5  destTaskIndex
+//  6  version
+//  7  sequence nr, incremented per sent message per task
+//  8  deviceNumber (plugin ID)
+//  9  sensorType
+// 10  flags: bit 0: keyframe (all values present), bit 1: timestamp present, bit 4..7: value present mask
+// 11  value encoding, 2 bits per value
+// [6 bytes timestamp: uint32_t sec, uint16_t frac]
+// values present, encoded per 32-bit word of TaskValues_Data_t
+// 2 bytes CRC16
+//
+// Only values changed since the previous message for the task are included,
+// with a keyframe containing all values sent every C013_COMPACT_KEYFRAME_INTERVAL messages.
+
+# define C013_COMPACT_SENSORDATA_ID       7
+# define C013_COMPACT_SENSORDATA_VERSION  1
+# define C013_COMPACT_HEADER_SIZE         12
+# define C013_COMPACT_MAX_SIZE            (C013_COMPACT_HEADER_SIZE + 6 + VARS_PER_TASK * 5 + 2)
+
+# ifndef C013_COMPACT_KEYFRAME_INTERVAL
+#  define C013_COMPACT_KEYFRAME_INTERVAL  8
+# endif // ifndef C013_COMPACT_KEYFRAME_INTERVAL
+
+
+// Check whether all known nodes accept the compact sensor data message.
+bool   C013_allNodesSupportCompactSensorData();
+
+// Encode the data in the compact format.
+// Returns the number of bytes written to buffer, which must be at least C013_COMPACT_MAX_SIZE bytes.
+size_t C013_encodeCompactSensorData(const C013_SensorDataStruct& data,
+                                    uint8_t                     *buffer);
+
+// Decode a received compact message into data.
+// Only the values set in valueMask are present in data.taskValues_Data.
+bool   C013_decodeCompactSensorData(const uint8_t         *buffer,
+                                    size_t                 size,
+                                    C013_SensorDataStruct& data,
+                                    uint8_t              & valueMask);
+
+// Force a keyframe on the next message sent for this task.
+void   C013_resetCompactSensorData(taskIndex_t taskIndex);
+
+#endif // ifdef USES_C013
+
+#endif // ifndef DATASTRUCTS_C013_P2P_COMPACTSENSORDATA_H
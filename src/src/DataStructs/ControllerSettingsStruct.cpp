@@ -30,6 +30,7 @@ void ControllerSettingsStruct::reset() {
   UseDNS                                        = DEFAULT_SERVER_USEDNS;
   Port                                          = DEFAULT_PORT;
   MinimalTimeBetweenMessages                    = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
+  MaxTimeBetweenMessages                        = CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT;
   MaxQueueDepth                                 = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT;
   MaxRetry                                      = CONTROLLER_DELAY_QUEUE_RETRY_DFLT;
   DeleteOldest                                  = DEFAULT_CONTROLLER_DELETE_OLDEST;
@@ -43,6 +44,9 @@ void ControllerSettingsStruct::reset() {
   VariousBits1.mqtt_retainFlag                  = 0;
   VariousBits1.useExtendedCredentials           = 0;
   VariousBits1.sendBinary                       = 0;
+  VariousBits1.mqtt_publishTaskJSON             = 0;
+  VariousBits1.spillToFlash                     = 0;
+  VariousBits1.adaptiveSendInterval             = 0;
   VariousBits1.allowExpire                      = 0;
   VariousBits1.deduplicate                      = 0;
   VariousBits1.useLocalSystemTime               = 0;
@@ -29,6 +29,15 @@
 # define CONTROLLER_DELAY_QUEUE_DELAY_DFLT  100
 #endif // ifndef CONTROLLER_DELAY_QUEUE_DELAY_DFLT
 
+// Maximum delay between messages in msec, when the delay is adapted to the round trip time and send failures.
+// N.B. Stored as uint16_t
+#ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_MAX
+# define CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_MAX   65535
+#endif // ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT
+# define CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT  10000
+#endif // ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT
+
 // Queue length for controller messages not yet sent.
 #ifndef CONTROLLER_DELAY_QUEUE_DEPTH_MAX
 # define CONTROLLER_DELAY_QUEUE_DEPTH_MAX   50
@@ -78,17 +87,25 @@ struct ControllerSettingsStruct
     CONTROLLER_USER,
     CONTROLLER_PASS,
     CONTROLLER_MIN_SEND_INTERVAL,
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    CONTROLLER_ADAPTIVE_SEND_INTERVAL,
+    CONTROLLER_MAX_SEND_INTERVAL,
+#endif
     CONTROLLER_MAX_QUEUE_DEPTH,
     CONTROLLER_MAX_RETRIES,
     CONTROLLER_FULL_QUEUE_ACTION,
     CONTROLLER_ALLOW_EXPIRE,
     CONTROLLER_DEDUPLICATE,
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    CONTROLLER_SPILL_TO_FLASH,
+#endif
     CONTROLLER_USE_LOCAL_SYSTEM_TIME,
     CONTROLLER_CHECK_REPLY,
     CONTROLLER_CLIENT_ID,
 #if FEATURE_MQTT
     CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT,
     CONTROLLER_RETAINFLAG,
+    CONTROLLER_PUBLISH_TASK_JSON,
 #endif
     CONTROLLER_SUBSCRIBE,
     CONTROLLER_PUBLISH,
@@ -161,12 +178,24 @@ struct ControllerSettingsStruct
   bool         sendBinary() const { return VariousBits1.sendBinary; }
   void         sendBinary(bool value) { VariousBits1.sendBinary = value; }
 
+  // Publish all values of a task as a single JSON object, instead of a message per value.
+  bool         mqtt_publishTaskJSON() const { return VariousBits1.mqtt_publishTaskJSON; }
+  void         mqtt_publishTaskJSON(bool value) { VariousBits1.mqtt_publishTaskJSON = value; }
+
   bool         allowExpire() const { return VariousBits1.allowExpire; }
   void         allowExpire(bool value) { VariousBits1.allowExpire = value; }
 
   bool         deduplicate() const { return VariousBits1.deduplicate; }
   void         deduplicate(bool value) { VariousBits1.deduplicate = value; }
 
+  // Store queued messages on the file system when the queue in RAM is full.
+  bool         spillToFlash() const { return VariousBits1.spillToFlash; }
+  void         spillToFlash(bool value) { VariousBits1.spillToFlash = value; }
+
+  // Adapt the interval between messages, between MinimalTimeBetweenMessages and MaxTimeBetweenMessages.
+  bool         adaptiveSendInterval() const { return VariousBits1.adaptiveSendInterval; }
+  void         adaptiveSendInterval(bool value) { VariousBits1.adaptiveSendInterval = value; }
+
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
@@ -189,7 +218,7 @@ struct ControllerSettingsStruct
   char         MQTTLwtTopic[129];
   char         LWTMessageConnect[129];
   char         LWTMessageDisconnect[129];
-  uint8_t      UNUSED_2[2];
+  uint16_t     MaxTimeBetweenMessages; // Only used with adaptive send interval, 0 = default
   unsigned int MinimalTimeBetweenMessages;
   unsigned int MaxQueueDepth;
   unsigned int MaxRetry;
@@ -214,9 +243,9 @@ struct ControllerSettingsStruct
     uint32_t deduplicate                      : 1; // Bit 10
     uint32_t useLocalSystemTime               : 1; // Bit 11
     uint32_t TLStype                          : 4; // Bit 12...15: TLS type
-    uint32_t unused_16                        : 1; // Bit 16
-    uint32_t unused_17                        : 1; // Bit 17
-    uint32_t unused_18                        : 1; // Bit 18
+    uint32_t mqtt_publishTaskJSON             : 1; // Bit 16
+    uint32_t spillToFlash                     : 1; // Bit 17
+    uint32_t adaptiveSendInterval             : 1; // Bit 18
     uint32_t unused_19                        : 1; // Bit 19
     uint32_t unused_20                        : 1; // Bit 20
     uint32_t unused_21                        : 1; // Bit 21
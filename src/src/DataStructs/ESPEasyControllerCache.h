@@ -54,6 +54,14 @@ struct ControllerCache_struct {
   bool   peek(uint8_t     *data,
               unsigned int size) const;
 
+  // Position up to where the data has been processed, kept in RTC memory.
+  bool   getReadFilePos(int& fileNr,
+                        int& readPos);
+
+  // Mark data up to this position as processed, removing completely processed files.
+  bool   setReadFilePos(int fileNr,
+                        int readPos);
+
   String getNextCacheFileName(int& fileNr, bool& islast);
 
 private:
@@ -119,6 +119,20 @@ bool ControllerCache_struct::peek(uint8_t *data, unsigned int size) const {
   return _RTC_cache_handler->peek(data, size);
 }
 
+bool ControllerCache_struct::getReadFilePos(int& fileNr, int& readPos) {
+  if (_RTC_cache_handler == nullptr) {
+    return false;
+  }
+  return _RTC_cache_handler->getReadFilePos(fileNr, readPos);
+}
+
+bool ControllerCache_struct::setReadFilePos(int fileNr, int readPos) {
+  if (_RTC_cache_handler == nullptr) {
+    return false;
+  }
+  return _RTC_cache_handler->setReadFilePos(fileNr, readPos);
+}
+
 String ControllerCache_struct::getNextCacheFileName(int& fileNr, bool& islast) {
   if (_RTC_cache_handler == nullptr) {
     fileNr = -1;
@@ -69,6 +69,16 @@ enum class I2C_bus_state {
 
 const __FlashStringHelper * toString(I2C_bus_state state);
 
+// Statistics of I2C bus switching when calling tasks
+struct I2C_bus_stats_t {
+  uint32_t taskCalls{};           // Plugin calls for I2C tasks
+  uint32_t muxWrites{};           // Writes to the I2C multiplexer
+  uint32_t muxWritesSkipped{};    // Multiplexer writes skipped as the channels were already selected
+  uint32_t clockChanges{};        // I2C clock speed changes
+  uint32_t clockChangesSkipped{}; // Clock speed changes skipped as the clock speed was already set
+  uint64_t busTime_usec{};        // Time spent in plugin calls for I2C tasks
+};
+
 
 
 #endif // DATASTRUCTS_I2C_TYPES_H
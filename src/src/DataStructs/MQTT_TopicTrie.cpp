@@ -0,0 +1,233 @@
+#include "../DataStructs/MQTT_TopicTrie.h"
+
+#if FEATURE_MQTT
+
+# include <ctype.h>
+# include <string.h>
+
+namespace {
+// Strip surrounding white space, a leading '/' and a trailing '/'
+void trimTopic(const char *& start, const char *& end)
+{
+  while (start < end && isspace(*start)) { ++start; }
+
+  while (end > start && isspace(*(end - 1))) { --end; }
+
+  if ((start < end) && (*start == '/')) { ++start; }
+
+  if ((end > start) && (*(end - 1) == '/')) { --end; }
+}
+
+const char* findLevelEnd(const char *pos, const char *end)
+{
+  while (pos < end && *pos != '/') { ++pos; }
+  return pos;
+}
+} // namespace
+
+
+void MQTT_TopicTrie::add(const String& subscription, taskIndex_t taskIndex, uint8_t valueIndex)
+{
+  if (!validTaskIndex(taskIndex) || (valueIndex >= VARS_PER_TASK)) { return; }
+
+  const char *pos = subscription.c_str();
+  const char *end = pos + subscription.length();
+
+  trimTopic(pos, end);
+
+  if (pos >= end) { return; }
+
+  {
+    // '#' is only allowed as the last topic level
+    const char *hash = static_cast<const char *>(memchr(pos, '#', end - pos));
+
+    if ((hash != nullptr) &&
+        ((hash != (end - 1)) || ((hash != pos) && (*(hash - 1) != '/')))) {
+      return;
+    }
+  }
+
+  if (_nodes.empty()) {
+    _nodes.emplace_back(); // Root
+  }
+
+  uint16_t nodeIndex = 0;
+
+  while (pos <= end) {
+    const char *levelEnd = findLevelEnd(pos, end);
+    uint16_t    child    = findChild(nodeIndex, pos, levelEnd - pos);
+
+    if (child == 0) {
+      child = addChild(nodeIndex, pos, levelEnd - pos);
+
+      if (child == 0) { return; }
+    }
+    nodeIndex = child;
+    pos       = levelEnd + 1;
+  }
+
+  const uint16_t target = (static_cast<uint16_t>(taskIndex) << 4) | valueIndex;
+
+  for (const uint16_t existing : _nodes[nodeIndex].targets) {
+    if (existing == target) { return; }
+  }
+  _nodes[nodeIndex].targets.push_back(target);
+  ++_nrTargets;
+}
+
+void MQTT_TopicTrie::removeTask(taskIndex_t taskIndex)
+{
+  _nrTargets = 0;
+
+  for (auto& node : _nodes) {
+    for (auto it = node.targets.begin(); it != node.targets.end();) {
+      if ((*it >> 4) == taskIndex) {
+        it = node.targets.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    _nrTargets += node.targets.size();
+  }
+
+  if (_nrTargets == 0) {
+    // Drop the nodes of obsolete topics
+    clear();
+  }
+}
+
+void MQTT_TopicTrie::clear()
+{
+  _nodes.clear();
+  _nrTargets = 0;
+}
+
+bool MQTT_TopicTrie::hasMatch(const char *topic) const
+{
+  if (empty()) { return false; }
+  uint8_t valueMasks[TASKS_MAX] = {};
+
+  matchAll(topic, valueMasks);
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (valueMasks[taskIndex] != 0) { return true; }
+  }
+  return false;
+}
+
+uint8_t MQTT_TopicTrie::getMatchingValues(const char *topic, taskIndex_t taskIndex) const
+{
+  if (empty() || !validTaskIndex(taskIndex)) { return 0; }
+  uint8_t valueMasks[TASKS_MAX] = {};
+
+  matchAll(topic, valueMasks);
+  return valueMasks[taskIndex];
+}
+
+uint8_t MQTT_TopicTrie::forEachMatchingTask(const char *topic, const MatchCallback& callback) const
+{
+  if (empty()) { return 0; }
+  uint8_t valueMasks[TASKS_MAX] = {};
+
+  matchAll(topic, valueMasks);
+
+  uint8_t count = 0;
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (valueMasks[taskIndex] != 0) {
+      ++count;
+      callback(taskIndex, valueMasks[taskIndex]);
+    }
+  }
+  return count;
+}
+
+uint16_t MQTT_TopicTrie::findChild(uint16_t parent, const char *level, size_t length) const
+{
+  uint16_t child = _nodes[parent].firstChild;
+
+  while (child != 0) {
+    const Node& node = _nodes[child];
+
+    if ((node.level.length() == length) &&
+        (strncmp(node.level.c_str(), level, length) == 0)) {
+      return child;
+    }
+    child = node.nextSibling;
+  }
+  return 0;
+}
+
+uint16_t MQTT_TopicTrie::addChild(uint16_t parent, const char *level, size_t length)
+{
+  if (_nodes.size() >= UINT16_MAX) { return 0; }
+  const uint16_t child = _nodes.size();
+
+  _nodes.emplace_back();
+  Node& node = _nodes.back();
+
+  node.level.concat(level, length);
+  node.nextSibling           = _nodes[parent].firstChild;
+  _nodes[parent].firstChild = child;
+  return child;
+}
+
+void MQTT_TopicTrie::collectTargets(uint16_t nodeIndex, uint8_t *valueMasks) const
+{
+  for (const uint16_t target : _nodes[nodeIndex].targets) {
+    const taskIndex_t taskIndex = target >> 4;
+
+    if (taskIndex < TASKS_MAX) {
+      valueMasks[taskIndex] |= (1 << (target & 0x0F));
+    }
+  }
+}
+
+void MQTT_TopicTrie::match(uint16_t nodeIndex, const char *pos, const char *end, uint8_t *valueMasks) const
+{
+  const char  *levelEnd    = pos == nullptr ? nullptr : findLevelEnd(pos, end);
+  const size_t levelLength = pos == nullptr ? 0 : levelEnd - pos;
+
+  for (uint16_t child = _nodes[nodeIndex].firstChild; child != 0; child = _nodes[child].nextSibling) {
+    const Node& node = _nodes[child];
+
+    if (node.level.length() == 1) {
+      if (node.level[0] == '#') {
+        // Matches all remaining levels, including none
+        collectTargets(child, valueMasks);
+        continue;
+      }
+
+      if ((node.level[0] == '+') && (pos != nullptr)) {
+        match(child, levelEnd < end ? levelEnd + 1 : nullptr, end, valueMasks);
+        continue;
+      }
+    }
+
+    if ((pos != nullptr) &&
+        (node.level.length() == levelLength) &&
+        (strncmp(node.level.c_str(), pos, levelLength) == 0)) {
+      match(child, levelEnd < end ? levelEnd + 1 : nullptr, end, valueMasks);
+    }
+  }
+
+  if (pos == nullptr) {
+    collectTargets(nodeIndex, valueMasks);
+  }
+}
+
+void MQTT_TopicTrie::matchAll(const char *topic, uint8_t *valueMasks) const
+{
+  if ((topic == nullptr) || _nodes.empty()) { return; }
+
+  const char *pos = topic;
+  const char *end = pos + strlen(topic);
+
+  trimTopic(pos, end);
+
+  if (pos >= end) { return; }
+
+  match(0, pos, end, valueMasks);
+}
+
+#endif // if FEATURE_MQTT
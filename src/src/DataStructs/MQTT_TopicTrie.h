@@ -0,0 +1,94 @@
+#ifndef DATASTRUCTS_MQTT_TOPICTRIE_H
+#define DATASTRUCTS_MQTT_TOPICTRIE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <functional>
+# include <vector>
+
+
+/*********************************************************************************************\
+* MQTT_TopicTrie
+*
+* Subscription topics split per topic level, with each node holding the (task, value) targets
+* of the subscriptions ending at that node.
+* Wildcards '+' (single level) and '#' (multi level, including the parent level) are supported.
+* A leading '/' and surrounding white space are ignored, both in subscriptions and topics.
+*
+* Matching an incoming topic walks the levels in place, without allocating any String.
+\*********************************************************************************************/
+class MQTT_TopicTrie {
+public:
+
+  // Called once per matching task with a bitmask of the matching task values.
+  typedef std::function<void (taskIndex_t, uint8_t)> MatchCallback;
+
+  void    add(const String& subscription,
+              taskIndex_t   taskIndex,
+              uint8_t       valueIndex);
+
+  void    removeTask(taskIndex_t taskIndex);
+
+  void    clear();
+
+  bool    empty() const {
+    return _nrTargets == 0;
+  }
+
+  // Number of registered subscriptions
+  size_t  size() const {
+    return _nrTargets;
+  }
+
+  bool    hasMatch(const char *topic) const;
+
+  // Bitmask of the values of the given task matching the topic
+  uint8_t getMatchingValues(const char *topic,
+                            taskIndex_t taskIndex) const;
+
+  // Returns the number of matching tasks
+  uint8_t forEachMatchingTask(const char         *topic,
+                              const MatchCallback& callback) const;
+
+private:
+
+  struct Node {
+    String   level;
+    uint16_t firstChild  = 0; // 0 = none, as root can never be a child
+    uint16_t nextSibling = 0;
+
+    // (taskIndex << 4) | valueIndex
+    std::vector<uint16_t>targets;
+  };
+
+  uint16_t findChild(uint16_t    parent,
+                     const char *level,
+                     size_t      length) const;
+
+  uint16_t addChild(uint16_t    parent,
+                    const char *level,
+                    size_t      length);
+
+  void     collectTargets(uint16_t nodeIndex,
+                          uint8_t *valueMasks) const;
+
+  // pos == nullptr when all topic levels have been matched
+  void     match(uint16_t    nodeIndex,
+                 const char *pos,
+                 const char *end,
+                 uint8_t    *valueMasks) const;
+
+  void     matchAll(const char *topic,
+                    uint8_t    *valueMasks) const;
+
+  std::vector<Node>_nodes;
+  size_t _nrTargets = 0;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // ifndef DATASTRUCTS_MQTT_TOPICTRIE_H
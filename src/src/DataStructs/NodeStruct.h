@@ -109,11 +109,13 @@ struct __attribute__((__packed__)) NodeStruct
   // Whether the IPv6 address can be derived from the given sta_mac member
   uint8_t hasIPv6_mac_based_link_local  : 1;
   uint8_t hasIPv6_mac_based_link_global : 1;
-
-  uint8_t unused : 5;
   #else
-  uint8_t unused = 0;
+  uint8_t unused_IPv6                   : 3;
   #endif
+  // Node accepts the compact C013 sensor data messages (ID 7)
+  uint8_t p2p_compactSensorData         : 1;
+
+  uint8_t unused : 4;
   uint32_t unix_time_sec  = 0;
   uint32_t unix_time_frac = 0;
 };
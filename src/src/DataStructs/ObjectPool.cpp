@@ -0,0 +1,114 @@
+#include "../DataStructs/ObjectPool.h"
+
+#if FEATURE_OBJECT_POOL
+
+# include <cstddef>
+
+
+const __FlashStringHelper* toString(ObjectPool_e pool) {
+  switch (pool) {
+    case ObjectPool_e::ScheduledEvents: return F("Scheduled Events");
+    case ObjectPool_e::ControllerQueue: return F("Controller Queue");
+    case ObjectPool_e::ExecuteCommand:  return F("Command Queue");
+    case ObjectPool_e::NR_ELEMENTS:     break;
+  }
+  return F("");
+}
+
+ObjectPool::ObjectPool(uint16_t nrBlocks) : _nrBlocks(nrBlocks) {}
+
+ObjectPool::~ObjectPool() {
+  if (_slab != nullptr) {
+    free(_slab);
+  }
+}
+
+bool ObjectPool::init(size_t size) {
+  if (_slab != nullptr) { return true; }
+
+  if (_blockSize != 0) {
+    // Allocation of the slab failed before, do not try again.
+    return false;
+  }
+
+  // Round up to keep all blocks aligned
+  constexpr size_t alignment = alignof(std::max_align_t);
+
+  if (size < sizeof(FreeBlock)) { size = sizeof(FreeBlock); }
+  size = (size + alignment - 1) & ~(alignment - 1);
+
+  if (size > 0xFFFF) { return false; }
+  _blockSize = static_cast<uint16_t>(size);
+
+  {
+    # ifdef USE_SECOND_HEAP
+
+    // Slab must be in DRAM, std::list cannot handle 2nd heap well
+    HeapSelectDram ephemeral;
+    # endif // ifdef USE_SECOND_HEAP
+    _slab = static_cast<uint8_t *>(malloc(getMemorySize()));
+  }
+
+  if (_slab == nullptr) {
+    _nrBlocks = 0;
+    return false;
+  }
+
+  // Build the free list, first block at the head.
+  for (int i = _nrBlocks - 1; i >= 0; --i) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(_slab + i * _blockSize);
+    block->next = _freeList;
+    _freeList   = block;
+  }
+  return true;
+}
+
+void * ObjectPool::allocate(size_t size) {
+  if (!init(size) || (size > _blockSize) || (_freeList == nullptr)) {
+    ++_failedCount;
+    return nullptr;
+  }
+  FreeBlock *block = _freeList;
+
+  _freeList = block->next;
+  ++_inUse;
+
+  if (_inUse > _highWaterMark) {
+    _highWaterMark = _inUse;
+  }
+  return block;
+}
+
+bool ObjectPool::deallocate(void *ptr) {
+  if ((ptr == nullptr) || (_slab == nullptr)) { return false; }
+  uint8_t *p = static_cast<uint8_t *>(ptr);
+
+  if ((p < _slab) || (p >= (_slab + getMemorySize()))) {
+    return false;
+  }
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+
+  block->next = _freeList;
+  _freeList   = block;
+
+  if (_inUse > 0) { --_inUse; }
+  return true;
+}
+
+ObjectPool& getObjectPool(ObjectPool_e pool) {
+  // Function local statics, so the pools can also be used by global containers during static initialization.
+  static ObjectPool scheduledEvents(OBJECTPOOL_SCHEDULED_EVENTS_SIZE);
+  static ObjectPool controllerQueue(OBJECTPOOL_CONTROLLER_QUEUE_SIZE);
+  static ObjectPool executeCommand(OBJECTPOOL_EXECUTE_COMMAND_SIZE);
+
+  switch (pool) {
+    case ObjectPool_e::ScheduledEvents: return scheduledEvents;
+    case ObjectPool_e::ControllerQueue: return controllerQueue;
+    case ObjectPool_e::ExecuteCommand:
+    case ObjectPool_e::NR_ELEMENTS:
+      break;
+  }
+  return executeCommand;
+}
+
+#endif // if FEATURE_OBJECT_POOL
@@ -0,0 +1,171 @@
+#ifndef DATASTRUCTS_OBJECTPOOL_H
+#define DATASTRUCTS_OBJECTPOOL_H
+
+#include "../../ESPEasy_common.h"
+
+#include <list>
+#include <memory>
+#include <new>
+
+
+#ifndef OBJECTPOOL_SCHEDULED_EVENTS_SIZE
+# ifdef ESP8266
+#  define OBJECTPOOL_SCHEDULED_EVENTS_SIZE 8
+# else // ifdef ESP8266
+#  define OBJECTPOOL_SCHEDULED_EVENTS_SIZE 16
+# endif // ifdef ESP8266
+#endif // ifndef OBJECTPOOL_SCHEDULED_EVENTS_SIZE
+
+#ifndef OBJECTPOOL_CONTROLLER_QUEUE_SIZE
+# ifdef ESP8266
+#  define OBJECTPOOL_CONTROLLER_QUEUE_SIZE 32
+# else // ifdef ESP8266
+#  define OBJECTPOOL_CONTROLLER_QUEUE_SIZE 64
+# endif // ifdef ESP8266
+#endif // ifndef OBJECTPOOL_CONTROLLER_QUEUE_SIZE
+
+#ifndef OBJECTPOOL_EXECUTE_COMMAND_SIZE
+# define OBJECTPOOL_EXECUTE_COMMAND_SIZE 8
+#endif // ifndef OBJECTPOOL_EXECUTE_COMMAND_SIZE
+
+
+/*********************************************************************************************\
+* ObjectPool
+*
+* Fixed size slab of equally sized blocks, to be used for frequently allocated
+* and freed objects, like the nodes of the event and controller queues.
+* The slab is allocated once, on first use, so these allocations no longer fragment the heap.
+*
+* The block size is set by the size of the first allocation.
+* When the pool is exhausted, or an allocation does not fit in a block,
+* the regular heap is used and this is counted as a failure.
+\*********************************************************************************************/
+enum class ObjectPool_e : uint8_t {
+  ScheduledEvents,
+  ControllerQueue,
+  ExecuteCommand,
+
+  NR_ELEMENTS // Keep as last
+};
+
+const __FlashStringHelper* toString(ObjectPool_e pool);
+
+class ObjectPool {
+public:
+
+  explicit ObjectPool(uint16_t nrBlocks);
+
+  ~ObjectPool();
+
+  ObjectPool(const ObjectPool& other)            = delete;
+  ObjectPool& operator=(const ObjectPool& other) = delete;
+
+  // Return nullptr when no free block of sufficient size is available.
+  void* allocate(size_t size);
+
+  // Return false when the pointer was not allocated from this pool.
+  bool  deallocate(void *ptr);
+
+  uint16_t getBlockSize() const {
+    return _blockSize;
+  }
+
+  uint16_t getNrBlocks() const {
+    return _nrBlocks;
+  }
+
+  uint16_t getInUse() const {
+    return _inUse;
+  }
+
+  uint16_t getHighWaterMark() const {
+    return _highWaterMark;
+  }
+
+  // Number of allocations which had to use the regular heap.
+  uint32_t getFailedCount() const {
+    return _failedCount;
+  }
+
+  size_t getMemorySize() const {
+    return static_cast<size_t>(_blockSize) * _nrBlocks;
+  }
+
+private:
+
+  bool init(size_t size);
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  uint8_t   *_slab          = nullptr;
+  FreeBlock *_freeList      = nullptr;
+  uint16_t   _blockSize     = 0;
+  uint16_t   _nrBlocks      = 0;
+  uint16_t   _inUse         = 0;
+  uint16_t   _highWaterMark = 0;
+  uint32_t   _failedCount   = 0;
+};
+
+ObjectPool& getObjectPool(ObjectPool_e pool);
+
+
+/*********************************************************************************************\
+* ObjectPoolAllocator
+*
+* Allocator for node based containers like std::list.
+* Single object allocations are taken from the given pool, falling back to the heap.
+* Allocations of arrays (e.g. the map and chunks of a std::deque) always use the heap.
+\*********************************************************************************************/
+template<typename T, ObjectPool_e POOL>
+struct ObjectPoolAllocator {
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind {
+    typedef ObjectPoolAllocator<U, POOL>other;
+  };
+
+  ObjectPoolAllocator() noexcept {}
+
+  template<typename U>
+  ObjectPoolAllocator(const ObjectPoolAllocator<U, POOL>&) noexcept {}
+
+  T* allocate(size_t n) {
+    if (n == 1) {
+      void *ptr = getObjectPool(POOL).allocate(sizeof(T));
+
+      if (ptr != nullptr) {
+        return static_cast<T *>(ptr);
+      }
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, size_t n) {
+    if ((n != 1) || !getObjectPool(POOL).deallocate(ptr)) {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+template<typename T, typename U, ObjectPool_e POOL>
+bool operator==(const ObjectPoolAllocator<T, POOL>&, const ObjectPoolAllocator<U, POOL>&) {
+  return true;
+}
+
+template<typename T, typename U, ObjectPool_e POOL>
+bool operator!=(const ObjectPoolAllocator<T, POOL>&, const ObjectPoolAllocator<U, POOL>&) {
+  return false;
+}
+
+#if FEATURE_OBJECT_POOL
+template<typename T, ObjectPool_e POOL>
+using PooledList = std::list<T, ObjectPoolAllocator<T, POOL> >;
+#else // if FEATURE_OBJECT_POOL
+template<typename T, ObjectPool_e POOL>
+using PooledList = std::list<T>;
+#endif // if FEATURE_OBJECT_POOL
+
+#endif // ifndef DATASTRUCTS_OBJECTPOOL_H
@@ -0,0 +1,76 @@
+#include "../DataStructs/PluginTaskData_measurement.h"
+
+#include "../DataStructs/ESPEasy_EventStruct.h"
+
+#include "../Globals/ESPEasy_Scheduler.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
+
+
+PluginTaskData_measurement::PluginTaskData_measurement(taskIndex_t taskIndex,
+                                                       uint16_t    timeout_msec)
+  : _taskIndex(taskIndex), _timeout(timeout_msec) {}
+
+bool PluginTaskData_measurement::plugin_read(struct EventStruct *event)
+{
+  switch (_state) {
+    case State::NewValues:
+      _state = State::Idle;
+      return setTaskValues(event);
+    case State::Busy:
+
+      if (timePassedSince(_startTime) < _timeout) {
+        // Still waiting for the measurement to finish
+        return false;
+      }
+
+      // Measurement got stuck, start a new one.
+      break;
+    case State::Idle:
+    case State::Error:
+      break;
+  }
+
+  _startTime = millis();
+  _step      = 0;
+  _state     = State::Busy;
+  runSteps();
+
+  if (_state == State::NewValues) {
+    // All steps were done without waiting.
+    _state = State::Idle;
+    return setTaskValues(event);
+  }
+  return false;
+}
+
+bool PluginTaskData_measurement::plugin_tasktimer_in(struct EventStruct *event)
+{
+  if ((event->Par1 != PLUGIN_MEASUREMENT_TASKTIMER_PAR1) || (_state != State::Busy)) {
+    return false;
+  }
+  runSteps();
+
+  if (_state == State::NewValues) {
+    // Schedule a PLUGIN_READ to set the new values.
+    Scheduler.schedule_task_device_timer(_taskIndex, millis());
+  }
+  return true;
+}
+
+void PluginTaskData_measurement::runSteps()
+{
+  while (_state == State::Busy) {
+    const int32_t res = measurementStep(_step);
+    ++_step;
+
+    if (res == MEASUREMENT_DONE) {
+      _state = State::NewValues;
+    } else if (res < 0) {
+      _state = State::Error;
+    } else if (res > 0) {
+      Scheduler.setPluginTaskTimer(res, _taskIndex, PLUGIN_MEASUREMENT_TASKTIMER_PAR1);
+      return;
+    }
+  }
+}
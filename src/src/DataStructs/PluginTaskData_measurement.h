@@ -0,0 +1,84 @@
+#ifndef DATASTRUCTS_PLUGINTASKDATA_MEASUREMENT_H
+#define DATASTRUCTS_PLUGINTASKDATA_MEASUREMENT_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/PluginTaskData_base.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+// Par1 of the PLUGIN_TASKTIMER_IN calls used to run the measurement steps.
+// Must fit in the part of the plugin task timer ID used for Par1.
+#define PLUGIN_MEASUREMENT_TASKTIMER_PAR1  0x3FF
+
+/*********************************************************************************************\
+* PluginTaskData_measurement
+*
+* Base class for task data of sensors which need some time between starting a conversion
+* and reading the result.
+* Instead of blocking PLUGIN_READ with delay() calls, the measurement is split in steps.
+* Each step returns the time to wait before the next step is run.
+* The waiting is done using a plugin task timer (PLUGIN_TASKTIMER_IN), so other tasks
+* can run in the meantime.
+*
+* - PLUGIN_READ starts a new measurement when no new values are present and returns false.
+* - When the last step is done, a new PLUGIN_READ is scheduled right away,
+*   which sets the task values via setTaskValues().
+*
+* The plugin must forward PLUGIN_READ to plugin_read() and PLUGIN_TASKTIMER_IN to
+* plugin_tasktimer_in().
+\*********************************************************************************************/
+struct PluginTaskData_measurement : public PluginTaskData_base {
+  // Return values of measurementStep() other than the number of msec to wait.
+  static constexpr int32_t MEASUREMENT_DONE  = -1;
+  static constexpr int32_t MEASUREMENT_ERROR = -2;
+
+  explicit PluginTaskData_measurement(taskIndex_t taskIndex,
+                                      uint16_t    timeout_msec = 1000);
+
+  virtual ~PluginTaskData_measurement() = default;
+
+  // Returns true when task values were set from a finished measurement.
+  bool plugin_read(struct EventStruct *event);
+
+  // Returns true when the timer was used to run the next measurement step.
+  bool plugin_tasktimer_in(struct EventStruct *event);
+
+  bool measurementBusy() const {
+    return _state == State::Busy;
+  }
+
+  bool measurementFailed() const {
+    return _state == State::Error;
+  }
+
+protected:
+
+  // Perform measurement step 'step', starting at 0 for a new measurement.
+  // Return the number of msec to wait before the next step, 0 to continue right away,
+  // MEASUREMENT_DONE when the values can be set or MEASUREMENT_ERROR to abort.
+  virtual int32_t measurementStep(uint8_t step) = 0;
+
+  // Set the task values from the last finished measurement.
+  // Return false when no valid values are present.
+  virtual bool    setTaskValues(struct EventStruct *event) = 0;
+
+private:
+
+  void runSteps();
+
+  enum class State : uint8_t {
+    Idle,
+    Busy,
+    NewValues,
+    Error
+  };
+
+  unsigned long _startTime = 0;
+  taskIndex_t   _taskIndex;
+  uint16_t      _timeout;
+  uint8_t       _step  = 0;
+  State         _state = State::Idle;
+};
+
+#endif // ifndef DATASTRUCTS_PLUGINTASKDATA_MEASUREMENT_H
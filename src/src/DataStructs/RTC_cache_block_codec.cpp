@@ -0,0 +1,626 @@
+#include "../DataStructs/RTC_cache_block_codec.h"
+
+#if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
+
+# include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/RTCStruct.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/StringConverter.h"
+
+# include <stddef.h>
+
+# define RTC_CACHE_BLOCK_VERSION         1
+# define RTC_CACHE_FILE_HEADER_SIZE      8
+# define RTC_CACHE_BLOCK_HEADER_SIZE     8
+
+// Block types
+# define RTC_CACHE_BLOCK_STORED          1
+# define RTC_CACHE_BLOCK_COMPRESSED      2
+
+// Nr of different tasks in a compressed block, series index is stored in 5 bits
+# define RTC_CACHE_BLOCK_MAX_SERIES      32
+
+// Layout of C016_binary_element in 32-bit words
+# define RTC_CACHE_SAMPLE_SIZE           sizeof(C016_binary_element)
+# define RTC_CACHE_SAMPLE_VALUE_WORDS    (sizeof(TaskValues_Data_t) / 4)
+# define RTC_CACHE_SAMPLE_TIME_WORD      (offsetof(C016_binary_element, unixTime) / 4)
+# define RTC_CACHE_SAMPLE_KEY_WORD       (offsetof(C016_binary_element, TaskIndex) / 4)
+# define RTC_CACHE_SAMPLE_WORDS          (RTC_CACHE_SAMPLE_SIZE / 4)
+
+static_assert(RTC_CACHE_SAMPLE_SIZE % 4 == 0,                       "Sample must consist of 32-bit words");
+static_assert(RTC_CACHE_SAMPLE_TIME_WORD == RTC_CACHE_SAMPLE_VALUE_WORDS, "unixTime must follow the task values");
+static_assert(RTC_CACHE_SAMPLE_KEY_WORD == (RTC_CACHE_SAMPLE_TIME_WORD + 1), "Task info must follow unixTime");
+static_assert(RTC_CACHE_SAMPLE_WORDS == (RTC_CACHE_SAMPLE_KEY_WORD + 1), "Task info must fit in a single word");
+static_assert(RTC_CACHE_DATA_SIZE <= 0xFFFF, "Decoded block size is stored as uint16_t");
+
+
+namespace {
+
+// Bits are written MSB first
+class RTC_cache_bit_writer {
+public:
+
+  explicit RTC_cache_bit_writer(std::vector<uint8_t>& buffer) : _buffer(buffer) {}
+
+  void write(uint32_t value, uint8_t nrBits) {
+    while (nrBits > 0) {
+      if (_freeBits == 0) {
+        _buffer.push_back(0);
+        _freeBits = 8;
+      }
+      const uint8_t n    = (nrBits < _freeBits) ? nrBits : _freeBits;
+      const uint8_t bits = (value >> (nrBits - n)) & ((1u << n) - 1);
+
+      _buffer.back() |= bits << (_freeBits - n);
+      _freeBits      -= n;
+      nrBits         -= n;
+    }
+  }
+
+private:
+
+  std::vector<uint8_t>& _buffer;
+  uint8_t               _freeBits = 0;
+};
+
+class RTC_cache_bit_reader {
+public:
+
+  RTC_cache_bit_reader(const uint8_t *data, size_t size) : _data(data), _nrBits(size * 8) {}
+
+  // Returns false when reading beyond the end of the data
+  bool read(uint32_t& value, uint8_t nrBits) {
+    value = 0;
+
+    while (nrBits > 0) {
+      if (_bitPos >= _nrBits) { return false; }
+      const uint8_t available = 8 - (_bitPos & 7);
+      const uint8_t n         = (nrBits < available) ? nrBits : available;
+      const uint8_t bits      = (_data[_bitPos >> 3] >> (available - n)) & ((1u << n) - 1);
+
+      value    = (value << n) | bits;
+      _bitPos += n;
+      nrBits  -= n;
+    }
+    return true;
+  }
+
+  bool readBit(bool& bit) {
+    uint32_t value = 0;
+
+    if (!read(value, 1)) { return false; }
+    bit = value != 0;
+    return true;
+  }
+
+private:
+
+  const uint8_t *_data;
+  size_t         _nrBits;
+  size_t         _bitPos = 0;
+};
+
+// State of the previous sample of a task, needed to encode/decode the next sample.
+struct RTC_cache_series {
+  uint32_t key       = 0;
+  uint32_t timestamp = 0;
+  uint32_t interval  = 0;
+  uint32_t values[RTC_CACHE_SAMPLE_VALUE_WORDS]{};
+
+  // Range of meaningful bits of the last stored XOR value, not set when windowLength is 0
+  uint8_t windowLeading[RTC_CACHE_SAMPLE_VALUE_WORDS]{};
+  uint8_t windowLength[RTC_CACHE_SAMPLE_VALUE_WORDS]{};
+};
+
+uint32_t getSampleWord(const uint8_t *sample, size_t word) {
+  uint32_t value;
+
+  memcpy(&value, sample + (word * 4), 4);
+  return value;
+}
+
+void setSampleWord(uint8_t *sample, size_t word, uint32_t value) {
+  memcpy(sample + (word * 4), &value, 4);
+}
+
+// Timestamp interval changes are stored like in Gorilla:
+// '0'                     : same interval as previous sample
+// '10'   +  7 bits signed : -64 ... 63
+// '110'  +  9 bits signed : -256 ... 255
+// '1110' + 12 bits signed : -2048 ... 2047
+// '1111' + 32 bits
+void encodeIntervalChange(RTC_cache_bit_writer& writer, int32_t change) {
+  if (change == 0) {
+    writer.write(0b0, 1);
+  } else if ((change >= -64) && (change <= 63)) {
+    writer.write(0b10, 2);
+    writer.write(static_cast<uint32_t>(change), 7);
+  } else if ((change >= -256) && (change <= 255)) {
+    writer.write(0b110, 3);
+    writer.write(static_cast<uint32_t>(change), 9);
+  } else if ((change >= -2048) && (change <= 2047)) {
+    writer.write(0b1110, 4);
+    writer.write(static_cast<uint32_t>(change), 12);
+  } else {
+    writer.write(0b1111, 4);
+    writer.write(static_cast<uint32_t>(change), 32);
+  }
+}
+
+bool decodeIntervalChange(RTC_cache_bit_reader& reader, uint32_t& change) {
+  constexpr uint8_t nrBits[] = { 7, 9, 12, 32 };
+  uint8_t nrOnes             = 0;
+  bool    bit                = true;
+
+  change = 0;
+
+  // The nr of leading '1' bits determines the size of the stored value
+  while (nrOnes < 4) {
+    if (!reader.readBit(bit)) { return false; }
+
+    if (!bit) { break; }
+    ++nrOnes;
+  }
+
+  if (nrOnes == 0) {
+    return true;
+  }
+  const uint8_t size = nrBits[nrOnes - 1];
+
+  if (!reader.read(change, size)) { return false; }
+
+  if ((size < 32) && (change & (1u << (size - 1)))) {
+    // Sign extend
+    change |= ~((1u << size) - 1);
+  }
+  return true;
+}
+
+// XOR with the previous value is stored like in Gorilla:
+// '0'                                     : same value
+// '10' + meaningful bits                  : meaningful bits fit in the previous window
+// '11' + 5 bits leading zeros + 5 bits (length - 1) + meaningful bits
+void encodeXOR(RTC_cache_bit_writer& writer, uint32_t xorValue, uint8_t& windowLeading, uint8_t& windowLength) {
+  if (xorValue == 0) {
+    writer.write(0b0, 1);
+    return;
+  }
+  const uint8_t leading  = __builtin_clz(xorValue);
+  const uint8_t trailing = __builtin_ctz(xorValue);
+
+  if ((windowLength != 0) &&
+      (leading >= windowLeading) &&
+      (trailing >= (32 - windowLeading - windowLength))) {
+    writer.write(0b10, 2);
+    writer.write(xorValue >> (32 - windowLeading - windowLength), windowLength);
+    return;
+  }
+  windowLeading = leading;
+  windowLength  = 32 - leading - trailing;
+  writer.write(0b11,             2);
+  writer.write(windowLeading,    5);
+  writer.write(windowLength - 1, 5);
+  writer.write(xorValue >> trailing, windowLength);
+}
+
+bool decodeXOR(RTC_cache_bit_reader& reader, uint32_t& xorValue, uint8_t& windowLeading, uint8_t& windowLength) {
+  bool bit = false;
+
+  xorValue = 0;
+
+  if (!reader.readBit(bit)) { return false; }
+
+  if (!bit) { return true; }
+
+  if (!reader.readBit(bit)) { return false; }
+
+  if (bit) {
+    uint32_t leading = 0;
+    uint32_t length  = 0;
+
+    if (!reader.read(leading, 5) || !reader.read(length, 5)) { return false; }
+    windowLeading = leading;
+    windowLength  = length + 1;
+
+    if ((windowLeading + windowLength) > 32) { return false; }
+  } else if (windowLength == 0) {
+    return false;
+  }
+
+  if (!reader.read(xorValue, windowLength)) { return false; }
+  xorValue <<= (32 - windowLeading - windowLength);
+  return true;
+}
+
+// Payload of a compressed block.
+// Per sample:
+// '0'                  : same task as previous sample
+// '10' + 5 bits index  : task seen before in this block
+// '11' + 32 bits       : new task, followed by the 32-bit timestamp
+// timestamp interval change (not for a new task)
+// XOR of each value word
+bool encodeSamples(const uint8_t *data, size_t size, std::vector<uint8_t>& out) {
+  std::vector<RTC_cache_series> series;
+  RTC_cache_bit_writer writer(out);
+  int previous = -1;
+
+  for (size_t offset = 0; offset < size; offset += RTC_CACHE_SAMPLE_SIZE) {
+    const uint8_t *sample = data + offset;
+    const uint32_t key    = getSampleWord(sample, RTC_CACHE_SAMPLE_KEY_WORD);
+    const uint32_t ts     = getSampleWord(sample, RTC_CACHE_SAMPLE_TIME_WORD);
+
+    int index = -1;
+
+    for (size_t i = 0; i < series.size() && index < 0; ++i) {
+      if (series[i].key == key) { index = i; }
+    }
+
+    if (index < 0) {
+      if (series.size() >= RTC_CACHE_BLOCK_MAX_SERIES) {
+        return false;
+      }
+      series.emplace_back();
+      index              = series.size() - 1;
+      series[index].key  = key;
+      series[index].timestamp = ts;
+      writer.write(0b11, 2);
+      writer.write(key,  32);
+      writer.write(ts,   32);
+    } else {
+      if (index == previous) {
+        writer.write(0b0, 1);
+      } else {
+        writer.write(0b10,  2);
+        writer.write(index, 5);
+      }
+      RTC_cache_series& state   = series[index];
+      const uint32_t    interval = ts - state.timestamp;
+
+      encodeIntervalChange(writer, static_cast<int32_t>(interval - state.interval));
+      state.interval  = interval;
+      state.timestamp = ts;
+    }
+    previous = index;
+
+    RTC_cache_series& state = series[index];
+
+    for (size_t i = 0; i < RTC_CACHE_SAMPLE_VALUE_WORDS; ++i) {
+      const uint32_t value = getSampleWord(sample, i);
+
+      encodeXOR(writer, value ^ state.values[i], state.windowLeading[i], state.windowLength[i]);
+      state.values[i] = value;
+    }
+  }
+  return true;
+}
+
+bool decodeSamples(const uint8_t *payload, size_t payloadSize, std::vector<uint8_t>& decoded) {
+  std::vector<RTC_cache_series> series;
+  RTC_cache_bit_reader reader(payload, payloadSize);
+  int previous = -1;
+
+  for (size_t offset = 0; offset < decoded.size(); offset += RTC_CACHE_SAMPLE_SIZE) {
+    uint8_t *sample = &decoded[offset];
+    bool     bit       = false;
+    bool     newSeries = false;
+    int      index     = previous;
+
+    if (!reader.readBit(bit)) { return false; }
+
+    if (bit) {
+      if (!reader.readBit(newSeries)) { return false; }
+
+      if (newSeries) {
+        if (series.size() >= RTC_CACHE_BLOCK_MAX_SERIES) { return false; }
+        series.emplace_back();
+        index = series.size() - 1;
+
+        if (!reader.read(series[index].key, 32) ||
+            !reader.read(series[index].timestamp, 32)) {
+          return false;
+        }
+      } else {
+        uint32_t value = 0;
+
+        if (!reader.read(value, 5)) { return false; }
+        index = value;
+      }
+    }
+
+    if ((index < 0) || (index >= static_cast<int>(series.size()))) { return false; }
+
+    RTC_cache_series& state = series[index];
+
+    if (!newSeries) {
+      uint32_t change = 0;
+
+      if (!decodeIntervalChange(reader, change)) { return false; }
+      state.interval  += change;
+      state.timestamp += state.interval;
+    }
+    previous = index;
+    setSampleWord(sample, RTC_CACHE_SAMPLE_KEY_WORD, state.key);
+    setSampleWord(sample, RTC_CACHE_SAMPLE_TIME_WORD, state.timestamp);
+
+    for (size_t i = 0; i < RTC_CACHE_SAMPLE_VALUE_WORDS; ++i) {
+      uint32_t xorValue = 0;
+
+      if (!decodeXOR(reader, xorValue, state.windowLeading[i], state.windowLength[i])) { return false; }
+      state.values[i] ^= xorValue;
+      setSampleWord(sample, i, state.values[i]);
+    }
+  }
+  return true;
+}
+
+bool isFileHeader(const uint8_t *header) {
+  return header[0] == 'E' &&
+         header[1] == 'C' &&
+         header[2] == 'B' &&
+         header[3] == RTC_CACHE_BLOCK_VERSION &&
+         header[4] == RTC_CACHE_SAMPLE_SIZE;
+}
+
+uint16_t getUint16(const uint8_t *data) {
+  return data[0] | (data[1] << 8);
+}
+
+bool readFileHeader(fs::File& file) {
+  uint8_t header[RTC_CACHE_FILE_HEADER_SIZE]{};
+
+  return (file.read(header, sizeof(header)) == sizeof(header)) && isFileHeader(header);
+}
+
+void setUint16(uint8_t *data, uint16_t value) {
+  data[0] = value & 0xFF;
+  data[1] = value >> 8;
+}
+
+} // namespace
+
+
+bool RTC_cache_block_useBlockFormat(const String& fname) {
+  fs::File file = tryOpenFile(fname, "r");
+
+  if (!file || (file.size() == 0)) {
+    return true;
+  }
+  const bool res = readFileHeader(file);
+
+  file.close();
+  return res;
+}
+
+String RTC_cache_block_getFileFormat(const String& fname) {
+  fs::File file = tryOpenFile(fname, "r");
+
+  if (!file) {
+    return EMPTY_STRING;
+  }
+  const bool blockFormat = readFileHeader(file);
+
+  file.close();
+
+  if (blockFormat) {
+    return concat(F("ECB"), RTC_CACHE_BLOCK_VERSION);
+  }
+  return F("raw");
+}
+
+void RTC_cache_block_appendFileHeader(std::vector<uint8_t>& out) {
+  const uint8_t header[RTC_CACHE_FILE_HEADER_SIZE] = {
+    'E', 'C', 'B', RTC_CACHE_BLOCK_VERSION, RTC_CACHE_SAMPLE_SIZE, 0, 0, 0 };
+
+  out.insert(out.end(), header, header + sizeof(header));
+}
+
+void RTC_cache_block_encode(const uint8_t *data, size_t size, std::vector<uint8_t>& out) {
+  const size_t headerPos = out.size();
+
+  out.resize(headerPos + RTC_CACHE_BLOCK_HEADER_SIZE, 0);
+  uint8_t type = RTC_CACHE_BLOCK_STORED;
+
+  if ((size > 0) && ((size % RTC_CACHE_SAMPLE_SIZE) == 0)) {
+    if (encodeSamples(data, size, out) &&
+        ((out.size() - headerPos - RTC_CACHE_BLOCK_HEADER_SIZE) < size)) {
+      type = RTC_CACHE_BLOCK_COMPRESSED;
+    } else {
+      out.resize(headerPos + RTC_CACHE_BLOCK_HEADER_SIZE);
+    }
+  }
+
+  if (type == RTC_CACHE_BLOCK_STORED) {
+    out.insert(out.end(), data, data + size);
+  }
+  const size_t payloadSize = out.size() - headerPos - RTC_CACHE_BLOCK_HEADER_SIZE;
+  uint8_t     *header      = &out[headerPos];
+
+  header[0] = type;
+  header[1] = 0;
+  setUint16(header + 2, size);
+  setUint16(header + 4, payloadSize);
+  setUint16(header + 6, calc_CRC16(reinterpret_cast<const char *>(header + RTC_CACHE_BLOCK_HEADER_SIZE), payloadSize));
+}
+
+/*********************************************************************************************\
+* RTC_cache_block_reader
+\*********************************************************************************************/
+bool RTC_cache_block_reader::open(fs::File file) {
+  close();
+  _file = file;
+
+  if (!_file) {
+    return false;
+  }
+  uint8_t header[RTC_CACHE_FILE_HEADER_SIZE]{};
+
+  _blockFormat = (_file.read(header, sizeof(header)) == sizeof(header)) && isFileHeader(header);
+
+  if (!_blockFormat) {
+    // Plain samples
+    _file.seek(0);
+    return true;
+  }
+
+  // Create the block index from the block headers
+  const size_t fileSize = _file.size();
+  size_t offset         = RTC_CACHE_FILE_HEADER_SIZE;
+
+  while ((offset + RTC_CACHE_BLOCK_HEADER_SIZE) <= fileSize && offset <= 0xFFFF) {
+    uint8_t blockHeader[RTC_CACHE_BLOCK_HEADER_SIZE]{};
+
+    if (!_file.seek(offset) ||
+        (_file.read(blockHeader, sizeof(blockHeader)) != sizeof(blockHeader))) {
+      break;
+    }
+    const uint8_t  type        = blockHeader[0];
+    const uint16_t decodedSize = getUint16(blockHeader + 2);
+    const uint16_t payloadSize = getUint16(blockHeader + 4);
+
+    if (((type != RTC_CACHE_BLOCK_STORED) && (type != RTC_CACHE_BLOCK_COMPRESSED)) ||
+        ((offset + RTC_CACHE_BLOCK_HEADER_SIZE + payloadSize) > fileSize)) {
+      // Incomplete block, e.g. due to an error while writing
+      break;
+    }
+    _blocks.push_back({ static_cast<uint16_t>(offset), decodedSize });
+    _size  += decodedSize;
+    offset += RTC_CACHE_BLOCK_HEADER_SIZE + payloadSize;
+  }
+  return true;
+}
+
+void RTC_cache_block_reader::close() {
+  if (_file) {
+    _file.close();
+  }
+
+  // Release the allocated memory
+  std::vector<BlockInfo>().swap(_blocks);
+  std::vector<uint8_t>().swap(_decoded);
+  _size         = 0;
+  _pos          = 0;
+  _decodedStart = 0;
+  _decodedBlock = -1;
+  _blockFormat  = false;
+}
+
+size_t RTC_cache_block_reader::size() const {
+  if (!_blockFormat) {
+    return _file.size();
+  }
+  return _size;
+}
+
+size_t RTC_cache_block_reader::position() const {
+  if (!_blockFormat) {
+    return _file.position();
+  }
+  return _pos;
+}
+
+bool RTC_cache_block_reader::seek(uint32_t pos, fs::SeekMode mode) {
+  if (!_blockFormat) {
+    return _file.seek(pos, mode);
+  }
+  size_t newPos = pos;
+
+  if (mode == fs::SeekCur) {
+    newPos += _pos;
+  } else if (mode == fs::SeekEnd) {
+    newPos += _size;
+  }
+
+  if (newPos > _size) {
+    return false;
+  }
+  _pos = newPos;
+  return true;
+}
+
+size_t RTC_cache_block_reader::read(uint8_t *buf, size_t size) {
+  if (!_blockFormat) {
+    return _file.read(buf, size);
+  }
+  size_t bytesRead = 0;
+
+  while (bytesRead < size && _pos < _size && loadBlock(_pos)) {
+    const size_t offset    = _pos - _decodedStart;
+    const size_t available = _decoded.size() - offset;
+    const size_t nrBytes   = (size - bytesRead) < available ? (size - bytesRead) : available;
+
+    memcpy(buf + bytesRead, &_decoded[offset], nrBytes);
+    bytesRead += nrBytes;
+    _pos      += nrBytes;
+  }
+  return bytesRead;
+}
+
+bool RTC_cache_block_reader::loadBlock(size_t pos) {
+  if (_decodedBlock >= 0) {
+    if ((pos >= _decodedStart) && (pos < (_decodedStart + _decoded.size()))) {
+      return true;
+    }
+  }
+
+  // Reading sequentially, so continue from the current block when possible
+  size_t blockNr = 0;
+  size_t start   = 0;
+
+  if ((_decodedBlock >= 0) && (pos >= _decodedStart)) {
+    blockNr = _decodedBlock;
+    start   = _decodedStart;
+  }
+
+  for (; blockNr < _blocks.size(); ++blockNr) {
+    const size_t end = start + _blocks[blockNr].decodedSize;
+
+    if (pos < end) {
+      _decodedStart = start;
+      return decodeBlock(blockNr);
+    }
+    start = end;
+  }
+  return false;
+}
+
+bool RTC_cache_block_reader::decodeBlock(size_t blockNr) {
+  _decodedBlock = -1;
+  const BlockInfo& info = _blocks[blockNr];
+  uint8_t header[RTC_CACHE_BLOCK_HEADER_SIZE]{};
+  bool    success = false;
+
+  if (_file.seek(info.fileOffset) &&
+      (_file.read(header, sizeof(header)) == sizeof(header))) {
+    const uint16_t payloadSize = getUint16(header + 4);
+    std::vector<uint8_t> payload(payloadSize);
+
+    if ((_file.read(payload.data(), payloadSize) == payloadSize) &&
+        (static_cast<uint16_t>(calc_CRC16(reinterpret_cast<const char *>(payload.data()), payloadSize)) == getUint16(header + 6))) {
+      _decoded.resize(info.decodedSize);
+
+      if (header[0] == RTC_CACHE_BLOCK_STORED) {
+        success = payloadSize == info.decodedSize;
+
+        if (success) {
+          memcpy(_decoded.data(), payload.data(), payloadSize);
+        }
+      } else {
+        success = ((info.decodedSize % RTC_CACHE_SAMPLE_SIZE) == 0) &&
+                  decodeSamples(payload.data(), payloadSize, _decoded);
+      }
+    }
+  }
+
+  if (!success) {
+    // Corrupt block, do not read beyond this point
+    _size = _decodedStart;
+    _blocks.resize(blockNr);
+    _decoded.clear();
+    return false;
+  }
+  _decodedBlock = blockNr;
+  return true;
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
@@ -0,0 +1,104 @@
+#ifndef DATASTRUCTS_RTC_CACHE_BLOCK_CODEC_H
+#define DATASTRUCTS_RTC_CACHE_BLOCK_CODEC_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
+
+# include <FS.h>
+# include <vector>
+
+/*********************************************************************************************\
+* Block based file format for the cache files of the Cache Controller (C016)
+*
+* Each flush of the RTC buffer is appended to the cache file as a single block.
+* The samples (C016_binary_element) in a block are compressed per task:
+*  - Timestamp is stored as the change in interval compared to the previous sample of the task.
+*  - Each task value is XORed with the previous value of the task,
+*    only the bits which differ are stored (Gorilla float compression).
+* Blocks do not depend on each other, so decoding can start at any block.
+* A block is stored uncompressed when compression does not make it smaller.
+*
+* File header (8 bytes):  "ECB", version, sample size, 3 bytes reserved
+* Block header (8 bytes): type, reserved, uint16_t decoded size, uint16_t payload size, uint16_t CRC16 of payload
+*
+* Files without file header are read as plain concatenated samples, as written by older builds.
+\*********************************************************************************************/
+
+// Check whether data should be appended to this file as blocks.
+// This is the case for new and empty files and files starting with the file header.
+bool RTC_cache_block_useBlockFormat(const String& fname);
+
+// Format of the file as shown to external tools reading the cache files:
+// "ECB" + version for the block format, "raw" for plain concatenated samples.
+String RTC_cache_block_getFileFormat(const String& fname);
+
+// Append the file header to out.
+void RTC_cache_block_appendFileHeader(std::vector<uint8_t>& out);
+
+// Encode the samples in data as a single block and append it to out.
+void RTC_cache_block_encode(const uint8_t        *data,
+                            size_t                size,
+                            std::vector<uint8_t>& out);
+
+
+/*********************************************************************************************\
+* RTC_cache_block_reader
+*
+* Read a cache file using the same calls as fs::File.
+* Size and positions refer to the decoded data, so they are the same as for a file
+* with plain samples.
+* When opening the file, only the block headers are read to create an index of the blocks.
+* Seeking only needs to decode the block containing the new position.
+\*********************************************************************************************/
+class RTC_cache_block_reader {
+public:
+
+  RTC_cache_block_reader() = default;
+
+  RTC_cache_block_reader(const RTC_cache_block_reader& other)            = delete;
+  RTC_cache_block_reader& operator=(const RTC_cache_block_reader& other) = delete;
+
+  bool open(fs::File file);
+
+  void close();
+
+  operator bool() const {
+    return _file;
+  }
+
+  size_t size() const;
+
+  size_t position() const;
+
+  bool   seek(uint32_t     pos,
+              fs::SeekMode mode = fs::SeekSet);
+
+  size_t read(uint8_t *buf,
+              size_t   size);
+
+private:
+
+  // Make sure the block containing pos is decoded
+  bool loadBlock(size_t pos);
+
+  bool decodeBlock(size_t blockNr);
+
+  struct BlockInfo {
+    uint16_t fileOffset;
+    uint16_t decodedSize;
+  };
+
+  fs::File               _file;
+  std::vector<BlockInfo> _blocks;
+  std::vector<uint8_t>   _decoded;
+  size_t                 _size         = 0;
+  size_t                 _pos          = 0;
+  size_t                 _decodedStart = 0;
+  int                    _decodedBlock = -1;
+  bool                   _blockFormat  = false;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
+
+#endif // ifndef DATASTRUCTS_RTC_CACHE_BLOCK_CODEC_H
@@ -144,7 +144,11 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
 
     if (fname.isEmpty()) { return; }
 
+#if FEATURE_RTC_CACHE_COMPRESSION
+    fp.open(tryOpenFile(fname, "r"));
+#else // if FEATURE_RTC_CACHE_COMPRESSION
     fp = tryOpenFile(fname, "r");
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
   }
 
   if (fp) {
@@ -273,7 +277,22 @@ bool RTC_cache_handler_struct::flush() {
         fp.close();
       }
 
-      int bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      const uint8_t *writeData = &RTC_cache_data[0];
+      int writeSize            = RTC_cache.writePos;
+#if FEATURE_RTC_CACHE_COMPRESSION
+      std::vector<uint8_t> block;
+
+      if (fwBlockFormat) {
+        if (fw.size() == 0) {
+          RTC_cache_block_appendFileHeader(block);
+        }
+        RTC_cache_block_encode(&RTC_cache_data[0], RTC_cache.writePos, block);
+        writeData = block.data();
+        writeSize = block.size();
+      }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+      int bytesWritten = fw.write(writeData, writeSize);
 
       delay(0);
       fw.flush();
@@ -282,7 +301,7 @@ bool RTC_cache_handler_struct::flush() {
         #endif // ifdef RTC_STRUCT_DEBUG
 
 
-      if ((bytesWritten < RTC_cache.writePos) /*|| (fw.size() == filesize)*/) {
+      if ((bytesWritten < writeSize) /*|| (fw.size() == filesize)*/) {
           #ifdef RTC_STRUCT_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -325,7 +344,7 @@ String RTC_cache_handler_struct::getReadCacheFileName(int& readPos) {
         // First attempt failed, so stored read position is not valid
         RTC_cache.readPos = 0;
       }
-      readPos = RTC_cache.readPos;
+      readPos = RTC_cache.readPos * RTC_CACHE_READPOS_UNIT;
       return fname;
     }
 
@@ -336,10 +355,37 @@ String RTC_cache_handler_struct::getReadCacheFileName(int& readPos) {
 
   // No file found
   RTC_cache.readPos = 0;
-  readPos           = RTC_cache.readPos;
+  readPos           = 0;
   return EMPTY_STRING;
 }
 
+bool RTC_cache_handler_struct::getReadFilePos(int& fileNr, int& readPos) {
+  const bool fileFound = !getReadCacheFileName(readPos).isEmpty();
+
+  fileNr = RTC_cache.readFileNr;
+  return fileFound;
+}
+
+bool RTC_cache_handler_struct::setReadFilePos(int fileNr, int readPos) {
+  if (fileNr > RTC_cache.readFileNr) {
+    // All data in the files before fileNr has been processed.
+    deleteCacheBlock(fileNr - 1);
+  }
+
+  if (fileNr != RTC_cache.readFileNr) {
+    // Could not remove the processed files, or trying to set to a no longer existing file.
+    return false;
+  }
+
+  if ((readPos < 0) || ((readPos / RTC_CACHE_READPOS_UNIT) > 0xFFFF)) {
+    return false;
+  }
+  RTC_cache.readPos = readPos / RTC_CACHE_READPOS_UNIT;
+
+  // Only store the metadata
+  return saveRTCcache(0, 0);
+}
+
 String RTC_cache_handler_struct::getNextCacheFileName(int& fileNr, bool& islast)  {
   int filepos = 0;
   validateFilePos(fileNr, filepos);
@@ -433,6 +479,9 @@ bool RTC_cache_handler_struct::deleteCacheBlock(int fileNr)
 
       if (tryDeleteFile(fname)) {
         fileDeleted = true;
+
+        // Read position was in the deleted file.
+        RTC_cache.readPos = 0;
         #ifdef RTC_STRUCT_DEBUG
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
           addLogMove(LOG_LEVEL_INFO, concat(F("RTC  : Removed file from FS: "), fname));
@@ -565,7 +614,7 @@ bool RTC_cache_handler_struct::updateRTC_filenameCounters() {
   size_t filesizeHighest;
 
   if (getCacheFileCounters(RTC_cache.readFileNr, RTC_cache.writeFileNr, filesizeHighest)) {
-    if (filesizeHighest >= CACHE_FILE_MAX_SIZE) {
+    if (filesizeHighest >= RTC_CACHE_FILE_MAX_SIZE) {
       // Start new file
       ++RTC_cache.writeFileNr;
     }
@@ -602,7 +651,7 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
   while (retries > 0) {
     --retries;
 
-    if (fw && (fw.size() >= CACHE_FILE_MAX_SIZE)) {
+    if (fw && (fw.size() >= RTC_CACHE_FILE_MAX_SIZE)) {
       fw.close();
       GarbageCollection();
     }
@@ -612,13 +661,18 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
       initRTCcache_data();
 
       if (updateRTC_filenameCounters()) {
-        if (writeError || (SpiffsFreeSpace() < ((2 * CACHE_FILE_MAX_SIZE) + SpiffsBlocksize()))) {
+        if (writeError || (SpiffsFreeSpace() < ((2 * RTC_CACHE_FILE_MAX_SIZE) + SpiffsBlocksize()))) {
           // Not enough room for another file, remove the oldest one.
           deleteOldestCacheBlock();
         }
       }
 
       String fname = createCacheFilename(RTC_cache.writeFileNr);
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+      // Keep appending plain samples to files written by older builds
+      fwBlockFormat = RTC_cache_block_useBlockFormat(fname);
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
       fw = tryOpenFile(fname, "a+");
 
       if (!fw) {
@@ -639,7 +693,7 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
     }
     delay(0);
 
-    if (fw && (fw.size() < CACHE_FILE_MAX_SIZE)) {
+    if (fw && (fw.size() < RTC_CACHE_FILE_MAX_SIZE)) {
       return true;
     }
   }
@@ -8,6 +8,7 @@
 #if FEATURE_RTC_CACHE_STORAGE
 
 #include "../DataStructs/RTCCacheStruct.h"
+#include "../DataStructs/RTC_cache_block_codec.h"
 
 #include <FS.h>
 #include <vector>
@@ -29,6 +30,18 @@
 
 // #define RTC_STRUCT_DEBUG
 
+// The read position is stored in RTC as uint16_t in units of this nr of bytes.
+// This allows read positions up to 512 kB, which is more than the decoded size of a cache file.
+#define RTC_CACHE_READPOS_UNIT      8
+
+#if FEATURE_RTC_CACHE_COMPRESSION
+// Compressed cache files contain at most about 20x their size in samples.
+// Limit the file size, so the read position of the decoded data still fits in RTC.
+# define RTC_CACHE_FILE_MAX_SIZE    ((CACHE_FILE_MAX_SIZE < 16384) ? CACHE_FILE_MAX_SIZE : 16384)
+#else // if FEATURE_RTC_CACHE_COMPRESSION
+# define RTC_CACHE_FILE_MAX_SIZE    CACHE_FILE_MAX_SIZE
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
 /********************************************************************************************\
    RTC located cache
  \*********************************************************************************************/
@@ -64,6 +77,17 @@ struct RTC_cache_handler_struct
   // Will be empty if there is no file to process.
   String getReadCacheFileName(int& readPos);
 
+  // Get the position up to where the cached data has been processed (e.g. uploaded).
+  // Return false when there is no cache file to read from.
+  bool   getReadFilePos(int& fileNr,
+                        int& readPos);
+
+  // Mark all data up to the given position as processed.
+  // Cache files which are processed completely will be deleted.
+  // @param readPos must be a multiple of RTC_CACHE_READPOS_UNIT
+  bool   setReadFilePos(int fileNr,
+                        int readPos);
+
   String getNextCacheFileName(int& fileNr, bool& islast);
 
   bool   deleteOldestCacheBlock();
@@ -110,12 +134,19 @@ private:
 #endif // ifdef ESP8266
   fs::File fw;  // File handler Write
   fs::File fr;  // File handler Read
+#if FEATURE_RTC_CACHE_COMPRESSION
+  RTC_cache_block_reader fp;  // File handler Peek
+#else // if FEATURE_RTC_CACHE_COMPRESSION
   fs::File fp;  // File handler Peek
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
   size_t   _peekfilenr  = 0;
   size_t   _peekreadpos = 0;
 
   uint8_t storageLocation = CACHE_STORAGE_SPIFFS;
   bool    writeError      = false;
+#if FEATURE_RTC_CACHE_COMPRESSION
+  bool    fwBlockFormat   = false; // Write to fw as compressed blocks
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
 };
 
 #endif
@@ -0,0 +1,115 @@
+#ifndef DATASTRUCTS_SPSC_QUEUE_H
+#define DATASTRUCTS_SPSC_QUEUE_H
+
+#include "../../ESPEasy_common.h"
+
+#include <atomic>
+#include <utility>
+
+// **************************************************************************/
+// Lock-free single-producer/single-consumer queue with fixed capacity.
+//
+// Only one thread (or task) may call push() and only one other thread may call pop().
+// No locks or heap allocations are used, so both sides never block each other.
+//
+// Capacity N must be a power of 2.
+// Head and tail are free running counters, the difference is the number of elements stored.
+//
+// push() and pop() may be called from an ISR.
+// They are forced inline, so when called from an IRAM_ATTR function
+// the code is also placed in IRAM.
+// Only 32 bit atomic loads and stores are used, which are lock-free on ESP8266 and ESP32.
+// **************************************************************************/
+
+#define SPSC_QUEUE_INLINE inline __attribute__((always_inline))
+
+template<typename T, uint32_t N>
+class SPSC_Queue {
+  static_assert(N >= 2 && ((N & (N - 1)) == 0), "SPSC_Queue capacity must be a power of 2");
+
+public:
+
+  SPSC_Queue() : _head(0), _tail(0), _overflowCount(0) {}
+
+  // Don't allow to copy or move the queue
+  SPSC_Queue(const SPSC_Queue& other)            = delete;
+  SPSC_Queue(SPSC_Queue&& other)                 = delete;
+  SPSC_Queue& operator=(const SPSC_Queue& other) = delete;
+  SPSC_Queue& operator=(SPSC_Queue&& other)      = delete;
+
+  // Producer side
+  SPSC_QUEUE_INLINE bool push(const T& item) {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+
+    if ((head - _tail.load(std::memory_order_acquire)) >= N) {
+      incOverflowCount();
+      return false;
+    }
+    _buffer[head & (N - 1)] = item;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  SPSC_QUEUE_INLINE bool push(T&& item) {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+
+    if ((head - _tail.load(std::memory_order_acquire)) >= N) {
+      incOverflowCount();
+      return false;
+    }
+    _buffer[head & (N - 1)] = std::move(item);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side
+  SPSC_QUEUE_INLINE bool pop(T& item) {
+    const uint32_t tail = _tail.load(std::memory_order_relaxed);
+
+    if (tail == _head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = std::move(_buffer[tail & (N - 1)]);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // May be called from either side, result is just a snapshot.
+  uint32_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  bool full() const {
+    return size() >= N;
+  }
+
+  static constexpr uint32_t capacity() {
+    return N;
+  }
+
+  // Number of failed push() calls due to a full queue.
+  // Only updated by the producer, may be read by the consumer.
+  uint32_t getOverflowCount() const {
+    return _overflowCount.load(std::memory_order_acquire);
+  }
+
+private:
+
+  // Single producer, so no need for an atomic read-modify-write.
+  // (which is not lock-free on ESP8266)
+  SPSC_QUEUE_INLINE void incOverflowCount() {
+    _overflowCount.store(_overflowCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  T _buffer[N];
+
+  std::atomic<uint32_t> _head;          // Only written by producer
+  std::atomic<uint32_t> _tail;          // Only written by consumer
+  std::atomic<uint32_t> _overflowCount; // Only written by producer
+};
+
+#endif // ifndef DATASTRUCTS_SPSC_QUEUE_H
@@ -197,6 +197,12 @@ class SettingsStruct_tmpl
   bool EnableIPv6() const { return !VariousBits_2.EnableIPv6; }
   void EnableIPv6(bool value) { VariousBits_2.EnableIPv6 = !value; }
 
+  #if FEATURE_CONTROLLER_WORKER_TASK
+  // Process controller delay queues in a separate RTOS task
+  bool ControllerWorkerTask() const { return VariousBits_2.ControllerWorkerTask; }
+  void ControllerWorkerTask(bool value) { VariousBits_2.ControllerWorkerTask = value; }
+  #endif // if FEATURE_CONTROLLER_WORKER_TASK
+
   // Use Espressif's auto reconnect.
   bool SDK_WiFi_autoreconnect() const { return VariousBits_2.SDK_WiFi_autoreconnect; }
   void SDK_WiFi_autoreconnect(bool value) { VariousBits_2.SDK_WiFi_autoreconnect = value; }
@@ -535,7 +541,7 @@ public:
     uint32_t EnableIPv6                       : 1; // Bit 04  // inverted
     uint32_t DisableSaveConfigAsTar           : 1; // Bit 05
     uint32_t PassiveWiFiScan                  : 1; // Bit 06  // inverted
-    uint32_t unused_07                        : 1; // Bit 07
+    uint32_t ControllerWorkerTask             : 1; // Bit 07
     uint32_t unused_08                        : 1; // Bit 08
     uint32_t unused_09                        : 1; // Bit 09
     uint32_t unused_10                        : 1; // Bit 10
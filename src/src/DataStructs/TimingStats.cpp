@@ -7,11 +7,24 @@
 # include "../Helpers/_CPlugin_Helper.h"
 # include "../Helpers/StringConverter.h"
 
+# if FEATURE_CONTROLLER_WORKER_TASK
+#  include "../ControllerQueue/ControllerWorker.h"
+# endif // if FEATURE_CONTROLLER_WORKER_TASK
+
 std::map<int, TimingStats> pluginStats;
 std::map<int, TimingStats> controllerStats;
 std::map<TimingStatsElements, TimingStats> miscStats;
 unsigned long timingstats_last_reset(0);
 
+// The stats maps are not thread safe, so only collect stats from the main loop.
+static bool timingStatsEnabled() {
+  # if FEATURE_CONTROLLER_WORKER_TASK
+
+  if (ControllerWorker_inWorkerTask()) { return false; }
+  # endif // if FEATURE_CONTROLLER_WORKER_TASK
+  return Settings.EnableTimingStats();
+}
+
 
 TimingStats::TimingStats() : _timeTotal(0.0f), _count(0), _maxVal(0), _minVal(4294967295) {}
 
@@ -102,7 +115,7 @@ const __FlashStringHelper* getPluginFunctionName(int function) {
 }
 
 bool mustLogFunction(int function) {
-  if (!Settings.EnableTimingStats()) { return false; }
+  if (!timingStatsEnabled()) { return false; }
 
   switch (function) {
 //    case PLUGIN_INIT_ALL:              return false;
@@ -173,7 +186,7 @@ const __FlashStringHelper* getCPluginCFunctionName(CPlugin::Function function) {
 }
 
 bool mustLogCFunction(CPlugin::Function function) {
-  if (!Settings.EnableTimingStats()) { return false; }
+  if (!timingStatsEnabled()) { return false; }
 
   switch (function) {
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:              return false;
@@ -333,12 +346,12 @@ void stopTimerController(protocolIndex_t T, CPlugin::Function F, uint64_t statis
 
 void stopTimer(TimingStatsElements L, uint64_t statisticsTimerStart)
 {
-  if (Settings.EnableTimingStats()) { miscStats[L].add(usecPassedSince(statisticsTimerStart)); }
+  if (timingStatsEnabled()) { miscStats[L].add(usecPassedSince(statisticsTimerStart)); }
 }
 
 void addMiscTimerStat(TimingStatsElements L, int64_t T)
 {
-  if (Settings.EnableTimingStats()) { miscStats[L].add(T); }
+  if (timingStatsEnabled()) { miscStats[L].add(T); }
 }
 
 #endif // if FEATURE_TIMING_STATS
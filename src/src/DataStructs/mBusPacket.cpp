@@ -187,10 +187,10 @@ bool mBusPacket_t::matchSerial(uint32_t serialNr) const
   return _deviceId1.matchSerial(serialNr) || _deviceId2.matchSerial(serialNr);
 }
 
-bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
+// getByte(offset) returns the byte at offset in the payload without checksums, 0 when beyond payloadSize
+template<typename GetByte>
+bool mBusPacket_t::parseHeaders(int payloadSize, GetByte getByte)
 {
-  const int payloadSize = payloadWithoutChecksums.size();
-
   _deviceId1.clear();
   _deviceId2.clear();
 
@@ -199,32 +199,32 @@ bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
 
   // 1st block is a static DataLinkLayer of 10 bytes
   {
-    _deviceId1._manufacturer = makeWord(payloadWithoutChecksums[offset + 3], payloadWithoutChecksums[offset + 2]);
+    _deviceId1._manufacturer = makeWord(getByte(offset + 3), getByte(offset + 2));
 
     // Type (offset + 9; convert to hex)
-    _deviceId1._meterType = payloadWithoutChecksums[offset + 9];
+    _deviceId1._meterType = getByte(offset + 9);
 
     // Serial (offset + 4; 4 Bytes; least significant first; converted to hex)
     _deviceId1._serialNr = 0;
 
     for (int i = 0; i < 4; ++i) {
-      const uint32_t val = payloadWithoutChecksums[offset + 4 + i];
+      const uint32_t val = getByte(offset + 4 + i);
       _deviceId1._serialNr += val << (i * 8);
     }
     offset            += 10;
-    _deviceId1._length = payloadWithoutChecksums[0];
+    _deviceId1._length = getByte(0);
   }
 
   // next blocks can be anything. we skip known blocks of no interest, parse known blocks if interest and stop on onknown blocks
   while (offset < payloadSize) {
-    switch (static_cast<int>(payloadWithoutChecksums[offset])) {
+    switch (static_cast<int>(getByte(offset))) {
       case 0x8C:                                            // ELL short
         offset            += 3;                             // fixed length
         _deviceId1._length = payloadSize - offset;
         break;
       case 0x90:                                            // AFL
         offset++;
-        offset += (payloadWithoutChecksums[offset] & 0xff); // dynamic length with length in 1st byte
+        offset += (getByte(offset) & 0xff);                 // dynamic length with length in 1st byte
         offset++;                                           // length byte
         _deviceId1._length = payloadSize - offset;
         break;
@@ -233,17 +233,17 @@ bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
 
         // note that serial/manufacturer are swapped !!
 
-        _deviceId1._manufacturer = makeWord(payloadWithoutChecksums[offset + 6], payloadWithoutChecksums[offset + 5]);
+        _deviceId1._manufacturer = makeWord(getByte(offset + 6), getByte(offset + 5));
 
         // Type (offset + 9; convert to hex)
-        _deviceId1._meterType = payloadWithoutChecksums[offset + 8];
+        _deviceId1._meterType = getByte(offset + 8);
 
         // Serial (offset + 4; 4 Bytes; least significant first; converted to hex)
         _deviceId1._serialNr = 0;
 
 
         for (int i = 0; i < 4; ++i) {
-          const uint32_t val = payloadWithoutChecksums[offset + 1 + i];
+          const uint32_t val = getByte(offset + 1 + i);
           _deviceId1._serialNr += val << (i * 8);
         }
 
@@ -266,6 +266,46 @@ bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
   return _deviceId1.isValid();
 }
 
+bool mBusPacket_t::parseHeaders(const mBusPacket_data& payloadWithoutChecksums)
+{
+  const int payloadSize = payloadWithoutChecksums.size();
+
+  return parseHeaders(payloadSize, [&payloadWithoutChecksums, payloadSize](int offset) -> uint8_t {
+    return (offset < payloadSize) ? payloadWithoutChecksums[offset] : 0;
+  });
+}
+
+bool mBusPacket_t::parseHeaderOnly(const String& payload)
+{
+  if (payload[0] != 'b') { return false; }
+
+  _checksum = 0;
+  _lqi_rssi = 0;
+
+  uint8_t lengthByte = 0;
+
+  if (payload[1] == 'Y') {
+    const int payloadSize = getPayloadSizeFrameB(payload, lengthByte);
+
+    if (payloadSize < 10) { return false; }
+
+    return parseHeaders(payloadSize, [&payload, payloadSize, lengthByte](int offset) -> uint8_t {
+      if (offset >= payloadSize) { return 0; }
+
+      // Length byte is corrected for the removed checksums, see removeChecksumsFrameB()
+      return (offset == 0) ? lengthByte : hexToByte(payload, getHexIndexFrameB(offset));
+    });
+  }
+
+  const int payloadSize = getPayloadSizeFrameA(payload, lengthByte);
+
+  if (payloadSize < 10) { return false; }
+
+  return parseHeaders(payloadSize, [&payload, payloadSize](int offset) -> uint8_t {
+    return (offset < payloadSize) ? hexToByte(payload, getHexIndexFrameA(offset)) : 0;
+  });
+}
+
 String mBusPacket_t::toString() const
 {
   static size_t expectedSize = 96;
@@ -310,6 +350,67 @@ uint8_t mBusPacket_t::hexToByte(const String& str, size_t index)
   return hexToUL(str, index, 2);
 }
 
+int mBusPacket_t::getPayloadSizeFrameA(const String& payload, uint8_t& lengthByte)
+{
+  // Same checks as removeChecksumsFrameA()
+  const int payloadLength = payload.length();
+
+  if (payloadLength < 4) { return 0; }
+
+  lengthByte = hexToByte(payload, 1);
+  const int expectedMessageSize = lengthByte + 1;
+
+  if (payloadLength < (2 * expectedMessageSize)) { return 0; }
+  return expectedMessageSize;
+}
+
+int mBusPacket_t::getPayloadSizeFrameB(const String& payload, uint8_t& lengthByte)
+{
+  // Same checks as removeChecksumsFrameB()
+  const int payloadLength = payload.length();
+
+  if (payloadLength < 4) { return 0; }
+
+  int expectedMessageSize = hexToByte(payload, 2) + 1;
+
+  if (payloadLength < (2 * expectedMessageSize)) { return 0; }
+
+  expectedMessageSize -= 2;   // CRC of 1st block
+
+  if (expectedMessageSize > 128) {
+    expectedMessageSize -= 2; // CRC of 2nd block
+  }
+  lengthByte = static_cast<uint8_t>((expectedMessageSize - 1) & 0xff);
+
+  if (expectedMessageSize <= 126) { return expectedMessageSize; }
+
+  const int block2Size = expectedMessageSize - 127;
+
+  return 126 + (block2Size > 124 ? 124 : block2Size);
+}
+
+int mBusPacket_t::getHexIndexFrameA(int offset)
+{
+  // Starts with "b", each block is followed by 2 bytes CRC => 4 hex chars
+  if (offset < FRAME_FORMAT_A_FIRST_BLOCK_LENGTH) {
+    return 1 + 2 * offset;
+  }
+  offset -= FRAME_FORMAT_A_FIRST_BLOCK_LENGTH;
+
+  return 1 + (2 * FRAME_FORMAT_A_FIRST_BLOCK_LENGTH + 4) +
+         (offset / FRAME_FORMAT_A_OTHER_BLOCK_LENGTH) * (2 * FRAME_FORMAT_A_OTHER_BLOCK_LENGTH + 4) +
+         (offset % FRAME_FORMAT_A_OTHER_BLOCK_LENGTH) * 2;
+}
+
+int mBusPacket_t::getHexIndexFrameB(int offset)
+{
+  // Starts with "bY", 1st block of 126 bytes is followed by 2 bytes CRC => 4 hex chars
+  if (offset < 126) {
+    return 2 + 2 * offset;
+  }
+  return 2 + (2 * 126 + 4) + 2 * (offset - 126);
+}
+
 /**
  * Format:
  * [10 bytes message] + [2 bytes CRC]
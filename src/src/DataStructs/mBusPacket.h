@@ -58,6 +58,10 @@ public:
 
   bool                       parse(const String& payload);
 
+  // Only decode the device headers, without decoding the rest of the payload.
+  // Much faster than parse(), but the checksum and LQI/RSSI are not set.
+  bool                       parseHeaderOnly(const String& payload);
+
   // Get the header of the actual device, not the forwarding device (if present)
   const mBusPacket_header_t* getDeviceHeader() const;
 
@@ -89,8 +93,22 @@ private:
   static mBusPacket_data removeChecksumsFrameB(const String& payload,
                                                uint32_t    & checksum);
 
+  // Size of the payload without checksums, 0 when the payload is too short
+  static int             getPayloadSizeFrameA(const String& payload,
+                                              uint8_t     & lengthByte);
+  static int             getPayloadSizeFrameB(const String& payload,
+                                              uint8_t     & lengthByte);
+
+  // Index of a byte of the payload without checksums in the received HEX string
+  static int             getHexIndexFrameA(int offset);
+  static int             getHexIndexFrameB(int offset);
+
   bool                   parseHeaders(const mBusPacket_data& payloadWithoutChecksums);
 
+  template<typename GetByte>
+  bool                   parseHeaders(int     payloadSize,
+                                      GetByte getByte);
+
 public:
 
   mBusPacket_header_t _deviceId1;
@@ -139,17 +139,12 @@ void incoming_mqtt_callback(char *c_topic, uint8_t *b_payload, unsigned int leng
 
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_ID_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
 
-  if (validDeviceIndex(DeviceIndex)) {
-    //  Here we loop over all tasks and call each 037 plugin with function PLUGIN_MQTT_IMPORT
-    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
-    {
-      if (Settings.TaskDeviceEnabled[taskIndex] && (Settings.getPluginID_for_task(taskIndex) == PLUGIN_ID_MQTT_IMPORT))
-      {
-        Scheduler.schedule_mqtt_plugin_import_event_timer(
-          DeviceIndex, taskIndex, PLUGIN_MQTT_IMPORT,
-          c_topic, b_payload, length);
-      }
-    }
+  // Only schedule a single event, and only when at least one import task is subscribed to this topic.
+  // The event is dispatched to each matching 037 plugin with function PLUGIN_MQTT_IMPORT
+  if (validDeviceIndex(DeviceIndex) && MQTTimport_subscriptions.hasMatch(c_topic)) {
+    Scheduler.schedule_mqtt_plugin_import_event_timer(
+      DeviceIndex, PLUGIN_MQTT_IMPORT,
+      c_topic, b_payload, length);
   }
 }
 
@@ -812,6 +807,70 @@ bool MQTT_queueFull(controllerIndex_t controller_idx) {
   return false;
 }
 
+# if FEATURE_MQTT_DIRECT_PUBLISH
+
+// Publish without using the queue, when no message is waiting and the send interval has passed.
+// The payload is copied straight into the write buffer of the MQTT client,
+// which is sent to the network each time the buffer is full.
+// This saves the copies of topic and payload kept in the queue element.
+// Returns false when the message was not sent and should be queued.
+bool MQTTpublish_direct(const char *topic,
+                        const char *payload,
+                        size_t      payloadLength,
+                        bool        retained)
+{
+  if (!MQTTclient_connected || (topic == nullptr) || !MQTTDelayHandler->sendQueue.empty()) {
+    return false;
+  }
+#  if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (MQTTDelayHandler->getSpillCount() != 0) {
+    return false;
+  }
+#  endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (timePassedSince(MQTTDelayHandler->lastSend) < static_cast<long>(MQTTDelayHandler->getSendInterval())) {
+    return false;
+  }
+  // Same topic cleanup as done for queued messages
+  String cleanedTopic;
+
+  if (strstr(topic, "//") != nullptr) {
+    cleanedTopic = topic;
+    MQTT_queue_element::removeEmptyTopics(cleanedTopic);
+    topic = cleanedTopic.c_str();
+  }
+
+#  if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  const uint64_t publishStart = getMicros64();
+#  endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  bool published = MQTTclient.beginPublish(topic, payloadLength, retained);
+
+  if (published) {
+    published = MQTTclient.write(reinterpret_cast<const uint8_t *>(payload), payloadLength) == payloadLength;
+
+    // Also check the last part of the message was sent
+    if (MQTTclient.endPublish() == 0) {
+      published = false;
+    }
+  }
+#  if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+  MQTTDelayHandler->registerSendResult(published, usecPassedSince(publishStart));
+#  endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+  if (!published) {
+    return false;
+  }
+
+  if (WiFiEventData.connectionFailures > 0) {
+    --WiFiEventData.connectionFailures;
+  }
+  MQTTDelayHandler->lastSend = millis();
+  return true;
+}
+
+# endif // if FEATURE_MQTT_DIRECT_PUBLISH
+
 bool MQTTpublish(controllerIndex_t controller_idx,
                  taskIndex_t       taskIndex,
                  const char       *topic,
@@ -822,6 +881,13 @@ bool MQTTpublish(controllerIndex_t controller_idx,
   if (MQTTDelayHandler == nullptr) {
     return false;
   }
+# if FEATURE_MQTT_DIRECT_PUBLISH
+
+  if (!callbackTask &&
+      MQTTpublish_direct(topic, payload, (payload == nullptr) ? 0 : strlen(payload), retained)) {
+    return true;
+  }
+# endif // if FEATURE_MQTT_DIRECT_PUBLISH
 
   if (MQTT_queueFull(controller_idx)) {
     return false;
@@ -844,6 +910,13 @@ bool MQTTpublish(controllerIndex_t controller_idx,
   if (MQTTDelayHandler == nullptr) {
     return false;
   }
+# if FEATURE_MQTT_DIRECT_PUBLISH
+
+  if (!callbackTask &&
+      MQTTpublish_direct(topic.c_str(), payload.c_str(), payload.length(), retained)) {
+    return true;
+  }
+# endif // if FEATURE_MQTT_DIRECT_PUBLISH
 
   if (MQTT_queueFull(controller_idx)) {
     return false;
@@ -62,6 +62,12 @@ controllerIndex_t firstEnabledMQTT_ControllerIndex();
 
 bool MQTT_queueFull(controllerIndex_t controller_idx);
 
+#if FEATURE_MQTT_DIRECT_PUBLISH
+// Publish via the MQTT client buffer, bypassing the queue, when the queue is empty and the send interval has passed.
+// Returns false when the message was not sent and should be queued.
+bool MQTTpublish_direct(const char *topic, const char *payload, size_t payloadLength, bool retained);
+#endif
+
 bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  const char *topic, const char *payload, bool retained, bool callbackTask = false);
 
 // Publish using the move operator for topic and message
@@ -12,6 +12,10 @@
 
 #include <FS.h>
 
+#if FEATURE_CONTROLLER_WORKER_TASK
+#include "../ControllerQueue/ControllerWorker.h"
+#endif
+
 #if FEATURE_SD
 #include <SD.h>
 #include "../Helpers/ESPEasy_Storage.h"
@@ -323,6 +327,16 @@ void addLog(uint8_t logLevel, const String& string)
   #endif
 
   if (string.isEmpty()) return;
+  #if FEATURE_CONTROLLER_WORKER_TASK
+  if (ControllerWorker_inWorkerTask()) {
+    // Log sinks are not thread safe, let the main loop process it.
+    if (loglevelActiveFor(logLevel)) {
+      String tmp(string);
+      ControllerWorker_addLog(logLevel, std::move(tmp));
+    }
+    return;
+  }
+  #endif
   addToSerialLog(logLevel, string);
   addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
@@ -344,6 +358,15 @@ void addToLogMove(uint8_t logLevel, String&& string)
   #endif
 
   if (string.isEmpty()) return;
+  #if FEATURE_CONTROLLER_WORKER_TASK
+  if (ControllerWorker_inWorkerTask()) {
+    // Log sinks are not thread safe, let the main loop process it.
+    if (loglevelActiveFor(logLevel)) {
+      ControllerWorker_addLog(logLevel, std::move(string));
+    }
+    return;
+  }
+  #endif
   addToSerialLog(logLevel, string);
   addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
@@ -12,7 +12,10 @@
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../ESPEasyCore/ESPEasyWifi_ProcessEvent.h"
 #include "../ESPEasyCore/Serial.h"
+#include "../ControllerQueue/ControllerWorker.h"
 #include "../Globals/Cache.h"
+#include "../Globals/CooperativeScheduler.h"
+#include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_Console.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/ESPEasy_time.h"
@@ -655,6 +658,34 @@ void ESPEasy_setup()
   logMemUsageAfter(F("writeDefaultCSS()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
+  // Register background jobs, processed by the scheduler when idle.
+  // Lower priority value will be dispatched first.
+  BackgroundJobs.registerJob(
+    CooperativeJob_e::SystemEventQueue,
+    []() { return Scheduler.process_system_event_queue(); },
+    0,
+    COOPERATIVE_JOB_SYSTEM_EVENT_BUDGET_USEC);
+  BackgroundJobs.registerJob(
+    CooperativeJob_e::RulesEventQueue,
+    []() { return processNextEvent(); },
+    1,
+    COOPERATIVE_JOB_RULES_EVENT_BUDGET_USEC);
+  BackgroundJobs.registerJob(
+    CooperativeJob_e::LogSinks,
+    []() { return process_serialWriteBuffer(); },
+    2,
+    COOPERATIVE_JOB_LOG_SINKS_BUDGET_USEC);
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+  if (Settings.ControllerWorkerTask() && ControllerWorker_start()) {
+    BackgroundJobs.registerJob(
+      CooperativeJob_e::ControllerWorkerResults,
+      []() { return ControllerWorker_processResult(); },
+      0,
+      COOPERATIVE_JOB_CONTROLLER_WORKER_BUDGET_USEC);
+  }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+
 
   #ifdef USE_RTOS_MULTITASKING
   UseRTOSMultitasking = Settings.UseRTOSMultitasking;
@@ -0,0 +1,3 @@
+#include "../Globals/CooperativeScheduler.h"
+
+CooperativeScheduler BackgroundJobs;
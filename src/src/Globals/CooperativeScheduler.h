@@ -0,0 +1,8 @@
+#ifndef GLOBALS_COOPERATIVESCHEDULER_H
+#define GLOBALS_COOPERATIVESCHEDULER_H
+
+#include "../Helpers/CooperativeScheduler.h"
+
+extern CooperativeScheduler BackgroundJobs;
+
+#endif // GLOBALS_COOPERATIVESCHEDULER_H
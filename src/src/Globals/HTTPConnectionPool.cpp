@@ -0,0 +1,5 @@
+#include "../Globals/HTTPConnectionPool.h"
+
+#if FEATURE_HTTP_CONNECTION_POOL
+HTTPConnectionPool HTTPConnections;
+#endif // if FEATURE_HTTP_CONNECTION_POOL
@@ -0,0 +1,10 @@
+#ifndef GLOBALS_HTTPCONNECTIONPOOL_H
+#define GLOBALS_HTTPCONNECTIONPOOL_H
+
+#include "../Helpers/HTTPConnectionPool.h"
+
+#if FEATURE_HTTP_CONNECTION_POOL
+extern HTTPConnectionPool HTTPConnections;
+#endif // if FEATURE_HTTP_CONNECTION_POOL
+
+#endif // GLOBALS_HTTPCONNECTIONPOOL_H
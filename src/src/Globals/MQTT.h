@@ -5,6 +5,7 @@
 
 
 #if FEATURE_MQTT
+# include "../DataStructs/MQTT_TopicTrie.h"
 # include "../Helpers/LongTermTimer.h"
 
 # include <WiFiClient.h>
@@ -32,6 +33,9 @@ extern bool MQTTclient_must_send_LWT_connected;
 extern bool MQTTclient_connected;
 extern int  mqtt_reconnect_count;
 extern LongTermTimer MQTTclient_next_connect_attempt;
+
+// Topics subscribed to by MQTT import tasks, used to route incoming messages
+extern MQTT_TopicTrie MQTTimport_subscriptions;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
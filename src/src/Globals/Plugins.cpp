@@ -28,6 +28,7 @@
 
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Hardware_I2C.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/_Plugin_init.h"
@@ -198,8 +199,13 @@ uint8_t getTaskI2CAddress(taskIndex_t taskIndex) {
 // ********************************************************************************
 // Functions to assist changing I2C multiplexer port or clock speed
 // when addressing a task
+// The multiplexer channel and clock speed are left as-is after a task call,
+// so consecutive calls to tasks with the same I2C bus configuration do not need to switch the bus.
 // ********************************************************************************
 
+static uint64_t I2C_task_call_start_usec = 0;
+static uint8_t  I2C_task_call_depth      = 0;
+
 bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex) {
   if (!validTaskIndex(taskIndex) || !validDeviceIndex(DeviceIndex)) {
     return false;
@@ -212,6 +218,12 @@ bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex)
   if (I2C_state != I2C_bus_state::OK) {
     return false; // Bus state is not OK, so do not consider task runnable
   }
+  if (I2C_task_call_depth == 0) {
+    I2C_task_call_start_usec = getMicros64();
+  }
+  ++I2C_task_call_depth;
+  ++I2C_bus_stats.taskCalls;
+
   #if FEATURE_I2CMULTIPLEXER
   I2CMultiplexerSelectByTaskIndex(taskIndex);
 
@@ -221,6 +233,8 @@ bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex)
 
   if (bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_SLOW_SPEED)) {
     I2CSelectLowClockSpeed(); // Set to slow
+  } else {
+    I2CSelectHighClockSpeed();
   }
   return true;
 }
@@ -230,14 +244,31 @@ void post_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex) {
     return;
   }
 
-  if (Device[DeviceIndex].Type != DEVICE_TYPE_I2C) {
+  if ((Device[DeviceIndex].Type != DEVICE_TYPE_I2C) || (I2C_task_call_depth == 0)) {
     return;
   }
+  --I2C_task_call_depth;
+
+  if (I2C_task_call_depth == 0) {
+    I2C_bus_stats.busTime_usec += usecPassedSince(I2C_task_call_start_usec);
+  }
+}
+
+int16_t getI2C_bus_config_by_taskIndex(taskIndex_t taskIndex) {
+  if (!validTaskIndex(taskIndex) || !Settings.TaskDeviceEnabled[taskIndex]) {
+    return -1;
+  }
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+  if (!validDeviceIndex(DeviceIndex) || (Device[DeviceIndex].Type != DEVICE_TYPE_I2C)) {
+    return -1;
+  }
+  int16_t config = bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_SLOW_SPEED) ? 1 : 0;
+
   #if FEATURE_I2CMULTIPLEXER
-  I2CMultiplexerOff();
+  config |= I2CMultiplexerChannelsForTask(taskIndex) << 1;
   #endif // if FEATURE_I2CMULTIPLEXER
-
-  I2CSelectHighClockSpeed();  // Reset
+  return config;
 }
 
 // Add an event to the event queue.
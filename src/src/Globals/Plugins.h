@@ -102,6 +102,11 @@ String        getPluginNameFromPluginID(pluginID_t pluginID);
 bool prepare_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex);
 void post_I2C_by_taskIndex(taskIndex_t taskIndex, deviceIndex_t DeviceIndex);
 
+// I2C bus configuration of the task, combining the multiplexer channels and clock speed.
+// Tasks with the same value can be called after each other without switching the I2C bus.
+// Return -1 for tasks which are not enabled or not an I2C device.
+int16_t getI2C_bus_config_by_taskIndex(taskIndex_t taskIndex);
+
 void loadDefaultTaskValueNames_ifEmpty(taskIndex_t TaskIndex);
 
 /*********************************************************************************************\
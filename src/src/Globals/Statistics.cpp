@@ -32,3 +32,4 @@ ESPEASY_VOLATILE(unsigned long) sw_watchdog_callback_count{};
 
 I2C_bus_state I2C_state = I2C_bus_state::OK;
 unsigned long I2C_bus_cleared_count = 0;
+I2C_bus_stats_t I2C_bus_stats;
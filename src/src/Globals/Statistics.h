@@ -47,6 +47,7 @@ extern ESPEASY_VOLATILE(unsigned long) sw_watchdog_callback_count;
 
 extern I2C_bus_state I2C_state;
 extern unsigned long I2C_bus_cleared_count;
+extern I2C_bus_stats_t I2C_bus_stats;
 
 
 #endif // GLOBALS_STATISTICS_H
@@ -0,0 +1,97 @@
+#ifndef HELPERS_ADC_SAMPLEACCUMULATOR_H
+#define HELPERS_ADC_SAMPLEACCUMULATOR_H
+
+// Only uses standard headers, so the math can also be checked on a host system.
+#include <stdint.h>
+#include <math.h>
+#include <limits>
+
+/*********************************************************************************************\
+* ADC_SampleAccumulator: Collect raw ADC samples to compute the average and RMS value
+*
+* Only the sum, sum of squares, min and max are kept, so any nr of samples can be collected
+* without storing them.
+* Accumulators can be merged, to decimate a high rate sample stream into blocks
+* which are later combined into a single value.
+\*********************************************************************************************/
+class ADC_SampleAccumulator {
+public:
+
+  ADC_SampleAccumulator() = default;
+
+  void add(int32_t sample) {
+    _sum        += sample;
+    _sumSquares += static_cast<uint64_t>(static_cast<int64_t>(sample) * sample);
+    ++_count;
+
+    if (sample < _min) { _min = sample; }
+
+    if (sample > _max) { _max = sample; }
+  }
+
+  // Merge the samples of another accumulator
+  void add(const ADC_SampleAccumulator& other) {
+    if (other._count == 0) { return; }
+    _sum        += other._sum;
+    _sumSquares += other._sumSquares;
+    _count      += other._count;
+
+    if (other._min < _min) { _min = other._min; }
+
+    if (other._max > _max) { _max = other._max; }
+  }
+
+  void reset() {
+    *this = ADC_SampleAccumulator();
+  }
+
+  uint32_t getCount() const {
+    return _count;
+  }
+
+  int32_t getMin() const {
+    return _min;
+  }
+
+  int32_t getMax() const {
+    return _max;
+  }
+
+  // @param value  Value will only be updated if there were samples available
+  bool getAverage(float& value) const {
+    if (_count == 0) { return false; }
+    value = static_cast<double>(_sum) / _count;
+    return true;
+  }
+
+  // Root mean square of the samples.
+  // When removeOffset is set, the average (DC component) is subtracted first,
+  // which gives the RMS of the AC component. (e.g. a current sensor biased at half the supply voltage)
+  // @param value  Value will only be updated if there were samples available
+  bool getRMS(float& value, bool removeOffset) const {
+    if (_count == 0) { return false; }
+
+    // Use double, the sum of squares does not fit in the precision of a float
+    double meanSquare = static_cast<double>(_sumSquares) / _count;
+
+    if (removeOffset) {
+      const double mean = static_cast<double>(_sum) / _count;
+      meanSquare -= mean * mean;
+
+      // Rounding errors may result in a tiny negative value for a constant signal
+      if (meanSquare < 0.0) { meanSquare = 0.0; }
+    }
+    value = sqrt(meanSquare);
+    return true;
+  }
+
+private:
+
+  int64_t  _sum        = 0;
+  uint64_t _sumSquares = 0;
+  uint32_t _count      = 0;
+  int32_t  _min        = std::numeric_limits<int32_t>::max();
+  int32_t  _max        = std::numeric_limits<int32_t>::min();
+};
+
+#endif // ifndef HELPERS_ADC_SAMPLEACCUMULATOR_H
@@ -0,0 +1,254 @@
+#include "../Helpers/AdafruitGFX_ShadowBuffer.h"
+
+#if defined(PLUGIN_USES_ADAFRUITGFX) && ADAGFX_ENABLE_SHADOW_BUFFER
+
+# include "../Helpers/Memory.h"
+
+# include <algorithm>
+
+// Size of the display in rotation 0
+static int16_t AdaGFX_rotation0Width(Adafruit_SPITFT *tft) {
+  return (tft->getRotation() & 1) ? tft->height() : tft->width();
+}
+
+static int16_t AdaGFX_rotation0Height(Adafruit_SPITFT *tft) {
+  return (tft->getRotation() & 1) ? tft->width() : tft->height();
+}
+
+AdaGFX_ShadowBuffer::AdaGFX_ShadowBuffer(Adafruit_SPITFT *tft)
+  : Adafruit_GFX(AdaGFX_rotation0Width(tft), AdaGFX_rotation0Height(tft)), _tft(tft)
+{
+  setRotation(_tft->getRotation());
+
+  const uint32_t nrPixels = static_cast<uint32_t>(WIDTH) * HEIGHT;
+
+  _buffer  = static_cast<uint16_t *>(special_calloc(nrPixels, sizeof(uint16_t)));
+  _touched = static_cast<uint8_t *>(special_calloc((nrPixels + 7) / 8, sizeof(uint8_t)));
+
+  if ((nullptr == _buffer) || (nullptr == _touched) || (FreeMem() < ADAGFX_SHADOW_MIN_FREE_MEM)) {
+    free(_buffer);
+    free(_touched);
+    _buffer  = nullptr;
+    _touched = nullptr;
+    return;
+  }
+  _rowMin.resize(HEIGHT);
+  _rowMax.resize(HEIGHT);
+  _journal.reserve(64);
+  clearChanges();
+}
+
+AdaGFX_ShadowBuffer::~AdaGFX_ShadowBuffer() {
+  free(_buffer);
+  free(_touched);
+}
+
+/****************************************************************************
+ * getBufferIndex: Map a coordinate in the current rotation to the buffer
+ ***************************************************************************/
+uint32_t AdaGFX_ShadowBuffer::getBufferIndex(int16_t x, int16_t y) const {
+  int16_t t;
+
+  switch (rotation) { // Same mapping as GFXcanvas16
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+  }
+  return static_cast<uint32_t>(y) * WIDTH + x;
+}
+
+void AdaGFX_ShadowBuffer::markChanged(uint16_t px, uint16_t py) {
+  if (px < _rowMin[py]) { _rowMin[py] = px; }
+
+  if (px > _rowMax[py]) { _rowMax[py] = px; }
+}
+
+void AdaGFX_ShadowBuffer::clearChanges() {
+  std::fill(_rowMin.begin(), _rowMin.end(), WIDTH);
+  std::fill(_rowMax.begin(), _rowMax.end(), -1);
+}
+
+/****************************************************************************
+ * Drawing functions, only change the buffer
+ ***************************************************************************/
+void AdaGFX_ShadowBuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((nullptr == _buffer) || (x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+    return;
+  }
+  const uint32_t index = getBufferIndex(x, y);
+
+  if (_buffer[index] == color) { return; }
+
+  if (!bitRead(_touched[index >> 3], index & 7)) {
+    if (_journal.size() < ADAGFX_SHADOW_JOURNAL_SIZE) {
+      // Keep the original color, only compared on flush()
+      _journal.push_back({ index, _buffer[index] });
+      bitSet(_touched[index >> 3], index & 7);
+    } else {
+      // Journal is full, mark the pixel as changed right away
+      markChanged(index % WIDTH, index / WIDTH);
+    }
+  }
+  _buffer[index] = color;
+}
+
+void AdaGFX_ShadowBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t j = y; j < y + h; ++j) {
+    for (int16_t i = x; i < x + w; ++i) {
+      drawPixel(i, j, color);
+    }
+  }
+}
+
+void AdaGFX_ShadowBuffer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void AdaGFX_ShadowBuffer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void AdaGFX_ShadowBuffer::fillScreen(uint16_t color) {
+  _tft->fillScreen(color);
+
+  if (nullptr == _buffer) { return; }
+
+  // Buffer is the same as the display now
+  std::fill(_buffer, _buffer + static_cast<uint32_t>(WIDTH) * HEIGHT, color);
+
+  for (const JournalEntry& entry : _journal) {
+    bitClear(_touched[entry.index >> 3], entry.index & 7);
+  }
+  _journal.clear();
+  clearChanges();
+}
+
+void AdaGFX_ShadowBuffer::invalidate() {
+  std::fill(_rowMin.begin(), _rowMin.end(), 0);
+  std::fill(_rowMax.begin(), _rowMax.end(), WIDTH - 1);
+}
+
+/****************************************************************************
+ * flush: Send the changed areas to the display
+ ***************************************************************************/
+void AdaGFX_ShadowBuffer::flush() {
+  if (nullptr == _buffer) { return; }
+
+  // Only pixels that have a different color than before are changed
+  for (const JournalEntry& entry : _journal) {
+    if (_buffer[entry.index] != entry.color) {
+      markChanged(entry.index % WIDTH, entry.index / WIDTH);
+    }
+    bitClear(_touched[entry.index >> 3], entry.index & 7);
+  }
+  _journal.clear();
+
+  // Combine changed rows into rectangles
+  int16_t top   = -1;
+  int16_t left  = 0;
+  int16_t right = 0;
+
+  for (int16_t py = 0; py < HEIGHT; ++py) {
+    const bool changed = _rowMin[py] <= _rowMax[py];
+
+    if ((top >= 0) && changed &&
+        (_rowMin[py] <= right + ADAGFX_SHADOW_MERGE_GAP) &&
+        (_rowMax[py] + ADAGFX_SHADOW_MERGE_GAP >= left)) {
+      left  = std::min(left, _rowMin[py]);
+      right = std::max(right, _rowMax[py]);
+      continue;
+    }
+
+    if (top >= 0) {
+      flushArea(left, top, right, py - 1);
+      top = -1;
+    }
+
+    if (changed) {
+      top   = py;
+      left  = _rowMin[py];
+      right = _rowMax[py];
+    }
+  }
+
+  if (top >= 0) {
+    flushArea(left, top, right, HEIGHT - 1);
+  }
+  clearChanges();
+}
+
+/****************************************************************************
+ * flushArea: Send a rectangle, in rotation 0 coordinates, to the display
+ * The display uses the same rotation as the buffer, so the window is set in
+ * current rotation coordinates and the pixels are read in that order.
+ ***************************************************************************/
+void AdaGFX_ShadowBuffer::flushArea(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+  int16_t x1, y1, x2, y2;
+
+  switch (rotation) { // Inverse of getBufferIndex()
+    case 1:
+      x1 = top;
+      x2 = bottom;
+      y1 = WIDTH - 1 - right;
+      y2 = WIDTH - 1 - left;
+      break;
+    case 2:
+      x1 = WIDTH - 1 - right;
+      x2 = WIDTH - 1 - left;
+      y1 = HEIGHT - 1 - bottom;
+      y2 = HEIGHT - 1 - top;
+      break;
+    case 3:
+      x1 = HEIGHT - 1 - bottom;
+      x2 = HEIGHT - 1 - top;
+      y1 = left;
+      y2 = right;
+      break;
+    default:
+      x1 = left;
+      x2 = right;
+      y1 = top;
+      y2 = bottom;
+      break;
+  }
+  const uint16_t w = x2 - x1 + 1;
+  const uint16_t h = y2 - y1 + 1;
+  uint16_t line[32];
+
+  _tft->startWrite();
+  _tft->setAddrWindow(x1, y1, w, h);
+
+  for (int16_t y = y1; y <= y2; ++y) {
+    uint8_t count = 0;
+
+    for (int16_t x = x1; x <= x2; ++x) {
+      line[count++] = _buffer[getBufferIndex(x, y)];
+
+      if (count == NR_ELEMENTS(line)) {
+        _tft->writePixels(line, count, true);
+        count = 0;
+      }
+    }
+
+    if (count > 0) {
+      _tft->writePixels(line, count, true);
+    }
+  }
+  _tft->endWrite();
+
+  _flushedPixels += static_cast<uint32_t>(w) * h;
+  ++_flushedAreas;
+}
+
+#endif // if defined(PLUGIN_USES_ADAFRUITGFX) && ADAGFX_ENABLE_SHADOW_BUFFER
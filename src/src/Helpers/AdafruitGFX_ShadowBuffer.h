@@ -0,0 +1,111 @@
+#ifndef HELPERS_ADAFRUITGFX_SHADOWBUFFER_H
+#define HELPERS_ADAFRUITGFX_SHADOWBUFFER_H
+
+#include "../Helpers/AdafruitGFX_helper.h"
+
+#if defined(PLUGIN_USES_ADAFRUITGFX) && ADAGFX_ENABLE_SHADOW_BUFFER
+
+# include <vector>
+
+# ifndef ADAGFX_SHADOW_JOURNAL_SIZE
+#  define ADAGFX_SHADOW_JOURNAL_SIZE  2048 // Max. nr of changed pixels to keep the original color of, 8 bytes per pixel
+# endif // ifndef ADAGFX_SHADOW_JOURNAL_SIZE
+# ifndef ADAGFX_SHADOW_MERGE_GAP
+#  define ADAGFX_SHADOW_MERGE_GAP     16   // Max. nr of unchanged pixels between 2 rows to combine them in a single area
+# endif // ifndef ADAGFX_SHADOW_MERGE_GAP
+# ifndef ADAGFX_SHADOW_MIN_FREE_MEM
+#  define ADAGFX_SHADOW_MIN_FREE_MEM  20000 // Don't use a shadow buffer when less free memory would be left
+# endif // ifndef ADAGFX_SHADOW_MIN_FREE_MEM
+
+/****************************************************************************
+ * AdaGFX_ShadowBuffer: Keep a copy of the display content in RAM (in PSRAM if available)
+ *
+ * All drawing is done in the shadow buffer first. flush() only sends the areas
+ * where pixels got a different color to the display, using windowed writePixels().
+ * When a pixel is changed for the first time since the last flush(), its original color
+ * is kept, so a pixel that is cleared and then drawn again with the same color
+ * (like unchanged digits in a txtfull command) is not sent to the display.
+ * Changed pixels are tracked per row, adjacent rows are combined into rectangles.
+ *
+ * The buffer is stored in display orientation (rotation 0), so rotating the display
+ * does not invalidate the content.
+ * fillScreen() is passed on to the display directly, as that is faster than sending pixels.
+ ***************************************************************************/
+class AdaGFX_ShadowBuffer : public Adafruit_GFX {
+public:
+
+  explicit AdaGFX_ShadowBuffer(Adafruit_SPITFT *tft);
+  virtual ~AdaGFX_ShadowBuffer();
+
+  AdaGFX_ShadowBuffer(const AdaGFX_ShadowBuffer& other)            = delete;
+  AdaGFX_ShadowBuffer& operator=(const AdaGFX_ShadowBuffer& other) = delete;
+
+  bool isAllocated() const {
+    return nullptr != _buffer;
+  }
+
+  void drawPixel(int16_t  x,
+                 int16_t  y,
+                 uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  void fillRect(int16_t  x,
+                int16_t  y,
+                int16_t  w,
+                int16_t  h,
+                uint16_t color) override;
+  void drawFastHLine(int16_t  x,
+                     int16_t  y,
+                     int16_t  w,
+                     uint16_t color) override;
+  void drawFastVLine(int16_t  x,
+                     int16_t  y,
+                     int16_t  h,
+                     uint16_t color) override;
+
+  // Send all changed areas to the display
+  void flush();
+
+  // Send the complete buffer to the display on the next flush()
+  void invalidate();
+
+  uint32_t getFlushedPixels() const {
+    return _flushedPixels;
+  }
+
+  uint32_t getFlushedAreas() const {
+    return _flushedAreas;
+  }
+
+private:
+
+  struct JournalEntry {
+    uint32_t index;
+    uint16_t color;
+  };
+
+  uint32_t getBufferIndex(int16_t x,
+                          int16_t y) const;
+
+  void     markChanged(uint16_t px,
+                       uint16_t py);
+
+  void     clearChanges();
+
+  void     flushArea(uint16_t left,
+                     uint16_t top,
+                     uint16_t right,
+                     uint16_t bottom);
+
+  Adafruit_SPITFT          *_tft     = nullptr;
+  uint16_t                 *_buffer  = nullptr; // Pixels in rotation 0 layout
+  uint8_t                  *_touched = nullptr; // 1 bit per pixel: original color is in _journal
+  std::vector<int16_t>      _rowMin;            // Changed pixels per row, _rowMin > _rowMax: unchanged
+  std::vector<int16_t>      _rowMax;
+  std::vector<JournalEntry> _journal;
+  uint32_t                  _flushedPixels = 0;
+  uint32_t                  _flushedAreas  = 0;
+};
+
+#endif // if defined(PLUGIN_USES_ADAFRUITGFX) && ADAGFX_ENABLE_SHADOW_BUFFER
+
+#endif // ifndef HELPERS_ADAFRUITGFX_SHADOWBUFFER_H
@@ -3,6 +3,7 @@
 
 #ifdef PLUGIN_USES_ADAFRUITGFX
 
+# include "../Helpers/AdafruitGFX_ShadowBuffer.h"
 # include "../Helpers/StringConverter.h"
 # include "../Helpers/StringGenerator_Web.h"
 # include "../WebServer/Markup_Forms.h"
@@ -302,6 +303,21 @@ void AdaGFXFormTextColRowMode(const __FlashStringHelper *id,
   # endif // ifndef LIMIT_BUILD_SIZE
 }
 
+# if ADAGFX_ENABLE_SHADOW_BUFFER
+
+/*****************************************************************************************
+ * Show a checkbox & note to enable the shadow buffer
+ ****************************************************************************************/
+void AdaGFXFormShadowBuffer(const __FlashStringHelper *id,
+                            bool                       selectedState) {
+  addFormCheckBox(F("Only update changed areas"), id, selectedState);
+  #  ifndef LIMIT_BUILD_SIZE
+  addFormNote(F("Uses a copy of the display content in RAM, PSRAM recommended."));
+  #  endif // ifndef LIMIT_BUILD_SIZE
+}
+
+# endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
 /*****************************************************************************************
  * Show a checkbox & note to enable -1 px compatibility mode for txp and txtfull subcommands
  ****************************************************************************************/
@@ -666,6 +682,66 @@ AdafruitGFX_helper::AdafruitGFX_helper(Adafruit_SPITFT           *display,
 
 # endif // if ADAGFX_ENABLE_BMP_DISPLAY
 
+AdafruitGFX_helper::~AdafruitGFX_helper() {
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+  delete _shadow;
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+}
+
+# if ADAGFX_ENABLE_SHADOW_BUFFER
+
+/****************************************************************************
+ * setShadowBuffer: Draw via a copy of the display content in RAM,
+ * flush() then only sends the changed areas to the display
+ ***************************************************************************/
+bool AdafruitGFX_helper::setShadowBuffer(bool enable) {
+  if (enable == (nullptr != _shadow)) { return true; }
+
+  if (!enable) {
+    _display = _tft;
+    delete _shadow;
+    _shadow = nullptr;
+    return true;
+  }
+
+  if ((nullptr == _tft) || (_colorDepth != AdaGFXColorDepth::FullColor)) { return false; }
+
+  _shadow = new (std::nothrow) AdaGFX_ShadowBuffer(_tft);
+
+  if ((nullptr != _shadow) && !_shadow->isAllocated()) {
+    delete _shadow;
+    _shadow = nullptr;
+  }
+
+  if (nullptr == _shadow) {
+    addLog(LOG_LEVEL_ERROR, F("AdaGFX: Not enough memory for shadow buffer"));
+    return false;
+  }
+  _display = _shadow;
+  return true;
+}
+
+# endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
+/****************************************************************************
+ * fillScreen: Fill the screen, also updates the shadow buffer if used
+ ***************************************************************************/
+void AdafruitGFX_helper::fillScreen(uint16_t color) {
+  _display->fillScreen(color);
+}
+
+/****************************************************************************
+ * flush: Send the changed areas of the shadow buffer to the display
+ ***************************************************************************/
+void AdafruitGFX_helper::flush() {
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+
+  if (nullptr != _shadow) {
+    _shadow->flush();
+  }
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+}
+
 /****************************************************************************
  * common initialization, called from constructors
  ***************************************************************************/
@@ -724,6 +800,13 @@ String AdafruitGFX_helper::getFeatures() {
                  # endif // if (defined(ADAGFX_ENABLE_GET_CONFIG_VALUE) && ADAGFX_ENABLE_GET_CONFIG_VALUE)
                  );
 
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+
+  if (nullptr != _shadow) {
+    log += F(" shadow");
+  }
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
   if (log.endsWith(F(","))) {
     log.remove(log.length() - 1);
   }
@@ -786,6 +869,12 @@ void AdafruitGFX_helper::setTxtfullCompensation(uint8_t compensation) {
 void AdafruitGFX_helper::invertDisplay(bool i) {
   _displayInverted = i;
   _display->invertDisplay(_displayInverted);
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+
+  if (nullptr != _shadow) {
+    _tft->invertDisplay(_displayInverted);
+  }
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
 }
 
 /****************************************************************************
@@ -2228,6 +2317,7 @@ bool AdafruitGFX_helper::processCommand(const String& string) {
       break;
       # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
   }
+  flush();
   return success;
 }
 
@@ -2547,6 +2637,7 @@ void AdafruitGFX_helper::printText(const char     *string,
 
   _display->setCursor(_x + oLeft, _y); // add left offset to center, _y may be updated
   _display->print(newString);
+  flush();
 }
 
 /****************************************************************************
@@ -2991,6 +3082,68 @@ uint16_t AdaGFXrgb888ToRgb565(uint32_t rgb888) {
   return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
 
+# if ADAGFX_ENABLE_BMP_DISPLAY
+
+/****************************************************************************
+ * Convert count BGR888 pixels (.bmp 24 bit format) in buffer to rgb565, in place
+ * 4 pixels are handled per 3 words read, the buffer must be word aligned
+ ***************************************************************************/
+void AdaGFXbgr888ToRgb565(uint32_t *buffer,
+                          uint16_t  count) {
+  uint32_t *dst = buffer;
+  uint16_t  i   = 0;
+
+  // Little endian: w0 = b0 g0 r0 b1, w1 = g1 r1 b2 g2, w2 = r2 b3 g3 r3
+  for (; i + 4 <= count; i += 4) {
+    const uint32_t w0 = buffer[0];
+    const uint32_t w1 = buffer[1];
+    const uint32_t w2 = buffer[2];
+    buffer += 3;
+
+    const uint32_t p0 = ((w0 >> 8) & 0xF800) | ((w0 >> 5) & 0x07E0) | ((w0 >> 3) & 0x001F);
+    const uint32_t p1 = (w1 & 0xF800) | ((w1 << 3) & 0x07E0) | (w0 >> 27);
+    const uint32_t p2 = ((w2 << 8) & 0xF800) | ((w1 >> 21) & 0x07E0) | ((w1 >> 19) & 0x001F);
+    const uint32_t p3 = ((w2 >> 16) & 0xF800) | ((w2 >> 13) & 0x07E0) | ((w2 >> 11) & 0x001F);
+
+    dst[0] = p0 | (p1 << 16);
+    dst[1] = p2 | (p3 << 16);
+    dst   += 2;
+  }
+
+  // Remaining 1..3 pixels
+  const uint8_t *src  = reinterpret_cast<const uint8_t *>(buffer);
+  uint16_t      *dest = reinterpret_cast<uint16_t *>(dst);
+
+  for (; i < count; ++i, src += 3) {
+    *dest++ = ((src[2] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[0] >> 3);
+  }
+}
+
+/****************************************************************************
+ * Convert count 1 bit pixels (.bmp 1 bit format, msb first) to rgb565 using palette,
+ * starting at bit firstBit (0 = msb) of the first byte
+ ***************************************************************************/
+void AdaGFXmono1ToRgb565(const uint8_t *bits,
+                         uint8_t        firstBit,
+                         uint16_t      *dest,
+                         uint16_t       count,
+                         const uint16_t palette[2]) {
+  uint8_t value = *bits++ << firstBit;
+  uint8_t left  = 8 - firstBit;
+
+  for (uint16_t i = 0; i < count; ++i) {
+    if (0 == left) {
+      value = *bits++;
+      left  = 8;
+    }
+    *dest++ = palette[value >> 7];
+    value <<= 1;
+    --left;
+  }
+}
+
+# endif // if ADAGFX_ENABLE_BMP_DISPLAY
+
 /****************************************************************************
  * getTextMetrics: Returns the metrics related to current font
  ***************************************************************************/
@@ -3110,6 +3263,12 @@ void AdafruitGFX_helper::setRotation(uint8_t m) {
 
   _display->setRotation(m); // Set rotation 0/1/2/3
   _rotation = rotation;
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+
+  if (nullptr != _shadow) {
+    _tft->setRotation(m); // Display must use the same rotation as the shadow buffer
+  }
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
 
   switch (rotation) {
     case 0:
@@ -3168,6 +3327,8 @@ void AdafruitGFX_helper::setRotation(uint8_t m) {
  * - No 'load to memory' feature
  * - No special handling of SD Filesystem/FAT, but File only
  * - Adds support for non-SPI displays (like NeoPixel Matrix, and possibly I2C displays, once supported)
+ * - Reads (a part of) a scanline at once, and converts it to rgb565 in place,
+ *   the scanline is written to the display using a single writePixels() call
  ***************************************************************************/
 bool AdafruitGFX_helper::showBmp(const String& filename,
                                  int16_t       x,
@@ -3177,41 +3338,32 @@ bool AdafruitGFX_helper::showBmp(const String& filename,
   uint32_t compression = 0;      // BMP compression mode
   uint32_t colors      = 0;      // Number of colors in palette
   uint32_t rowSize;              // >bmpWidth if scanline padding
-  uint8_t  sdbuf[3 * BUFPIXELS]; // BMP read buf (R+G+B/pixel)
-
-  uint32_t destidx = 0;
-  uint32_t bmpPos  = 0;          // Next pixel position in file
+  uint32_t bmpPos = 0;           // Next pixel position in file
   int bmpWidth;                  // BMP width & height in pixels
   int bmpHeight;
   int loadWidth;
   int loadHeight;                // Region being loaded (clipped)
   int loadX;
   int loadY;                     // "
-  int row;                       // Current pixel pos.
-  int col;
-  uint16_t *quantized = NULL;    // 16-bit 5/6/5 color palette
-  uint16_t  tftbuf[BUFPIXELS];
-  uint16_t *dest = tftbuf;       // TFT working buffer, or NULL if to canvas
-  int16_t   drow = 0;
-  int16_t   dcol = 0;
+  uint16_t palette[2]  = { 0 };  // 16-bit 5/6/5 color palette for 1-bit bitmaps
+  uint32_t *rowBuffer  = nullptr;
+  uint16_t  rowPixels  = 0;      // Max. nr of pixels per read
   uint8_t   planes;              // BMP planes
   uint8_t   depth;               // BMP bit depth
-  uint8_t   r;                   // Current pixel colors
-  uint8_t   g;
-  uint8_t   b;
-  uint8_t   bitIn = 0;           // Bit number for 1-bit data in
-
-  #  if ((3 * BUFPIXELS) <= 255)
-  uint8_t srcidx = sizeof sdbuf; // Current position in sdbuf
-  #  else // if ((3 * BUFPIXELS) <= 255)
-  uint16_t srcidx = sizeof sdbuf;
-  #  endif // if ((3 * BUFPIXELS) <= 255)
-  bool flip     = true;  // BMP is stored bottom-to-top
-  bool transact = true;  // Enable transaction support to work proper with SD czrd, when enabled
-  bool status   = false; // IMAGE_SUCCESS on valid file
+  bool flip      = true;         // BMP is stored bottom-to-top
+  bool supported = false;        // Only uncompressed 24 or 1 bit bitmaps
+  bool transact  = true;         // Enable transaction support to work proper with SD czrd, when enabled
+  bool status    = false;        // IMAGE_SUCCESS on valid file
 
   bool canTransact = (nullptr != _tft);
 
+  #  if ADAGFX_ENABLE_SHADOW_BUFFER
+
+  if (nullptr != _shadow) {
+    canTransact = false; // Draw into the shadow buffer
+  }
+  #  endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
   // If BMP is being drawn off the right or bottom edge of the screen,
   // nothing to do here. NOT an error, just a trivial clip operation.
   if (_tft && ((x >= _tft->width()) || (y >= _tft->height()))) {
@@ -3311,169 +3463,110 @@ bool AdafruitGFX_helper::showBmp(const String& filename,
       rowSize = ((depth * bmpWidth + 31) / 32) * 4;
 
       if ((depth == 24) || (depth == 1)) { // BGR or 1-bit bitmap format
-        // if (dest) {                     // Supported format, alloc OK, etc.
-        status = true;
+        supported = true;
+        status    = true;
 
         if ((loadWidth > 0) && (loadHeight > 0)) { // Clip top/left
-          _display->startWrite();                  // Start SPI (regardless of transact)
+          rowPixels = std::min(loadWidth, ADAGFX_BMP_ROW_PIXELS);
 
-          if (canTransact) {
-            _tft->setAddrWindow(x, y, loadWidth, loadHeight);
-          }
+          // 3 bytes per pixel, converted in place to rgb565,
+          // for 1-bit bitmaps the data is read behind the converted pixels
+          rowBuffer = static_cast<uint32_t *>(malloc(((rowPixels * 3 + 7) / 4) * sizeof(uint32_t)));
 
-          if ((depth >= 16) ||
-              (quantized = (uint16_t *)malloc(colors * sizeof(uint16_t)))) {
-            if (depth < 16) {
-              // Load and quantize color table
-              for (uint16_t c = 0; c < colors; ++c) {
-                b = file.read();
-                g = file.read();
-                r = file.read();
-                (void)file.read(); // Ignore 4th byte
-                quantized[c] =     // -V522
-                               ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-              }
-            }
+          if (nullptr == rowBuffer) {
+            addLog(LOG_LEVEL_ERROR, F("showBmp: Not enough memory"));
+            status = false;
+          }
+        }
 
-            for (row = 0; row < loadHeight; ++row) { // For each scanline...
-              delay(0);                              // Keep ESP8266 happy
-
-              // Seek to start of scan line.  It might seem labor-intensive
-              // to be doing this on every line, but this method covers a
-              // lot of gritty details like cropping, flip and scanline
-              // padding. Also, the seek only takes place if the file
-              // position actually needs to change (avoids a lot of cluster
-              // math in SD library).
-              if (flip) { // Bitmap is stored bottom-to-top order (normal BMP)
-                bmpPos = offset + (bmpHeight - 1 - (row + loadY)) * rowSize;
-              } else {    // Bitmap is stored top-to-bottom
-                bmpPos = offset + (row + loadY) * rowSize;
-              }
+        if (status && (loadWidth > 0) && (loadHeight > 0)) {
+          uint16_t *dest = reinterpret_cast<uint16_t *>(rowBuffer);
+          uint8_t  *bits = reinterpret_cast<uint8_t *>(rowBuffer) + rowPixels * 2;
 
-              if (depth == 24) {
-                bmpPos += loadX * 3;
-              } else {
-                bmpPos += loadX / 8;
-                bitIn   = 7 - (loadX & 7);
-              }
+          if (depth == 1) {
+            // Load and quantize color table, only the 2 colors used
+            for (uint32_t c = 0; c < colors; ++c) {
+              const uint8_t b = file.read();
+              const uint8_t g = file.read();
+              const uint8_t r = file.read();
+              (void)file.read(); // Ignore 4th byte
 
-              constexpr size_t errorcode = (size_t)-1;
-              size_t pos = file.position();
-              if (pos == errorcode) {
-                pos = 0;
+              if (c < NR_ELEMENTS(palette)) {
+                palette[c] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
               }
+            }
+          }
 
-              if (pos != bmpPos) {        // Need seek?
-                if (transact && canTransact) {
-                  _tft->dmaWait();
-                  _tft->endWrite();                   // End TFT SPI transaction
-                }
-                file.seek(bmpPos);                    // Seek = SD transaction
-                srcidx = sizeof sdbuf;                // Force buffer reload
-              }
-
-              for (col = 0; col < loadWidth; ++col) { // For each pixel...
-                if (srcidx >= sizeof sdbuf) {         // Time to load more?
-                  if (transact && canTransact) {
-                    _tft->dmaWait();
-                    _tft->endWrite();                 // End TFT SPI transact
-                  }
-                  file.read(sdbuf, sizeof sdbuf);     // Load from SD
-
-                  if (transact && canTransact) {
-                    _display->startWrite();           // Start TFT SPI transact
-                  }
+          _display->startWrite();                  // Start SPI (regardless of transact)
 
-                  if (destidx) {                      // If buffered TFT data
-                    // Non-blocking writes (DMA) have been temporarily
-                    // disabled until this can be rewritten with two
-                    // alternating 'dest' buffers (else the nonblocking
-                    // data out is overwritten in the dest[] write below).
-                    // tft->writePixels(dest, destidx, false); // Write it
-                    delay(0);
-
-                    if (canTransact) {
-                      _tft->writePixels(dest, destidx, true); // Write it
-                    } else {
-                      // loop over buffer
-
-                      for (uint16_t p = 0; p < destidx; ++p) {
-                        _display->drawPixel(x + p, y + drow, dest[p]);
-                      }
-                    }
+          if (canTransact) {
+            _tft->setAddrWindow(x, y, loadWidth, loadHeight);
+          }
 
-                    if (col % 33 == 0) { delay(0); }
-                    destidx = 0; // and reset dest index
-                  }
+          for (int row = 0; row < loadHeight; ++row) { // For each scanline...
+            delay(0);                                  // Keep ESP8266 happy
 
-                  srcidx = 0;    // Reset bmp buf index
-                }
+            if (flip) { // Bitmap is stored bottom-to-top order (normal BMP)
+              bmpPos = offset + (bmpHeight - 1 - (row + loadY)) * rowSize;
+            } else {    // Bitmap is stored top-to-bottom
+              bmpPos = offset + (row + loadY) * rowSize;
+            }
 
-                if (depth == 24) {
-                  // Convert each pixel from BMP to 565 format, save in dest
-                  b               = sdbuf[srcidx++];
-                  g               = sdbuf[srcidx++]; // -V557
-                  r               = sdbuf[srcidx++]; // -V557
-                  dest[destidx++] =
-                    ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-                } else {
-                  // Extract 1-bit color index
-                  uint8_t n = (sdbuf[srcidx] >> bitIn) & 1;
-
-                  if (!bitIn) {
-                    srcidx++;
-                    bitIn = 7;
-                  } else {
-                    bitIn--;
-                  }
+            for (int col = 0; col < loadWidth; col += rowPixels) { // For each part of the scanline
+              const uint16_t count = std::min(loadWidth - col, static_cast<int>(rowPixels));
+              const int      srcX  = loadX + col;
 
-                  // Look up in palette, store in tft dest buf
-                  dest[destidx++] = quantized[n];
-                }
-                dcol++;
-              }                                           // end pixel loop
+              if (transact && canTransact) {
+                _tft->dmaWait();
+                _tft->endWrite(); // End TFT SPI transaction
+              }
 
-              if (_tft) {                                 // Drawing to TFT?
-                delay(0);
+              // Read the pixels, only seek if the file position has to change
+              if (depth == 24) {
+                const uint32_t pos = bmpPos + srcX * 3;
 
-                if (destidx) {                            // Any remainders?
-                  // See notes above re: DMA
-                  _tft->writePixels(dest, destidx, true); // Write it
-                  destidx = 0;                            // and reset dest index
+                if (file.position() != pos) {
+                  file.seek(pos);
                 }
-                _tft->dmaWait();
-                _tft->endWrite();                         // update display
+                file.read(reinterpret_cast<uint8_t *>(rowBuffer), count * 3);
+                AdaGFXbgr888ToRgb565(rowBuffer, count);
               } else {
-                // loop over buffer
-                if (destidx) {
-                  for (uint16_t p = 0; p < destidx; ++p) {
-                    _display->drawPixel(x + p, y + drow, dest[p]);
+                const uint32_t pos = bmpPos + srcX / 8;
 
-                    if (p % 100 == 0) { delay(0); }
-                  }
-                  destidx = 0; // and reset dest index
+                if (file.position() != pos) {
+                  file.seek(pos);
                 }
+                file.read(bits, ((srcX & 7) + count + 7) / 8);
+                AdaGFXmono1ToRgb565(bits, srcX & 7, dest, count, palette);
               }
 
-              drow++;
-              dcol = 0;
-            }                  // end scanline loop
+              if (transact && canTransact) {
+                _display->startWrite(); // Start TFT SPI transaction
+              }
 
-            if (quantized) {
-              free(quantized); // Palette no longer needed
-            }
-            delay(0);
-          }                    // end depth>24 or quantized malloc OK
-        }                      // end top/left clip
-        // }                         // end malloc check
-      }                        // end depth check
+              if (canTransact) {
+                _tft->writePixels(dest, count, true);
+              } else {
+                _display->drawRGBBitmap(x + col, y + row, dest, count, 1);
+              }
+            } // end scanline loop
+          }   // end row loop
+
+          if (canTransact) {
+            _tft->dmaWait();
+          }
+          _display->endWrite(); // update display
+          delay(0);
+        }                       // end top/left clip
+        free(rowBuffer);
+      }                         // end depth check
     } // end planes/compression check
 
     if (status) {
     #  ifndef BUILD_NO_DEBUG
       addLog(LOG_LEVEL_INFO, F("showBmp: Done."));
     #  endif // ifndef BUILD_NO_DEBUG
-    } else {
+    } else if (!supported) {
       addLog(LOG_LEVEL_ERROR, F("showBmp: Only uncompressed and 24 or 1 bit color-depth supported."));
     }
   } else { // end signature
@@ -3482,8 +3575,6 @@ bool AdafruitGFX_helper::showBmp(const String& filename,
 
   file.close();
   return status; // -V680
-
-  // }
 }
 
 /*!
@@ -70,7 +70,9 @@
 # include <vector>
 
 // Used for bmp support
-# define BUFPIXELS 200                  ///< 200 * 5 = 1000 bytes
+# ifndef ADAGFX_BMP_ROW_PIXELS
+#  define ADAGFX_BMP_ROW_PIXELS 320      // Max. nr of pixels of a scanline read at once, 320 * 3 = 960 bytes
+# endif // ifndef ADAGFX_BMP_ROW_PIXELS
 
 # define ADAGFX_PARSE_MAX_ARGS        7 // Maximum number of arguments needed and supported (corrected)
 # ifndef ADAGFX_ARGUMENT_VALIDATION
@@ -111,6 +113,13 @@
 # ifndef ADAGFX_ENABLE_GET_CONFIG_VALUE
 #  define ADAGFX_ENABLE_GET_CONFIG_VALUE  1 // Enable getting values features
 # endif // ifndef ADAGFX_ENABLE_GET_CONFIG_VALUE
+# ifndef ADAGFX_ENABLE_SHADOW_BUFFER
+#  ifdef ESP32
+#   define ADAGFX_ENABLE_SHADOW_BUFFER    1 // Enable drawing via a shadow buffer, only sending changed areas to the display
+#  else // ifdef ESP32
+#   define ADAGFX_ENABLE_SHADOW_BUFFER    0 // Needs too much RAM for ESP8266
+#  endif // ifdef ESP32
+# endif // ifndef ADAGFX_ENABLE_SHADOW_BUFFER
 
 # define ADAGFX_FONTS_EXTRA_5PT_INCLUDED    // 1 extra 5pt font, should only be enabled in non-LIMIT_BUILD_SIZE builds, adds ~0.3 kB
 // # define ADAGFX_FONTS_EXTRA_8PT_INCLUDED  // 8 extra 8pt fonts, should probably only be enabled in a private custom build, adds ~15.4 kB
@@ -207,8 +216,17 @@
 #   undef ADAGFX_ENABLE_BUTTON_SLIDER
 #   define ADAGFX_ENABLE_BUTTON_SLIDER  0 // Disable displaying button-shape with slider-actions
 #  endif // if ADAGFX_ENABLE_BUTTON_SLIDER
+#  if ADAGFX_ENABLE_SHADOW_BUFFER
+#   undef ADAGFX_ENABLE_SHADOW_BUFFER
+#   define ADAGFX_ENABLE_SHADOW_BUFFER  0
+#  endif // if ADAGFX_ENABLE_SHADOW_BUFFER
 # endif  // ifdef LIMIT_BUILD_SIZE
 
+# if ADAGFX_ENABLE_SHADOW_BUFFER && !ADAGFX_ENABLE_BMP_DISPLAY // Needs the Adafruit_SPITFT constructor
+#  undef ADAGFX_ENABLE_SHADOW_BUFFER
+#  define ADAGFX_ENABLE_SHADOW_BUFFER   0
+# endif // if ADAGFX_ENABLE_SHADOW_BUFFER && !ADAGFX_ENABLE_BMP_DISPLAY
+
 # ifdef PLUGIN_SET_MAX // Include all fonts in MAX builds
 #  ifndef ADAGFX_FONTS_EXTRA_5PT_INCLUDED
 #   define ADAGFX_FONTS_EXTRA_5PT_INCLUDED
@@ -389,6 +407,9 @@ struct tWindowObject {
 # endif // if ADAGFX_ENABLE_FRAMED_WINDOW
 
 class AdafruitGFX_helper; // Forward declaration
+# if ADAGFX_ENABLE_SHADOW_BUFFER
+class AdaGFX_ShadowBuffer; // Forward declaration
+# endif // if ADAGFX_ENABLE_SHADOW_BUFFER
 
 // Some generic AdafruitGFX_helper support functions
 const __FlashStringHelper* toString(const AdaGFXTextPrintMode& mode);
@@ -443,6 +464,15 @@ uint16_t AdaGFXrgb565ToColor7(const uint16_t& color); // Convert rgb565 color to
 uint32_t AdaGFXrgb565ToRgb888(uint16_t rgb565);
 String   AdaGFXrgb565ToWebColor(uint16_t rgb565);
 uint16_t AdaGFXrgb888ToRgb565(uint32_t rgb888);
+# if ADAGFX_ENABLE_BMP_DISPLAY
+void     AdaGFXbgr888ToRgb565(uint32_t *buffer,
+                              uint16_t  count); // In place, buffer must be word aligned
+void     AdaGFXmono1ToRgb565(const uint8_t *bits,
+                             uint8_t        firstBit,
+                             uint16_t      *dest,
+                             uint16_t       count,
+                             const uint16_t palette[2]);
+# endif // if ADAGFX_ENABLE_BMP_DISPLAY
 
 void     AdaGFXFormLineSpacing(const __FlashStringHelper *id,
                                uint8_t                    selectedIndex);
@@ -451,6 +481,10 @@ String   AdaGFXgetFontName(uint8_t fontId,
 uint32_t AdaGFXgetFontIndexForFontId(uint8_t fontId);
 void     AdaGFXFormDefaultFont(const __FlashStringHelper *id,
                                uint8_t                    selectedIndex);
+# if ADAGFX_ENABLE_SHADOW_BUFFER
+void     AdaGFXFormShadowBuffer(const __FlashStringHelper *id,
+                                bool                       selectedState);
+# endif // if ADAGFX_ENABLE_SHADOW_BUFFER
 
 class AdafruitGFX_helper {
 public:
@@ -481,7 +515,7 @@ public:
                      const bool                 textBackFill  = false,
                      const uint8_t              defaultFontId = 0);
   # endif // if ADAGFX_ENABLE_BMP_DISPLAY
-  virtual ~AdafruitGFX_helper() {}
+  virtual ~AdafruitGFX_helper();
 
   String getFeatures();
 
@@ -575,6 +609,17 @@ public:
   void invertDisplay(bool i);
   void initialize();
 
+  void fillScreen(uint16_t color); // Fill the screen, also updates the shadow buffer if used
+  void flush();                    // Send pending changes to the display, only needed when using a shadow buffer
+
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+  bool setShadowBuffer(bool enable); // Draw via a shadow buffer, only for Adafruit_SPITFT displays, call before initialize()
+  bool hasShadowBuffer() const {
+    return nullptr != _shadow;
+  }
+
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
+
 private:
 
   # if ADAGFX_ARGUMENT_VALIDATION
@@ -594,6 +639,9 @@ private:
 
   Adafruit_GFX *_display = nullptr;
   Adafruit_SPITFT *_tft = nullptr;
+  # if ADAGFX_ENABLE_SHADOW_BUFFER
+  AdaGFX_ShadowBuffer *_shadow = nullptr; // When used, _display points to this
+  # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
   String _trigger;
   uint16_t _res_x;
   uint16_t _res_y;
@@ -0,0 +1,88 @@
+#include "../Helpers/ByteRingBuffer.h"
+
+ByteRingBuffer::~ByteRingBuffer()
+{
+  release();
+}
+
+bool ByteRingBuffer::allocate(size_t size)
+{
+  release();
+
+  if (size == 0) { return false; }
+  _buffer = new (std::nothrow) uint8_t[size];
+
+  if (_buffer == nullptr) { return false; }
+  _size = size;
+  return true;
+}
+
+void ByteRingBuffer::release()
+{
+  delete[] _buffer;
+  _buffer = nullptr;
+  _size   = 0;
+  clear();
+}
+
+void ByteRingBuffer::clear()
+{
+  _head  = 0;
+  _count = 0;
+}
+
+size_t ByteRingBuffer::write(const uint8_t *data, size_t length)
+{
+  if (length > room()) { length = room(); }
+  size_t res = 0;
+
+  while (res < length) {
+    size_t block = contiguousRoom();
+
+    if (block > (length - res)) { block = length - res; }
+    memcpy(_buffer + writePos(), data + res, block);
+    _count += block;
+    res    += block;
+  }
+  return res;
+}
+
+size_t ByteRingBuffer::peek(const uint8_t *& data) const
+{
+  data = _buffer + _head;
+
+  if ((_head + _count) > _size) {
+    // Data wraps around the end of the buffer
+    return _size - _head;
+  }
+  return _count;
+}
+
+void ByteRingBuffer::consume(size_t length)
+{
+  if (length >= _count) {
+    // Start at the beginning again, so the next data is in a single block
+    clear();
+    return;
+  }
+  _head  += length;
+  _count -= length;
+
+  if (_head >= _size) { _head -= _size; }
+}
+
+size_t ByteRingBuffer::writePos() const
+{
+  const size_t pos = _head + _count;
+
+  return (pos >= _size) ? pos - _size : pos;
+}
+
+size_t ByteRingBuffer::contiguousRoom() const
+{
+  if ((_head + _count) >= _size) {
+    // Free space is between the write position and the read position
+    return _size - _count;
+  }
+  return _size - (_head + _count);
+}
@@ -0,0 +1,122 @@
+#ifndef HELPERS_BYTERINGBUFFER_H
+#define HELPERS_BYTERINGBUFFER_H
+
+#include "../../ESPEasy_common.h"
+
+/*********************************************************************************************\
+* ByteRingBuffer: Fixed size FIFO buffer for bytes
+*
+* Data is moved in blocks, to and from streams which support read(buffer, size) and write(buffer, size).
+* The buffer memory is allocated once, so no heap fragmentation while data is passed through.
+\*********************************************************************************************/
+class ByteRingBuffer {
+public:
+
+  ByteRingBuffer() = default;
+  ~ByteRingBuffer();
+
+  ByteRingBuffer(const ByteRingBuffer& other)            = delete;
+  ByteRingBuffer& operator=(const ByteRingBuffer& other) = delete;
+
+  // (Re)allocate the buffer, existing data is discarded.
+  // Returns false when the memory could not be allocated.
+  bool   allocate(size_t size);
+  void   release();
+
+  void   clear();
+
+  size_t capacity() const {
+    return _size;
+  }
+
+  // Nr of bytes stored
+  size_t available() const {
+    return _count;
+  }
+
+  // Nr of bytes that can still be stored
+  size_t room() const {
+    return _size - _count;
+  }
+
+  bool isEmpty() const {
+    return _count == 0;
+  }
+
+  bool isFull() const {
+    return _count == _size;
+  }
+
+  // Store at most length bytes, returns the nr of bytes stored
+  size_t write(const uint8_t *data,
+               size_t         length);
+
+  // Contiguous block of stored data at the read position, returns its length
+  size_t peek(const uint8_t *& data) const;
+
+  // Remove length bytes at the read position
+  void   consume(size_t length);
+
+  // Read at most maxBytes already received bytes from the stream in the free space,
+  // in blocks using read(buffer, size). Returns the nr of bytes stored.
+  template<typename T>
+  size_t readFrom(T    & stream,
+                  size_t maxBytes) {
+    size_t res = 0;
+
+    while (res < maxBytes && !isFull()) {
+      const int streamAvailable = stream.available();
+
+      if (streamAvailable <= 0) { break; }
+      size_t length = contiguousRoom();
+
+      if (length > static_cast<size_t>(streamAvailable)) { length = streamAvailable; }
+
+      if (length > (maxBytes - res)) { length = maxBytes - res; }
+
+      const int bytesRead = stream.read(_buffer + writePos(), length);
+
+      if (bytesRead <= 0) { break; }
+      _count += bytesRead;
+      res    += bytesRead;
+    }
+    return res;
+  }
+
+  // Write at most maxBytes to the output and remove them from the buffer.
+  // Returns the nr of bytes written.
+  template<typename T>
+  size_t writeTo(T    & output,
+                 size_t maxBytes) {
+    size_t res = 0;
+
+    while (res < maxBytes && !isEmpty()) {
+      const uint8_t *data = nullptr;
+      size_t length       = peek(data);
+
+      if (length > (maxBytes - res)) { length = maxBytes - res; }
+
+      const size_t written = output.write(data, length);
+
+      consume(written);
+      res += written;
+
+      if (written < length) { break; }
+    }
+    return res;
+  }
+
+private:
+
+  size_t writePos() const;
+
+  // Free space from the write position up to the end of the buffer or the read position
+  size_t contiguousRoom() const;
+
+  uint8_t *_buffer = nullptr;
+  size_t   _size   = 0;
+  size_t   _head   = 0; // Read position
+  size_t   _count  = 0;
+};
+
+#endif // ifndef HELPERS_BYTERINGBUFFER_H
@@ -106,3 +106,39 @@ bool calc_CRC8(uint8_t MSB, uint8_t LSB, uint8_t CRC)
   }
   return crc == CRC;
 }
+
+uint16_t calc_CRC16_ARC_update(uint16_t crc, uint8_t data)
+{
+  /*
+   * Name           : CRC-16/ARC
+   * Polynomial     : 0x8005, reflected 0xA001
+   * Initialization : 0x0000
+   * Reflect input  : True
+   * Reflect output : True
+   * Final          : XOR 0x0000
+   * Example        : calc_CRC16_ARC("123456789") == 0xBB3D
+   *
+   * Uses a table per nibble, to keep the table small.
+   */
+  constexpr uint16_t nibbleTable[16] = {
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+  };
+
+  crc ^= data;
+  crc  = (crc >> 4) ^ nibbleTable[crc & 0x0F];
+  crc  = (crc >> 4) ^ nibbleTable[crc & 0x0F];
+  return crc;
+}
+
+uint16_t calc_CRC16_ARC(const uint8_t *data, size_t length)
+{
+  uint16_t crc = 0;
+
+  if (data != nullptr) {
+    while (length--) {
+      crc = calc_CRC16_ARC_update(crc, *data++);
+    }
+  }
+  return crc;
+}
@@ -18,5 +18,13 @@ bool          calc_CRC8(uint8_t MSB,
                         uint8_t LSB,
                         uint8_t CRC);
 
+// CRC-16/ARC (poly 0xA001 reflected, init 0), as used by DSMR P1 telegrams.
+// Update the CRC with a single byte, to compute the CRC while receiving data.
+uint16_t      calc_CRC16_ARC_update(uint16_t crc,
+                                    uint8_t  data);
+
+uint16_t      calc_CRC16_ARC(const uint8_t *data,
+                             size_t         length);
+
 
 #endif // ifndef HELPERS_CRC_FUNCTIONS_H
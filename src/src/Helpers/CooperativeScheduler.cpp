@@ -0,0 +1,167 @@
+#include "../Helpers/CooperativeScheduler.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
+
+
+const __FlashStringHelper* toString(CooperativeJob_e job) {
+  switch (job) {
+    case CooperativeJob_e::SystemEventQueue:        return F("system_event_queue");
+    case CooperativeJob_e::RulesEventQueue:         return F("rules_event_queue");
+    case CooperativeJob_e::LogSinks:                return F("log_sinks");
+    case CooperativeJob_e::ControllerWorkerResults: return F("controller_worker_results");
+    case CooperativeJob_e::NR_ELEMENTS:             break;
+  }
+  return F("unknown");
+}
+
+CooperativeScheduler::CooperativeScheduler() {}
+
+bool CooperativeScheduler::registerJob(CooperativeJob_e  job,
+                                       CooperativeJob_fn func,
+                                       uint8_t           priority,
+                                       uint32_t          budget_usec)
+{
+  const uint8_t index = static_cast<uint8_t>(job);
+
+  if ((index >= static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)) || (func == nullptr)) {
+    return false;
+  }
+  _jobs[index].func        = func;
+  _jobs[index].priority    = priority;
+  _jobs[index].budget_usec = budget_usec;
+  sortJobs();
+  return true;
+}
+
+void CooperativeScheduler::unregisterJob(CooperativeJob_e job)
+{
+  const uint8_t index = static_cast<uint8_t>(job);
+
+  if (index < static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)) {
+    _jobs[index].func = nullptr;
+    sortJobs();
+  }
+}
+
+bool CooperativeScheduler::run(uint32_t loop_budget_usec)
+{
+  // Prevent recursion, e.g. when a job calls delay()
+  if (_running || (_nrJobs == 0)) { return false; }
+  _running = true;
+
+  const uint64_t start   = getMicros64();
+  bool workDone          = false;
+  const uint8_t firstJob = _firstJob;
+
+  _firstJob = 0;
+
+  for (uint8_t i = 0; i < _nrJobs; ++i) {
+    const uint8_t pos = (firstJob + i) % _nrJobs;
+
+    if (usecPassedSince(start) >= static_cast<int64_t>(loop_budget_usec)) {
+      // Continue with this job on the next run
+      _firstJob = pos;
+      ++_loopBudgetExhausted;
+
+      for (; i < _nrJobs; ++i) {
+        ++_stats[_order[(firstJob + i) % _nrJobs]].skipped;
+      }
+      break;
+    }
+
+    if (runJob(_order[pos])) {
+      workDone = true;
+    }
+  }
+  _running = false;
+  return workDone;
+}
+
+bool CooperativeScheduler::isRegistered(CooperativeJob_e job) const
+{
+  const uint8_t index = static_cast<uint8_t>(job);
+
+  return index < static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS) &&
+         _jobs[index].func != nullptr;
+}
+
+uint32_t CooperativeScheduler::getBudget(CooperativeJob_e job) const
+{
+  if (!isRegistered(job)) { return 0; }
+  return _jobs[static_cast<uint8_t>(job)].budget_usec;
+}
+
+const CooperativeJobStats& CooperativeScheduler::getStats(CooperativeJob_e job) const
+{
+  const uint8_t index = static_cast<uint8_t>(job);
+
+  if (index >= static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)) {
+    return _stats[0];
+  }
+  return _stats[index];
+}
+
+void CooperativeScheduler::resetStats()
+{
+  for (uint8_t i = 0; i < static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS); ++i) {
+    _stats[i] = CooperativeJobStats();
+  }
+  _loopBudgetExhausted = 0;
+}
+
+bool CooperativeScheduler::runJob(uint8_t index)
+{
+  const Job& job = _jobs[index];
+
+  if (job.func == nullptr) { return false; }
+
+  CooperativeJobStats& stats = _stats[index];
+  const uint64_t start       = getMicros64();
+  bool workDone              = false;
+  int64_t duration           = 0;
+
+  while (job.func()) {
+    workDone = true;
+    ++stats.calls;
+    duration = usecPassedSince(start);
+
+    if (duration >= static_cast<int64_t>(job.budget_usec)) {
+      // Budget used, there may still be work left for the next run.
+      ++stats.deferred;
+      break;
+    }
+  }
+
+  if (!workDone) { return false; }
+  duration = usecPassedSince(start);
+
+  if (duration > static_cast<int64_t>(job.budget_usec)) {
+    ++stats.overruns;
+  }
+
+  if (duration > static_cast<int64_t>(stats.max_usec)) {
+    stats.max_usec = duration;
+  }
+  stats.total_usec += duration;
+  return true;
+}
+
+void CooperativeScheduler::sortJobs()
+{
+  _nrJobs = 0;
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS); ++i) {
+    if (_jobs[i].func != nullptr) {
+      // Insertion sort on priority, keep enum order for equal priority
+      uint8_t pos = _nrJobs;
+
+      while (pos > 0 && _jobs[_order[pos - 1]].priority > _jobs[i].priority) {
+        _order[pos] = _order[pos - 1];
+        --pos;
+      }
+      _order[pos] = i;
+      ++_nrJobs;
+    }
+  }
+  _firstJob = 0;
+}
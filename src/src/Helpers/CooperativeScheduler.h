@@ -0,0 +1,128 @@
+#ifndef HELPERS_COOPERATIVESCHEDULER_H
+#define HELPERS_COOPERATIVESCHEDULER_H
+
+#include "../../ESPEasy_common.h"
+
+
+#ifndef COOPERATIVE_SCHEDULER_LOOP_BUDGET_USEC
+# define COOPERATIVE_SCHEDULER_LOOP_BUDGET_USEC 10000
+#endif // ifndef COOPERATIVE_SCHEDULER_LOOP_BUDGET_USEC
+
+#ifndef COOPERATIVE_JOB_SYSTEM_EVENT_BUDGET_USEC
+# define COOPERATIVE_JOB_SYSTEM_EVENT_BUDGET_USEC 5000
+#endif // ifndef COOPERATIVE_JOB_SYSTEM_EVENT_BUDGET_USEC
+
+#ifndef COOPERATIVE_JOB_RULES_EVENT_BUDGET_USEC
+# define COOPERATIVE_JOB_RULES_EVENT_BUDGET_USEC 5000
+#endif // ifndef COOPERATIVE_JOB_RULES_EVENT_BUDGET_USEC
+
+#ifndef COOPERATIVE_JOB_LOG_SINKS_BUDGET_USEC
+# define COOPERATIVE_JOB_LOG_SINKS_BUDGET_USEC 1000
+#endif // ifndef COOPERATIVE_JOB_LOG_SINKS_BUDGET_USEC
+
+#ifndef COOPERATIVE_JOB_CONTROLLER_WORKER_BUDGET_USEC
+# define COOPERATIVE_JOB_CONTROLLER_WORKER_BUDGET_USEC 2000
+#endif // ifndef COOPERATIVE_JOB_CONTROLLER_WORKER_BUDGET_USEC
+
+
+/*********************************************************************************************\
+* Cooperative time-budgeted scheduler for background jobs
+*
+* Some subsystems have work queued which does not need to run at a specific time,
+* like processing system events or rules events.
+* Each of these subsystems registers a job with a priority and a per-loop budget (in usec).
+*
+* A job function must handle at most one unit of work per call and return
+* whether it did perform some work. (thus there may be more to do)
+* The job is then called repeatedly until it returns false, or its budget is used.
+*
+* Jobs are dispatched in order of priority (lowest value first).
+* When the total loop budget is used, dispatching stops and the next run will start
+* with the first job that was skipped, to make sure low priority jobs will not starve.
+*
+* A single call cannot be interrupted, so when a call takes longer than the remaining
+* budget of the job, this is counted as an overrun.
+\*********************************************************************************************/
+
+enum class CooperativeJob_e : uint8_t {
+  SystemEventQueue,
+  RulesEventQueue,
+  LogSinks,
+  ControllerWorkerResults,
+
+  NR_ELEMENTS // Keep as last
+};
+
+const __FlashStringHelper* toString(CooperativeJob_e job);
+
+typedef bool (*CooperativeJob_fn)();
+
+struct CooperativeJobStats {
+  uint32_t calls       = 0; // Number of calls which did perform some work
+  uint32_t overruns    = 0; // Number of runs where the budget was exceeded
+  uint32_t deferred    = 0; // Number of runs ended by the budget while there was more work
+  uint32_t skipped     = 0; // Number of runs skipped as the loop budget was used up
+  uint32_t max_usec    = 0; // Max duration of a single run
+  uint64_t total_usec  = 0;
+};
+
+class CooperativeScheduler {
+public:
+
+  CooperativeScheduler();
+
+  // Register (or update) a job.
+  // @param priority     Lower value will be dispatched first
+  // @param budget_usec  Max. time per loop this job may use.
+  bool registerJob(CooperativeJob_e  job,
+                   CooperativeJob_fn func,
+                   uint8_t           priority,
+                   uint32_t          budget_usec);
+
+  void unregisterJob(CooperativeJob_e job);
+
+  // Dispatch registered jobs until either all are done or the loop budget is used.
+  // Return true when some work was done.
+  bool run(uint32_t loop_budget_usec = COOPERATIVE_SCHEDULER_LOOP_BUDGET_USEC);
+
+  bool isRegistered(CooperativeJob_e job) const;
+
+  uint32_t                   getBudget(CooperativeJob_e job) const;
+
+  const CooperativeJobStats& getStats(CooperativeJob_e job) const;
+
+  // Number of runs where not all jobs could be dispatched
+  uint32_t getLoopBudgetExhausted() const {
+    return _loopBudgetExhausted;
+  }
+
+  void resetStats();
+
+private:
+
+  // Run a single job within its budget.
+  // Return true when some work was done.
+  bool runJob(uint8_t index);
+
+  void sortJobs();
+
+  struct Job {
+    CooperativeJob_fn func        = nullptr;
+    uint32_t          budget_usec = 0;
+    uint8_t           priority    = 0;
+  };
+
+  Job                 _jobs[static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)];
+  CooperativeJobStats _stats[static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)];
+
+  // Job indices sorted on priority
+  uint8_t _order[static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS)] = {};
+  uint8_t _nrJobs   = 0;
+  uint8_t _firstJob = 0;
+
+  uint32_t _loopBudgetExhausted = 0;
+  bool     _running             = false;
+};
+
+
+#endif // ifndef HELPERS_COOPERATIVESCHEDULER_H
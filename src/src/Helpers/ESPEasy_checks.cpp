@@ -40,6 +40,7 @@
 
 #ifdef USES_C016
 #include "../ControllerQueue/C016_queue_element.h"
+#include "../DataStructs/RTC_cache_handler_struct.h"
 #endif
 
 #if FEATURE_NOTIFIER
@@ -134,6 +135,11 @@ void run_compiletime_checks() {
   #endif
   #ifdef USES_C016
   check_size<C016_binary_element,                   24u>();
+  #if FEATURE_RTC_CACHE_STORAGE
+  // Read positions are stored in units of RTC_CACHE_READPOS_UNIT, so each element must end on a unit boundary.
+  static_assert((sizeof(C016_binary_element) % RTC_CACHE_READPOS_UNIT) == 0,
+                "C016_binary_element size must be a multiple of RTC_CACHE_READPOS_UNIT");
+  #endif
   #endif
 
 
@@ -920,6 +920,11 @@ bool ESPEasy_time::ExtRTC_get(uint32_t& unixtime)
 {
   unixtime = 0;
 
+  if (Settings.ExtTimeSource() != ExtTimeSource_e::None) {
+    // The external RTC is not connected via the I2C multiplexer
+    I2CSelectDefaultBusState();
+  }
+
   switch (Settings.ExtTimeSource()) {
     case ExtTimeSource_e::None:
       return false;
@@ -1013,6 +1018,11 @@ bool ESPEasy_time::ExtRTC_set(uint32_t unixtime)
   }
   bool timeAdjusted = false;
 
+  if (Settings.ExtTimeSource() != ExtTimeSource_e::None) {
+    // The external RTC is not connected via the I2C multiplexer
+    I2CSelectDefaultBusState();
+  }
+
   switch (Settings.ExtTimeSource()) {
     case ExtTimeSource_e::None:
       return false;
@@ -0,0 +1,200 @@
+#include "../Helpers/HTTPConnectionPool.h"
+
+#if FEATURE_HTTP_CONNECTION_POOL
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include <new>
+
+float HTTPConnectionStats::getReuseRatio() const {
+  if (requests == 0) { return 0.0f; }
+  return static_cast<float>(reused) / static_cast<float>(requests);
+}
+
+uint32_t HTTPConnectionStats::getSetupTime_usec() const {
+  const uint32_t nrNew = requests - reused;
+
+  if ((nrNew == 0) || (reused == 0)) { return 0; }
+  const uint64_t avg_new    = new_usec / nrNew;
+  const uint64_t avg_reused = reused_usec / reused;
+
+  if (avg_new <= avg_reused) { return 0; }
+  return static_cast<uint32_t>(avg_new - avg_reused);
+}
+
+HTTPConnectionPool::~HTTPConnectionPool() {
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    delete _connections[x].exchange(nullptr);
+  }
+}
+
+HTTPConnectionPool::Connection * HTTPConnectionPool::getConnection(controllerIndex_t controller_idx) {
+  if (controller_idx >= CONTROLLER_MAX) { return nullptr; }
+  Connection *conn = _connections[controller_idx].load();
+
+  if (conn == nullptr) {
+    Connection *newConn = new (std::nothrow) Connection;
+
+    if (newConn == nullptr) { return nullptr; }
+
+    // Another task may have allocated a connection in the meantime.
+    if (_connections[controller_idx].compare_exchange_strong(conn, newConn)) {
+      conn = newConn;
+    } else {
+      delete newConn;
+    }
+  }
+  return conn;
+}
+
+void HTTPConnectionPool::Connection::stop() {
+  // HTTPClient only closes the connection on end() when it may not be reused.
+  http.setReuse(false);
+  http.end();
+  http.setReuse(true);
+  client.stop();
+  keptOpen = false;
+}
+
+String HTTPConnectionPool::send(controllerIndex_t controller_idx,
+                                const String    & logIdentifier,
+                                uint16_t          timeout,
+                                const String    & user,
+                                const String    & pass,
+                                const String    & host,
+                                uint16_t          port,
+                                const String    & uri,
+                                const String    & HttpMethod,
+                                const String    & header,
+                                const String    & postStr,
+                                int             & httpCode,
+                                bool              must_check_reply)
+{
+  Connection *conn = getConnection(controller_idx);
+
+  if ((conn == nullptr) || !conn->tryClaim()) {
+    // Not able to use the pool, use a new connection
+    return send_via_http(logIdentifier, timeout, user, pass, host, port, uri, HttpMethod, header, postStr, httpCode, must_check_reply);
+  }
+
+  if ((conn->port != port) || !conn->host.equals(host)) {
+    // Controller settings changed
+    conn->stop();
+    conn->host = host;
+    conn->port = port;
+  }
+
+  bool reuse = false;
+
+  // On ESP8266 HTTPClient uses a copy of the client, so check the connection state of the HTTPClient.
+  if (conn->keptOpen) {
+    if (conn->http.connected()) {
+      reuse = true;
+    } else {
+      ++conn->stats.serverClosed;
+      conn->stop();
+    }
+  }
+
+  conn->http.setReuse(true);
+  uint64_t start = getMicros64();
+  String   response =
+    send_via_http(logIdentifier, conn->client, conn->http, timeout, user, pass, host, port, uri, HttpMethod, header, postStr, httpCode,
+                  must_check_reply);
+
+  if (reuse) {
+    // The server may have closed the connection while it was idle, without us noticing yet.
+    // Only retry when connecting or sending the header failed, as then the server cannot have processed the request.
+    // A connection lost after sending the body may have been processed, so a retry could duplicate a POST.
+    switch (httpCode) {
+      case HTTPC_ERROR_CONNECTION_REFUSED:
+      case HTTPC_ERROR_SEND_HEADER_FAILED:
+      case HTTPC_ERROR_NOT_CONNECTED:
+      {
+        # ifndef BUILD_NO_DEBUG
+
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          addLogMove(LOG_LEVEL_DEBUG, concat(logIdentifier, F(" : Kept-alive connection lost, reconnect")));
+        }
+        # endif // ifndef BUILD_NO_DEBUG
+        ++conn->stats.retries;
+        conn->stop();
+        reuse    = false;
+        start    = getMicros64();
+        response = send_via_http(logIdentifier, conn->client, conn->http, timeout, user, pass, host, port, uri, HttpMethod, header, postStr,
+                                 httpCode, must_check_reply);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  const uint64_t duration = usecPassedSince(start);
+
+  ++conn->stats.requests;
+
+  if (reuse) {
+    ++conn->stats.reused;
+    conn->stats.reused_usec += duration;
+  } else {
+    conn->stats.new_usec += duration;
+  }
+
+  if (httpCode < 0) {
+    // Make sure to start with a clean connection next time.
+    conn->stop();
+  } else {
+    // HTTPClient::end() keeps the connection open when the server allows it.
+    conn->keptOpen = conn->http.connected();
+  }
+  conn->lastUsed = millis();
+  conn->release();
+  return response;
+}
+
+void HTTPConnectionPool::closeIdle() {
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    Connection *conn = _connections[x].load();
+
+    // Claim the connection, so it cannot be used by another task while stopping it.
+    if ((conn != nullptr) && conn->tryClaim()) {
+      if (conn->keptOpen && (timePassedSince(conn->lastUsed) > HTTP_CONNECTION_POOL_IDLE_TIMEOUT)) {
+        conn->stop();
+      }
+      conn->release();
+    }
+  }
+}
+
+void HTTPConnectionPool::close(controllerIndex_t controller_idx) {
+  if (controller_idx < CONTROLLER_MAX) {
+    Connection *conn = _connections[controller_idx].load();
+
+    if ((conn != nullptr) && conn->tryClaim()) {
+      conn->stop();
+      conn->release();
+    }
+  }
+}
+
+void HTTPConnectionPool::closeAll() {
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    close(x);
+  }
+}
+
+const HTTPConnectionStats * HTTPConnectionPool::getStats(controllerIndex_t controller_idx) const {
+  if (controller_idx < CONTROLLER_MAX) {
+    const Connection *conn = _connections[controller_idx].load();
+
+    if ((conn != nullptr) && (conn->stats.requests > 0)) {
+      return &conn->stats;
+    }
+  }
+  return nullptr;
+}
+
+#endif // if FEATURE_HTTP_CONNECTION_POOL
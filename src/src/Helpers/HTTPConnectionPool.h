@@ -0,0 +1,115 @@
+#ifndef HELPERS_HTTPCONNECTIONPOOL_H
+#define HELPERS_HTTPCONNECTIONPOOL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_HTTP_CONNECTION_POOL
+
+# include "../DataTypes/ControllerIndex.h"
+# include "../Helpers/Networking.h"
+
+# include <atomic>
+
+# ifndef HTTP_CONNECTION_POOL_IDLE_TIMEOUT
+#  define HTTP_CONNECTION_POOL_IDLE_TIMEOUT  30000 // msec
+# endif // ifndef HTTP_CONNECTION_POOL_IDLE_TIMEOUT
+
+
+struct HTTPConnectionStats {
+  // Ratio of requests sent over an already open connection
+  float    getReuseRatio() const;
+
+  // Estimated time needed to set up a new connection (DNS + TCP connect)
+  // computed as the difference in average duration of requests over a new and a reused connection.
+  uint32_t getSetupTime_usec() const;
+
+  uint32_t requests     = 0; // Total number of requests
+  uint32_t reused       = 0; // Requests sent over a kept-alive connection
+  uint32_t retries      = 0; // Kept-alive connection failed, request sent again over a new connection
+  uint32_t serverClosed = 0; // Kept-alive connection was closed by the server before it could be reused
+  uint64_t new_usec     = 0; // Total duration of requests over a new connection
+  uint64_t reused_usec  = 0; // Total duration of requests over a reused connection
+};
+
+
+/*********************************************************************************************\
+* HTTPConnectionPool
+*
+* Keeps a single HTTP connection per controller alive between requests,
+* so a controller sending to the same host does not need a DNS lookup and TCP handshake for each message.
+*
+* - Requests are sent with "Connection: keep-alive".
+*   When the server replies with "Connection: close", HTTPClient closes the connection.
+* - When a kept-alive connection appears to be closed before the request was sent,
+*   the request is sent again over a new connection.
+* - Connections not used for HTTP_CONNECTION_POOL_IDLE_TIMEOUT msec are closed.
+\*********************************************************************************************/
+class HTTPConnectionPool {
+public:
+
+  HTTPConnectionPool() = default;
+  ~HTTPConnectionPool();
+
+  HTTPConnectionPool(const HTTPConnectionPool& other)            = delete;
+  HTTPConnectionPool& operator=(const HTTPConnectionPool& other) = delete;
+
+  String send(controllerIndex_t controller_idx,
+              const String    & logIdentifier,
+              uint16_t          timeout,
+              const String    & user,
+              const String    & pass,
+              const String    & host,
+              uint16_t          port,
+              const String    & uri,
+              const String    & HttpMethod,
+              const String    & header,
+              const String    & postStr,
+              int             & httpCode,
+              bool              must_check_reply);
+
+  // Close connections which have been idle too long
+  void                       closeIdle();
+
+  void                       close(controllerIndex_t controller_idx);
+
+  void                       closeAll();
+
+  // Return nullptr when no request was made for this controller.
+  const HTTPConnectionStats* getStats(controllerIndex_t controller_idx) const;
+
+private:
+
+  struct Connection {
+    WiFiClient          client;
+    HTTPClient          http;
+    String              host;
+    HTTPConnectionStats stats;
+    unsigned long       lastUsed = 0;
+    uint16_t            port     = 0;
+    bool                keptOpen = false; // Connection was left open after the last request
+
+    // Set while the connection is in use, as requests may be sent from the controller worker task.
+    // Must be claimed using tryClaim() before accessing the client.
+    std::atomic<bool> busy{ false };
+
+    bool tryClaim() {
+      return !busy.exchange(true);
+    }
+
+    void release() {
+      busy.store(false);
+    }
+
+    void stop();
+  };
+
+  // Get the connection for the controller, allocate when not yet present.
+  Connection* getConnection(controllerIndex_t controller_idx);
+
+  // Connections are only allocated, never deleted while in use.
+  std::atomic<Connection *>_connections[CONTROLLER_MAX]{};
+};
+
+#endif // if FEATURE_HTTP_CONNECTION_POOL
+
+#endif // ifndef HELPERS_HTTPCONNECTIONPOOL_H
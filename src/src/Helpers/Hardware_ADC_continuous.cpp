@@ -0,0 +1,230 @@
+#include "../Helpers/Hardware_ADC_continuous.h"
+
+#if FEATURE_ADC_CONTINUOUS
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/Hardware_GPIO.h"
+# include "../Helpers/StringConverter.h"
+
+# if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#  define ADC_CONTINUOUS_OUTPUT_TYPE      ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#  define ADC_CONTINUOUS_GET_CHANNEL(p)   ((p)->type1.channel)
+#  define ADC_CONTINUOUS_GET_DATA(p)      ((p)->type1.data)
+# else // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#  define ADC_CONTINUOUS_OUTPUT_TYPE      ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#  define ADC_CONTINUOUS_GET_CHANNEL(p)   ((p)->type2.channel)
+#  define ADC_CONTINUOUS_GET_DATA(p)      ((p)->type2.data)
+# endif // if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+
+# define ADC_CONTINUOUS_FRAME_SIZE  (ADC_CONTINUOUS_FRAME_CONV * SOC_ADC_DIGI_RESULT_BYTES)
+
+// Ring buffer size of the driver, rounded up to a multiple of the frame size
+# define ADC_CONTINUOUS_NR_FRAMES \
+  ((((ADC_CONTINUOUS_SAMPLE_FREQ * ADC_CONTINUOUS_BUFFER_MSEC) / 1000) + ADC_CONTINUOUS_FRAME_CONV - 1) / ADC_CONTINUOUS_FRAME_CONV)
+# define ADC_CONTINUOUS_POOL_SIZE \
+  (((ADC_CONTINUOUS_NR_FRAMES < 2) ? 2 : ADC_CONTINUOUS_NR_FRAMES) * ADC_CONTINUOUS_FRAME_SIZE)
+
+
+Hardware_ADC_continuous_t ADC_continuous;
+
+Hardware_ADC_continuous_t::~Hardware_ADC_continuous_t()
+{
+  stop();
+}
+
+bool Hardware_ADC_continuous_t::addChannel(taskIndex_t taskIndex, int pin, adc_atten_t attenuation)
+{
+  int adc, ch, t;
+
+  if (!getADC_gpio_info(pin, adc, ch, t) || (adc != 1) || (ch >= SOC_ADC_CHANNEL_NUM(0))) {
+    return false;
+  }
+
+  for (auto it = _channels.begin(); it != _channels.end();) {
+    if (it->taskIndex == taskIndex) {
+      it = _channels.erase(it);
+    } else if (it->pin == pin) {
+      // Each channel can only be used by a single task, as taking the samples clears them.
+      return false;
+    } else {
+      ++it;
+    }
+  }
+
+  if (_channels.size() >= SOC_ADC_PATT_LEN_MAX) {
+    return false;
+  }
+
+  Channel channel;
+
+  channel.taskIndex   = taskIndex;
+  channel.pin         = pin;
+  channel.channel     = ch;
+  channel.attenuation = attenuation;
+  _channels.push_back(channel);
+
+  if (start()) {
+    return true;
+  }
+
+  // Keep sampling the other channels
+  _channels.pop_back();
+  start();
+  return false;
+}
+
+void Hardware_ADC_continuous_t::removeChannel(taskIndex_t taskIndex)
+{
+  const int index = getChannelIndex(taskIndex);
+
+  if (index < 0) { return; }
+  _channels.erase(_channels.begin() + index);
+
+  // Restart with the new channel pattern, or stop when no channels are left.
+  start();
+}
+
+void Hardware_ADC_continuous_t::process()
+{
+  if ((_handle == nullptr) || (_frame == nullptr)) { return; }
+
+  // Do not keep reading when the driver delivers frames faster than we can handle them.
+  constexpr uint32_t maxFrames = (ADC_CONTINUOUS_POOL_SIZE / ADC_CONTINUOUS_FRAME_SIZE) + 1;
+
+  for (uint32_t frame = 0; frame < maxFrames; ++frame) {
+    uint32_t length = 0;
+
+    if ((ESP_OK != adc_continuous_read(_handle, _frame, ADC_CONTINUOUS_FRAME_SIZE, &length, 0)) || (length == 0)) {
+      return;
+    }
+
+    for (uint32_t i = 0; (i + SOC_ADC_DIGI_RESULT_BYTES) <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t *result = reinterpret_cast<const adc_digi_output_data_t *>(&_frame[i]);
+      const uint32_t ch                    = ADC_CONTINUOUS_GET_CHANNEL(result);
+
+      if (ch < SOC_ADC_CHANNEL_NUM(0)) {
+        const int index = _channelLookup[ch];
+
+        if (index >= 0) {
+          const int sample = ADC_CONTINUOUS_GET_DATA(result);
+          _channels[index].lastSample = sample;
+          _channels[index].samples.add(sample);
+        }
+      }
+    }
+  }
+}
+
+bool Hardware_ADC_continuous_t::takeSamples(taskIndex_t taskIndex, ADC_SampleAccumulator& samples)
+{
+  const int index = getChannelIndex(taskIndex);
+
+  if ((index < 0) || (_channels[index].samples.getCount() == 0)) {
+    return false;
+  }
+  samples = _channels[index].samples;
+  _channels[index].samples.reset();
+  return true;
+}
+
+bool Hardware_ADC_continuous_t::getLastSample(taskIndex_t taskIndex, int& raw) const
+{
+  const int index = getChannelIndex(taskIndex);
+
+  if ((index < 0) || (_channels[index].lastSample < 0)) {
+    return false;
+  }
+  raw = _channels[index].lastSample;
+  return true;
+}
+
+uint32_t Hardware_ADC_continuous_t::getSampleRate() const
+{
+  if (_channels.empty()) { return 0; }
+  return ADC_CONTINUOUS_SAMPLE_FREQ / _channels.size();
+}
+
+int Hardware_ADC_continuous_t::getChannelIndex(taskIndex_t taskIndex) const
+{
+  for (size_t i = 0; i < _channels.size(); ++i) {
+    if (_channels[i].taskIndex == taskIndex) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool Hardware_ADC_continuous_t::start()
+{
+  stop();
+
+  if (_channels.empty()) { return false; }
+
+  for (size_t ch = 0; ch < SOC_ADC_CHANNEL_NUM(0); ++ch) {
+    _channelLookup[ch] = -1;
+  }
+
+  adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = {};
+
+  for (size_t i = 0; i < _channels.size(); ++i) {
+    _channelLookup[_channels[i].channel] = i;
+    _channels[i].lastSample              = -1;
+    _channels[i].samples.reset();
+
+    pattern[i].atten     = _channels[i].attenuation;
+    pattern[i].channel   = _channels[i].channel;
+    pattern[i].unit      = ADC_UNIT_1;
+    pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+  }
+
+  _frame = new (std::nothrow) uint8_t[ADC_CONTINUOUS_FRAME_SIZE];
+
+  if (_frame == nullptr) {
+    return false;
+  }
+
+  adc_continuous_handle_cfg_t handle_config = {};
+
+  handle_config.max_store_buf_size = ADC_CONTINUOUS_POOL_SIZE;
+  handle_config.conv_frame_size    = ADC_CONTINUOUS_FRAME_SIZE;
+
+  esp_err_t err = adc_continuous_new_handle(&handle_config, &_handle);
+
+  if (err == ESP_OK) {
+    adc_continuous_config_t config = {};
+
+    config.pattern_num    = _channels.size();
+    config.adc_pattern    = pattern;
+    config.sample_freq_hz = ADC_CONTINUOUS_SAMPLE_FREQ;
+    config.conv_mode      = ADC_CONV_SINGLE_UNIT_1;
+    config.format         = ADC_CONTINUOUS_OUTPUT_TYPE;
+
+    err = adc_continuous_config(_handle, &config);
+  }
+
+  if (err == ESP_OK) {
+    err = adc_continuous_start(_handle);
+
+    if (err == ESP_OK) {
+      return true;
+    }
+  }
+
+  addLog(LOG_LEVEL_ERROR, strformat(F("ADC  : Cannot start continuous sampling: %s"), esp_err_to_name(err)));
+  stop();
+  return false;
+}
+
+void Hardware_ADC_continuous_t::stop()
+{
+  if (_handle != nullptr) {
+    // Stop returns an error when not started, which is fine here.
+    adc_continuous_stop(_handle);
+    adc_continuous_deinit(_handle);
+    _handle = nullptr;
+  }
+  delete[] _frame;
+  _frame = nullptr;
+}
+
+#endif // if FEATURE_ADC_CONTINUOUS
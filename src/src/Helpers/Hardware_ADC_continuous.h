@@ -0,0 +1,122 @@
+#ifndef HELPERS_HARDWARE_ADC_CONTINUOUS_H
+#define HELPERS_HARDWARE_ADC_CONTINUOUS_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../Helpers/ADC_SampleAccumulator.h"
+
+#if FEATURE_ADC_CONTINUOUS && defined(ESP32)
+# include <soc/soc_caps.h>
+#endif // if FEATURE_ADC_CONTINUOUS && defined(ESP32)
+
+#if FEATURE_ADC_CONTINUOUS && (!defined(ESP32) || (ESP_IDF_VERSION_MAJOR < 5) || !SOC_ADC_DMA_SUPPORTED)
+
+// Continuous mode is only supported by the esp_adc driver of IDF 5.x and only on chips with ADC DMA
+# undef FEATURE_ADC_CONTINUOUS
+# define FEATURE_ADC_CONTINUOUS 0
+#endif // if FEATURE_ADC_CONTINUOUS && (!defined(ESP32) || (ESP_IDF_VERSION_MAJOR < 5) || !SOC_ADC_DMA_SUPPORTED)
+
+#if FEATURE_ADC_CONTINUOUS
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <esp_adc/adc_continuous.h>
+# include <vector>
+
+// Total nr of conversions per second, shared by all channels
+# ifndef ADC_CONTINUOUS_SAMPLE_FREQ
+#  if SOC_ADC_SAMPLE_FREQ_THRES_LOW > 5000
+#   define ADC_CONTINUOUS_SAMPLE_FREQ   SOC_ADC_SAMPLE_FREQ_THRES_LOW
+#  else // if SOC_ADC_SAMPLE_FREQ_THRES_LOW > 5000
+#   define ADC_CONTINUOUS_SAMPLE_FREQ   5000
+#  endif // if SOC_ADC_SAMPLE_FREQ_THRES_LOW > 5000
+# endif // ifndef ADC_CONTINUOUS_SAMPLE_FREQ
+
+// Nr of conversions per DMA frame
+# ifndef ADC_CONTINUOUS_FRAME_CONV
+#  define ADC_CONTINUOUS_FRAME_CONV     256
+# endif // ifndef ADC_CONTINUOUS_FRAME_CONV
+
+// The driver keeps the conversion results of this many msec in its ring buffer,
+// so process() must be called at least this often to not lose samples.
+# ifndef ADC_CONTINUOUS_BUFFER_MSEC
+#  define ADC_CONTINUOUS_BUFFER_MSEC    250
+# endif // ifndef ADC_CONTINUOUS_BUFFER_MSEC
+
+
+/*********************************************************************************************\
+* Hardware_ADC_continuous_t: Sample multiple ADC1 channels at a fixed rate using DMA
+*
+* The ADC driver stores the conversion results in a ring buffer, which is read by process().
+* Every sample is added to the accumulator of its channel, until the task takes the samples.
+* This decimates the sample stream into blocks, while still allowing the RMS to be computed
+* over all samples.
+*
+* While running, ADC1 cannot be used for single reads (analogRead) by other tasks.
+* On ESP32 the continuous mode uses the I2S0 peripheral.
+\*********************************************************************************************/
+class Hardware_ADC_continuous_t {
+public:
+
+  Hardware_ADC_continuous_t() = default;
+  ~Hardware_ADC_continuous_t();
+
+  // Add the pin for the task and (re)start sampling.
+  // Returns false when the pin is not on ADC1, already used, or sampling could not be started.
+  bool     addChannel(taskIndex_t taskIndex,
+                      int         pin,
+                      adc_atten_t attenuation);
+
+  // Remove the channel of the task, sampling is stopped when no channels are left.
+  void     removeChannel(taskIndex_t taskIndex);
+
+  bool     isRunning() const {
+    return _handle != nullptr;
+  }
+
+  // Read all available conversion results and add them to the channel accumulators.
+  void     process();
+
+  // Move the samples collected for the task since the last call to samples.
+  // Returns false when no samples were collected.
+  bool     takeSamples(taskIndex_t            taskIndex,
+                       ADC_SampleAccumulator& samples);
+
+  // Get the last sample of the task
+  bool     getLastSample(taskIndex_t taskIndex,
+                         int       & raw) const;
+
+  // Nr of samples per second per channel
+  uint32_t getSampleRate() const;
+
+private:
+
+  struct Channel {
+    taskIndex_t           taskIndex = INVALID_TASK_INDEX;
+    int                   pin       = -1;
+    uint8_t               channel   = 0;
+    adc_atten_t           attenuation{};
+    int                   lastSample = -1;
+    ADC_SampleAccumulator samples;
+  };
+
+  int  getChannelIndex(taskIndex_t taskIndex) const;
+
+  bool start();
+
+  void stop();
+
+  std::vector<Channel> _channels;
+
+  // Index in _channels per ADC1 channel, -1 when not sampled
+  int8_t _channelLookup[SOC_ADC_CHANNEL_NUM(0)];
+
+  adc_continuous_handle_t _handle = nullptr;
+  uint8_t                *_frame  = nullptr;
+};
+
+extern Hardware_ADC_continuous_t ADC_continuous;
+
+#endif // if FEATURE_ADC_CONTINUOUS
+
+#endif // ifndef HELPERS_HARDWARE_ADC_CONTINUOUS_H
@@ -9,6 +9,12 @@
 
 #include <Wire.h>
 
+#if FEATURE_I2CMULTIPLEXER
+// Value last written to the multiplexer, -1 when unknown
+static int16_t I2C_multiplexer_state = -1;
+static int8_t  I2C_multiplexer_addr  = -1;
+#endif // if FEATURE_I2CMULTIPLEXER
+
 
 void initI2C() {
   // configure hardware pins according to eeprom settings.
@@ -18,6 +24,9 @@ void initI2C() {
   }
   addLog(LOG_LEVEL_INFO, F("INIT : I2C"));
   I2CSelectHighClockSpeed(); // Set normal clock speed
+  #if FEATURE_I2CMULTIPLEXER
+  I2CMultiplexerClearCachedState();
+  #endif // if FEATURE_I2CMULTIPLEXER
 
   if (Settings.WireClockStretchLimit)
   {
@@ -92,6 +101,10 @@ void I2CForceResetBus_swap_pins(uint8_t address) {
   if (!Settings.EnableClearHangingI2Cbus()) { return; }
 #endif
 
+  #if FEATURE_I2CMULTIPLEXER
+  I2CMultiplexerClearCachedState();
+  #endif // if FEATURE_I2CMULTIPLEXER
+
   // As a final work-around, we temporary swap SDA and SCL, perform a scan and return pin order.
   I2CBegin(Settings.Pin_i2c_scl, Settings.Pin_i2c_sda, 100000);
   I2C_wakeup(address);
@@ -112,8 +125,10 @@ void I2CBegin(int8_t sda, int8_t scl, uint32_t clockFreq) {
 
   if ((clockFreq == lastI2CClockSpeed) && (sda == last_sda) && (scl == last_scl)) {
     // No need to change the clock speed.
+    ++I2C_bus_stats.clockChangesSkipped;
     return;
   }
+  ++I2C_bus_stats.clockChanges;
   #ifdef ESP32
 
   if ((sda != last_sda) || (scl != last_scl)) {
@@ -133,6 +148,13 @@ void I2CBegin(int8_t sda, int8_t scl, uint32_t clockFreq) {
   #endif // ifdef ESP32
 }
 
+void I2CSelectDefaultBusState() {
+  #if FEATURE_I2CMULTIPLEXER
+  I2CMultiplexerOff();
+  #endif // if FEATURE_I2CMULTIPLEXER
+  I2CSelectHighClockSpeed();
+}
+
 #if FEATURE_I2CMULTIPLEXER
 
 // Check if the I2C Multiplexer is enabled
@@ -148,6 +170,7 @@ void I2CMultiplexerReset() {
     delay(1); // minimum requirement of low for a proper reset seems to be about 6 nsec, so 1 msec should be more than sufficient
     digitalWrite(Settings.I2C_Multiplexer_ResetPin, HIGH);
   }
+  I2CMultiplexerClearCachedState();
 }
 
 // Shift the bit in the right position when selecting a single channel
@@ -177,20 +200,20 @@ uint8_t I2CMultiplexerShiftBit(uint8_t i) {
 void I2CMultiplexerSelectByTaskIndex(taskIndex_t taskIndex) {
   if (!validTaskIndex(taskIndex)) { return; }
 
-  if (!I2CMultiplexerPortSelectedForTask(taskIndex)) { return; }
+  // Tasks without channel set must not see devices on the channels of the previous task.
+  SetI2CMultiplexer(I2CMultiplexerChannelsForTask(taskIndex));
+}
 
-  uint8_t toWrite = 0;
+uint8_t I2CMultiplexerChannelsForTask(taskIndex_t taskIndex) {
+  if (!I2CMultiplexerPortSelectedForTask(taskIndex)) { return 0; }
 
   if (!bitRead(Settings.I2C_Flags[taskIndex], I2C_FLAGS_MUX_MULTICHANNEL)) {
     uint8_t i = Settings.I2C_Multiplexer_Channel[taskIndex];
 
-    if (i > 7) { return; }
-    toWrite = I2CMultiplexerShiftBit(i);
-  } else {
-    toWrite = Settings.I2C_Multiplexer_Channel[taskIndex]; // Bitpattern is already correctly stored
+    if (i > 7) { return 0; }
+    return I2CMultiplexerShiftBit(i);
   }
-
-  SetI2CMultiplexer(toWrite);
+  return Settings.I2C_Multiplexer_Channel[taskIndex]; // Bitpattern is already correctly stored
 }
 
 void I2CMultiplexerSelect(uint8_t i) {
@@ -207,14 +230,29 @@ void I2CMultiplexerOff() {
 
 void SetI2CMultiplexer(uint8_t toWrite) {
   if (isI2CMultiplexerEnabled()) {
-    // FIXME TD-er: Must check to see if we can cache the value so only change it when needed.
-
-    I2C_write8(Settings.I2C_Multiplexer_Addr, toWrite);
+    if ((I2C_multiplexer_state == toWrite) && (I2C_multiplexer_addr == Settings.I2C_Multiplexer_Addr)) {
+      ++I2C_bus_stats.muxWritesSkipped;
+      return;
+    }
+    ++I2C_bus_stats.muxWrites;
+
+    if (I2C_write8(Settings.I2C_Multiplexer_Addr, toWrite)) {
+      I2C_multiplexer_state = toWrite;
+      I2C_multiplexer_addr  = Settings.I2C_Multiplexer_Addr;
+    } else {
+      // Unknown what is selected now, so write again on the next call.
+      I2CMultiplexerClearCachedState();
+    }
 
     // FIXME TD-er: We must check if the chip needs some time to set the output. (delay?)
   }
 }
 
+void I2CMultiplexerClearCachedState() {
+  I2C_multiplexer_state = -1;
+  I2C_multiplexer_addr  = -1;
+}
+
 uint8_t I2CMultiplexerMaxChannels() {
   uint channels = 0;
 
@@ -16,16 +16,28 @@ void I2CBegin(int8_t   sda,
               int8_t   scl,
               uint32_t clockFreq);
 
+// Deselect the multiplexer channels and select the normal clock speed.
+// To be used before accessing I2C devices which do not belong to a task.
+void I2CSelectDefaultBusState();
+
 #if FEATURE_I2CMULTIPLEXER
 bool    isI2CMultiplexerEnabled();
 
+// Select the channels of the task, or deselect all channels when the task has no channel set.
 void    I2CMultiplexerSelectByTaskIndex(taskIndex_t taskIndex);
+
+// Bit pattern to write to the multiplexer to select the channels of the task, 0 when none set.
+uint8_t I2CMultiplexerChannelsForTask(taskIndex_t taskIndex);
 void    I2CMultiplexerSelect(uint8_t i);
 
 void    I2CMultiplexerOff();
 
+// The last written value is kept, so writing the same value again is skipped.
 void    SetI2CMultiplexer(uint8_t toWrite);
 
+// Forget the last written value, e.g. when the multiplexer may have been reset.
+void    I2CMultiplexerClearCachedState();
+
 uint8_t I2CMultiplexerMaxChannels();
 
 void    I2CMultiplexerReset();
@@ -0,0 +1,408 @@
+#include "../Helpers/JSON_StreamScanner.h"
+
+namespace {
+int8_t hexValue(char c)
+{
+  if ((c >= '0') && (c <= '9')) { return c - '0'; }
+
+  if ((c >= 'a') && (c <= 'f')) { return c - 'a' + 10; }
+
+  if ((c >= 'A') && (c <= 'F')) { return c - 'A' + 10; }
+  return -1;
+}
+
+// pos at the character following the backslash, returns the position after the escape sequence.
+const char* decodeEscape(const char *pos, const char *end, uint32_t& codepoint)
+{
+  switch (*pos) {
+    case 'b': codepoint = '\b'; break;
+    case 'f': codepoint = '\f'; break;
+    case 'n': codepoint = '\n'; break;
+    case 'r': codepoint = '\r'; break;
+    case 't': codepoint = '\t'; break;
+    case 'u':
+    {
+      if ((end - pos) < 5) {
+        codepoint = '?';
+        return end;
+      }
+      codepoint = 0;
+
+      for (uint8_t i = 1; i <= 4; ++i) {
+        const int8_t nibble = hexValue(pos[i]);
+
+        if (nibble < 0) {
+          codepoint = '?';
+          return pos + 1;
+        }
+        codepoint = (codepoint << 4) | nibble;
+      }
+      pos += 4;
+
+      // Combine UTF-16 surrogate pair
+      if ((codepoint >= 0xD800) && (codepoint < 0xDC00) &&
+          ((end - pos) >= 7) && (pos[1] == '\\') && (pos[2] == 'u')) {
+        uint32_t low = 0;
+
+        for (uint8_t i = 3; i <= 6; ++i) {
+          const int8_t nibble = hexValue(pos[i]);
+
+          if (nibble < 0) {
+            low = 0;
+            break;
+          }
+          low = (low << 4) | nibble;
+        }
+
+        if ((low >= 0xDC00) && (low < 0xE000)) {
+          codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+          pos      += 6;
+        }
+      }
+      break;
+    }
+    default:
+      // \" \\ \/
+      codepoint = static_cast<uint8_t>(*pos);
+      break;
+  }
+  return pos + 1;
+}
+
+uint8_t encodeUtf8(uint32_t codepoint, char *buf)
+{
+  if (codepoint < 0x80) {
+    buf[0] = codepoint;
+    return 1;
+  }
+
+  if (codepoint < 0x800) {
+    buf[0] = 0xC0 | (codepoint >> 6);
+    buf[1] = 0x80 | (codepoint & 0x3F);
+    return 2;
+  }
+
+  if (codepoint < 0x10000) {
+    buf[0] = 0xE0 | (codepoint >> 12);
+    buf[1] = 0x80 | ((codepoint >> 6) & 0x3F);
+    buf[2] = 0x80 | (codepoint & 0x3F);
+    return 3;
+  }
+  buf[0] = 0xF0 | (codepoint >> 18);
+  buf[1] = 0x80 | ((codepoint >> 12) & 0x3F);
+  buf[2] = 0x80 | ((codepoint >> 6) & 0x3F);
+  buf[3] = 0x80 | (codepoint & 0x3F);
+  return 4;
+}
+
+// start and end exclude the surrounding quotes
+void appendUnescaped(const char *start, const char *end, String& str)
+{
+  while (start < end) {
+    const char *run = start;
+
+    while (start < end && *start != '\\') { ++start; }
+
+    if (start > run) {
+      str.concat(run, start - run);
+    }
+
+    if ((start + 1) < end) {
+      uint32_t codepoint{};
+      char     buf[4];
+      start = decodeEscape(start + 1, end, codepoint);
+      str.concat(buf, encodeUtf8(codepoint, buf));
+    } else {
+      start = end;
+    }
+  }
+}
+
+// start and end exclude the surrounding quotes
+bool keyEquals(const char *start, const char *end, const char *key, size_t keyLength)
+{
+  const char *keyEnd = key + keyLength;
+
+  while (start < end) {
+    if (*start != '\\') {
+      if ((key >= keyEnd) || (*start != *key)) { return false; }
+      ++start;
+      ++key;
+    } else {
+      if ((start + 1) >= end) { return false; }
+      uint32_t codepoint{};
+      char     buf[4];
+      start = decodeEscape(start + 1, end, codepoint);
+      const uint8_t len = encodeUtf8(codepoint, buf);
+
+      if (((keyEnd - key) < len) || (memcmp(buf, key, len) != 0)) { return false; }
+      key += len;
+    }
+  }
+  return key == keyEnd;
+}
+} // namespace
+
+JSON_StreamScanner::JSON_StreamScanner(const char *json, size_t length)
+{
+  setSource(json, length);
+}
+
+void JSON_StreamScanner::setSource(const char *json, size_t length)
+{
+  _json = json;
+  _end  = json == nullptr ? nullptr : json + length;
+  rewind();
+}
+
+void JSON_StreamScanner::clear()
+{
+  _json = nullptr;
+  _end  = nullptr;
+  _pos  = nullptr;
+}
+
+bool JSON_StreamScanner::isObject() const
+{
+  const char *pos = skipWhitespace(_json);
+
+  if ((pos >= _end) || (*pos != '{')) { return false; }
+  pos = skipValue(pos);
+
+  if (pos == nullptr) { return false; }
+  return skipWhitespace(pos) >= _end;
+}
+
+bool JSON_StreamScanner::getValue(const String& path, String& value) const
+{
+  value.clear();
+
+  const char *pos     = skipWhitespace(_json);
+  const char *element = path.c_str();
+  const char *pathEnd = element + path.length();
+
+  while (pos != nullptr && pos < _end) {
+    const char *elementEnd = static_cast<const char *>(memchr(element, '.', pathEnd - element));
+
+    if (elementEnd == nullptr) { elementEnd = pathEnd; }
+
+    if (*pos == '{') {
+      pos = findMember(pos, element, elementEnd - element);
+    } else if ((*pos == '[') && (elementEnd > element)) {
+      size_t index = 0;
+
+      for (const char *c = element; c < elementEnd && pos != nullptr; ++c) {
+        if (!isdigit(*c)) {
+          pos = nullptr;
+        } else {
+          index = index * 10 + (*c - '0');
+        }
+      }
+
+      if (pos != nullptr) {
+        pos = findElement(pos, index);
+      }
+    } else {
+      pos = nullptr;
+    }
+
+    if (elementEnd >= pathEnd) {
+      break;
+    }
+    element = elementEnd + 1;
+  }
+
+  if ((pos == nullptr) || (pos >= _end)) { return false; }
+  const char *valueEnd = skipValue(pos);
+
+  if (valueEnd == nullptr) { return false; }
+  appendValue(pos, valueEnd, value);
+  return true;
+}
+
+void JSON_StreamScanner::rewind()
+{
+  const char *pos = skipWhitespace(_json);
+
+  _pos = ((pos < _end) && (*pos == '{')) ? pos + 1 : nullptr;
+}
+
+bool JSON_StreamScanner::atEnd() const
+{
+  if (_pos == nullptr) { return true; }
+  const char *pos = skipWhitespace(_pos);
+
+  return pos >= _end || *pos == '}';
+}
+
+bool JSON_StreamScanner::next(String& key, String& value)
+{
+  key.clear();
+  value.clear();
+
+  if (atEnd()) { return false; }
+
+  const char *pos = skipWhitespace(_pos);
+  _pos = nullptr; // Stop iterating on errors
+
+  if (*pos != '"') { return false; }
+  const char *keyEnd = skipString(pos);
+
+  if (keyEnd == nullptr) { return false; }
+  const char *valueStart = skipWhitespace(keyEnd);
+
+  if ((valueStart >= _end) || (*valueStart != ':')) { return false; }
+  valueStart = skipWhitespace(valueStart + 1);
+  const char *valueEnd = skipValue(valueStart);
+
+  if (valueEnd == nullptr) { return false; }
+
+  appendUnescaped(pos + 1, keyEnd - 1, key);
+  appendValue(valueStart, valueEnd, value);
+
+  pos = skipWhitespace(valueEnd);
+
+  if (pos < _end) {
+    if (*pos == ',') {
+      _pos = pos + 1;
+    } else if (*pos == '}') {
+      _pos = pos;
+    }
+  }
+  return true;
+}
+
+const char * JSON_StreamScanner::skipWhitespace(const char *pos) const
+{
+  if (pos == nullptr) { return _end; }
+
+  while (pos < _end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) {
+    ++pos;
+  }
+  return pos;
+}
+
+const char * JSON_StreamScanner::skipString(const char *pos) const
+{
+  ++pos; // Opening quote
+
+  while (pos < _end) {
+    if (*pos == '\\') {
+      pos += 2;
+    } else if (*pos == '"') {
+      return pos + 1;
+    } else {
+      ++pos;
+    }
+  }
+  return nullptr;
+}
+
+const char * JSON_StreamScanner::skipValue(const char *pos) const
+{
+  pos = skipWhitespace(pos);
+
+  if (pos >= _end) { return nullptr; }
+
+  switch (*pos) {
+    case '"':
+      return skipString(pos);
+    case '{':
+    case '[':
+    {
+      // Keep track of the type of the open brackets, 1 bit per nesting level
+      uint64_t nesting = 0;
+      uint8_t  depth   = 0;
+
+      while (pos < _end) {
+        const char c = *pos;
+
+        if (c == '"') {
+          pos = skipString(pos);
+
+          if (pos == nullptr) { return nullptr; }
+          continue;
+        }
+
+        if ((c == '{') || (c == '[')) {
+          if (depth >= 64) { return nullptr; }
+          nesting = (nesting << 1) | (c == '{' ? 1 : 0);
+          ++depth;
+        } else if ((c == '}') || (c == ']')) {
+          if ((nesting & 1) != (c == '}' ? 1u : 0u)) { return nullptr; }
+          nesting >>= 1;
+          --depth;
+
+          if (depth == 0) { return pos + 1; }
+        }
+        ++pos;
+      }
+      return nullptr;
+    }
+  }
+
+  // Number, true, false or null
+  if ((strchr_P(PSTR("-0123456789tfn"), *pos) == nullptr)) { return nullptr; }
+  ++pos;
+
+  while (pos < _end && strchr_P(PSTR(",}] \t\r\n"), *pos) == nullptr) {
+    ++pos;
+  }
+  return pos;
+}
+
+const char * JSON_StreamScanner::findMember(const char *object, const char *key, size_t keyLength) const
+{
+  const char *pos = object + 1;
+
+  while (true) {
+    pos = skipWhitespace(pos);
+
+    if ((pos >= _end) || (*pos != '"')) { return nullptr; }
+    const char *keyEnd = skipString(pos);
+
+    if (keyEnd == nullptr) { return nullptr; }
+    const char *valueStart = skipWhitespace(keyEnd);
+
+    if ((valueStart >= _end) || (*valueStart != ':')) { return nullptr; }
+    valueStart = skipWhitespace(valueStart + 1);
+
+    if (keyEquals(pos + 1, keyEnd - 1, key, keyLength)) {
+      return valueStart;
+    }
+    pos = skipValue(valueStart);
+
+    if (pos == nullptr) { return nullptr; }
+    pos = skipWhitespace(pos);
+
+    if ((pos >= _end) || (*pos != ',')) { return nullptr; }
+    ++pos;
+  }
+}
+
+const char * JSON_StreamScanner::findElement(const char *array, size_t index) const
+{
+  const char *pos = skipWhitespace(array + 1);
+
+  if ((pos >= _end) || (*pos == ']')) { return nullptr; }
+
+  for (size_t i = 0; i < index; ++i) {
+    pos = skipValue(pos);
+
+    if (pos == nullptr) { return nullptr; }
+    pos = skipWhitespace(pos);
+
+    if ((pos >= _end) || (*pos != ',')) { return nullptr; }
+    pos = skipWhitespace(pos + 1);
+  }
+  return pos;
+}
+
+void JSON_StreamScanner::appendValue(const char *start, const char *end, String& value) const
+{
+  if (*start == '"') {
+    appendUnescaped(start + 1, end - 1, value);
+  } else {
+    value.concat(start, end - start);
+  }
+}
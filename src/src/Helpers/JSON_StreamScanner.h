@@ -0,0 +1,75 @@
+#ifndef HELPERS_JSON_STREAMSCANNER_H
+#define HELPERS_JSON_STREAMSCANNER_H
+
+#include "../../ESPEasy_common.h"
+
+/*********************************************************************************************\
+* JSON_StreamScanner
+*
+* Extracts values from a JSON document directly from the source buffer, without building
+* a document tree. Only the requested members are scanned for, all other values are skipped.
+* The source buffer is not copied, so it must remain valid while the scanner is used.
+*
+* Values are returned as text, like ArduinoJson's as<String>():
+* - strings are unescaped
+* - numbers, true, false and null as found in the source
+* - objects and arrays as their (unparsed) JSON text
+\*********************************************************************************************/
+class JSON_StreamScanner {
+public:
+
+  JSON_StreamScanner() = default;
+
+  JSON_StreamScanner(const char *json,
+                     size_t      length);
+
+  void setSource(const char *json,
+                 size_t      length);
+
+  void clear();
+
+  // Check the source is a single, well formed JSON object.
+  bool isObject() const;
+
+  // Get the value of a member, nested members separated by a '.', e.g. "a.b.c"
+  // Numerical path elements can be used as array index, e.g. "a.0"
+  bool getValue(const String& path,
+                String      & value) const;
+
+  // Iterate over the members of the top level object.
+  void rewind();
+
+  bool atEnd() const;
+
+  // Returns false when no more members are present, key and value are cleared then.
+  bool next(String& key,
+            String& value);
+
+private:
+
+  const char* skipWhitespace(const char *pos) const;
+
+  // pos at the opening quote, returns the position after the closing quote.
+  const char* skipString(const char *pos) const;
+
+  // Returns the position after the value, or nullptr when not well formed.
+  const char* skipValue(const char *pos) const;
+
+  // Returns the start of the member's value, or nullptr when not found.
+  const char* findMember(const char *object,
+                         const char *key,
+                         size_t      keyLength) const;
+
+  const char* findElement(const char *array,
+                          size_t      index) const;
+
+  void        appendValue(const char *start,
+                          const char *end,
+                          String    & value) const;
+
+  const char *_json = nullptr;
+  const char *_end  = nullptr;
+  const char *_pos  = nullptr; // Iteration position in top level object
+};
+
+#endif // ifndef HELPERS_JSON_STREAMSCANNER_H
@@ -1492,6 +1492,27 @@ void log_http_result(const HTTPClient& http,
 }
 #endif
 
+// On ESP8266 HTTPClient::begin() replaces its copy of the client, which closes a kept-alive connection.
+// So when still connected (only when the caller keeps the HTTPClient for the same host), only the URI is updated.
+void http_begin(WiFiClient  & client,
+                HTTPClient  & http,
+                const String& host,
+                uint16_t      port,
+                const String& uri)
+{
+#if defined(ESP8266) && defined(CORE_POST_2_6_0)
+
+  if (http.connected() && uri.startsWith(F("/")) && http.setURL(uri)) {
+    return;
+  }
+#endif // if defined(ESP8266) && defined(CORE_POST_2_6_0)
+#if defined(CORE_POST_2_6_0) || defined(ESP32)
+  http.begin(client, host, port, uri, false); // HTTP, not HTTPS
+#else // if defined(CORE_POST_2_6_0) || defined(ESP32)
+  http.begin(client, host, port, uri);
+#endif // if defined(CORE_POST_2_6_0) || defined(ESP32)
+}
+
 int http_authenticate(const String& logIdentifier,
                       WiFiClient  & client,
                       HTTPClient  & http,
@@ -1562,11 +1583,7 @@ int http_authenticate(const String& logIdentifier,
 
   delay(0);
   scrubDNS();
-#if defined(CORE_POST_2_6_0) || defined(ESP32)
-  http.begin(client, host, port, uri, false); // HTTP
-#else // if defined(CORE_POST_2_6_0) || defined(ESP32)
-  http.begin(client, host, port, uri);
-#endif // if defined(CORE_POST_2_6_0) || defined(ESP32)
+  http_begin(client, http, host, port, uri);
 
   const char *keys[] = { "WWW-Authenticate" };
   http.collectHeaders(keys, 1);
@@ -1614,11 +1631,7 @@ int http_authenticate(const String& logIdentifier,
       const String authorization = getDigestAuth(authReq, user, pass, F("GET"), uri, 1);
 
       http.end();
-#if defined(CORE_POST_2_6_0) || defined(ESP32)
-      http.begin(client, host, port, uri, false); // HTTP, not HTTPS
-#else // if defined(CORE_POST_2_6_0) || defined(ESP32)
-      http.begin(client, host, port, uri);
-#endif // if defined(CORE_POST_2_6_0) || defined(ESP32)
+      http_begin(client, http, host, port, uri);
 
       http.addHeader(F("Authorization"), authorization);
 
@@ -1706,6 +1719,43 @@ String send_via_http(const String& logIdentifier,
   HTTPClient http;
   http.setReuse(false);
 
+  String response = send_via_http(
+    logIdentifier,
+    client,
+    http,
+    timeout,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    HttpMethod,
+    header,
+    postStr,
+    httpCode,
+    must_check_reply);
+
+  // http.end() does not call client.stop() if it is no longer connected.
+  // However the client may still keep its internal state which may prevent 
+  // future connections to the same host until there has been a connection to another host inbetween.
+  client.stop(); 
+  return response;
+}
+
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply) {
   httpCode = http_authenticate(
     logIdentifier,
     client,
@@ -1731,11 +1781,8 @@ String send_via_http(const String& logIdentifier,
     }
 #endif
   }
+  // Connection is kept open when reuse is set and the server did not request to close it.
   http.end();
-  // http.end() does not call client.stop() if it is no longer connected.
-  // However the client may still keep its internal state which may prevent 
-  // future connections to the same host until there has been a connection to another host inbetween.
-  client.stop(); 
   return response;
 }
 #endif // FEATURE_HTTP_CLIENT
@@ -219,6 +219,13 @@ String splitURL(const String& fullURL, String& user, String& pass, String& host,
 
 
 #if FEATURE_HTTP_CLIENT
+// Start a request, keeping the connection of a reused HTTPClient open.
+void http_begin(WiFiClient  & client,
+                HTTPClient  & http,
+                const String& host,
+                uint16_t      port,
+                const String& uri);
+
 // Initiate the HTTP connection.
 // Also try to authenticate using either Basic auth or Digest.
 // @retval HTTP return code.
@@ -249,6 +256,24 @@ String send_via_http(const String& logIdentifier,
                      const String& postStr,
                      int         & httpCode,
                      bool          must_check_reply);
+
+// Send using the given client, which may already be connected.
+// The connection is not closed afterwards when http.setReuse(true) was called
+// and the server allows to keep the connection alive.
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply);
 #endif // FEATURE_HTTP_CLIENT
 
 #if FEATURE_DOWNLOAD
@@ -21,6 +21,7 @@
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/EventQueue.h"
+#include "../Globals/HTTPConnectionPool.h"
 #include "../Globals/MainLoopCommand.h"
 #include "../Globals/MQTT.h"
 #include "../Globals/NetworkState.h"
@@ -31,6 +32,7 @@
 #include "../Globals/WiFi_AP_Candidates.h"
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/FS_Helper.h"
+#include "../Helpers/Hardware_I2C.h"
 #include "../Helpers/Hardware_temperature_sensor.h"
 #include "../Helpers/Memory.h"
 #include "../Helpers/Misc.h"
@@ -145,6 +147,9 @@ void runOncePerSecond()
     }
     cmd_within_mainloop = 0;
   }
+#if FEATURE_HTTP_CONNECTION_POOL
+  HTTPConnections.closeIdle();
+#endif
   // clock events
   if (node_time.reportNewMinute()) {
     String dummy;
@@ -172,6 +177,7 @@ void runOncePerSecond()
   // I2C Watchdog feed
   if (Settings.WDI2CAddress != 0)
   {
+    I2CSelectDefaultBusState();
     I2C_write8(Settings.WDI2CAddress, 0xA5);
   }
 
@@ -299,9 +305,21 @@ void processMQTTdelayQueue() {
   }
 
   START_TIMER;
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  MQTTDelayHandler->restoreFromSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
 
-  if (element == nullptr) { return; }
+  if (element == nullptr) {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+    if (MQTTDelayHandler->getSpillCount() != 0) {
+      // Check again later whether the stored elements can be restored.
+      scheduleNextMQTTdelayQueue();
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+    return;
+  }
 
   bool handled = false;
 
@@ -320,7 +338,15 @@ void processMQTTdelayQueue() {
     }
   } else
   if (!handled) {
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    const uint64_t publishStart = getMicros64();
+    const bool     published    = MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained);
+    MQTTDelayHandler->registerSendResult(published, usecPassedSince(publishStart));
+
+    if (published) {
+#else // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
     if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
       if (WiFiEventData.connectionFailures > 0) {
         --WiFiEventData.connectionFailures;
       }
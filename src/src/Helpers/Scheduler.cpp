@@ -8,6 +8,7 @@
 
 #include "../ESPEasyCore/ESPEasyRules.h"
 
+#include "../Globals/CooperativeScheduler.h"
 #include "../Globals/RTC.h"
 
 #include "../Helpers/ESPEasyRTC.h"
@@ -52,10 +53,10 @@ void ESPEasy_Scheduler::handle_schedule() {
     // Events are not that important to run immediately.
     // Make sure normal scheduled jobs run at higher priority.
     // backgroundtasks();
-    process_system_event_queue();
-
-    // System events may have added one or more rule events, try to process those
-    processNextEvent();
+    // System events, rules events, etc. are processed as background jobs,
+    // each within their own time budget.
+    // System events may add one or more rule events, so those are dispatched in order of priority.
+    BackgroundJobs.run();
     last_system_event_run = millis();
     STOP_TIMER(HANDLE_SCHEDULER_IDLE);
     return;
@@ -99,6 +100,18 @@ String ESPEasy_Scheduler::getQueueStats() {
   return msecTimerHandler.getQueueStats();
 }
 
+size_t ESPEasy_Scheduler::getTimerQueueLength() const {
+  return msecTimerHandler.getQueueLength();
+}
+
+unsigned long ESPEasy_Scheduler::getMaxTimerQueueLength() const {
+  return msecTimerHandler.getMaxQueueLength();
+}
+
+size_t ESPEasy_Scheduler::getSystemEventQueueLength() const {
+  return ScheduledEventQueue.size();
+}
+
 void ESPEasy_Scheduler::updateIdleTimeStats() {
   msecTimerHandler.updateIdleTimeStats();
 }
@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/EventStructCommandWrapper.h"
+#include "../DataStructs/ObjectPool.h"
 #include "../DataStructs/SchedulerTimerID.h"
 #include "../DataStructs/SystemTimerStruct.h"
 
@@ -228,6 +229,10 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
   void process_task_device_timer(SchedulerTimerID timerID,
                                  unsigned long lasttimer);
 
+  // Run the due task device timers of other I2C tasks with the same I2C bus configuration,
+  // so the multiplexer channel and clock speed do not need to be switched in between.
+  void process_task_device_timers_same_I2C_bus(taskIndex_t task_index);
+
   /*********************************************************************************************\
   * System Event Timer
   * Handling of these events will be asynchronous and being called from the loop().
@@ -241,8 +246,11 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
                                         struct EventStruct&& event);
 
 #if FEATURE_MQTT
+
+  // Schedule a single event for an incoming MQTT message.
+  // It will be dispatched to all tasks with a matching subscription in MQTTimport_subscriptions,
+  // all sharing the same topic and payload.
   void schedule_mqtt_plugin_import_event_timer(deviceIndex_t  DeviceIndex,
-                                               taskIndex_t    TaskIndex,
                                                uint8_t        Function,
                                                const char    *c_topic,
                                                const uint8_t *b_payload,
@@ -281,7 +289,9 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
                             uint8_t              Function,
                             struct EventStruct&& event);
 
-  void process_system_event_queue();
+  // Process a single event from the system event queue.
+  // Return true when an event was processed.
+  bool process_system_event_queue();
 
 
   /*********************************************************************************************\
@@ -290,6 +300,12 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
 
   String getQueueStats();
 
+  size_t getTimerQueueLength() const;
+
+  unsigned long getMaxTimerQueueLength() const;
+
+  size_t getSystemEventQueueLength() const;
+
   void   updateIdleTimeStats();
 
   float  getIdleTimePct() const;
@@ -304,7 +320,7 @@ private:
 
   msecTimerHandlerStruct msecTimerHandler;
 
-  std::list<EventStructCommandWrapper>ScheduledEventQueue;
+  PooledList<EventStructCommandWrapper, ObjectPool_e::ScheduledEvents>ScheduledEventQueue;
 
   unsigned long last_system_event_run         = 0;
   unsigned long timer_gratuitous_arp_interval = 5000;
@@ -5,8 +5,10 @@
 
 #include "../Globals/CPlugins.h"
 #include "../Globals/Device.h"
+#include "../Globals/MQTT.h"
 #include "../Globals/NPlugins.h"
 #include "../Globals/RTC.h"
+#include "../Globals/Settings.h"
 
 #include "../Helpers/_Plugin_init.h"
 #include "../Helpers/ESPEasyRTC.h"
@@ -35,13 +37,13 @@ void ESPEasy_Scheduler::schedule_plugin_task_event_timer(
 #if FEATURE_MQTT
 void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
   deviceIndex_t  DeviceIndex,
-  taskIndex_t    TaskIndex,
   uint8_t        Function,
   const char    *c_topic,
   const uint8_t *b_payload,
   unsigned int   length) {
   if (validDeviceIndex(DeviceIndex)) {
-    EventStruct  event(TaskIndex);
+    // TaskIndex and Par1 are set per matching task when processing the event
+    EventStruct  event;
     const size_t topic_length = strlen_P(c_topic);
 
     if (!(reserve_special(event.String1, topic_length) &&
@@ -155,12 +157,12 @@ void ESPEasy_Scheduler::schedule_event_timer(
   ScheduledEventQueue.emplace_back(timerID.mixed_id, std::move(event));
 }
 
-void ESPEasy_Scheduler::process_system_event_queue() {
+bool ESPEasy_Scheduler::process_system_event_queue() {
   #ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
   #endif // ifdef USE_SECOND_HEAP
 
-  if (ScheduledEventQueue.size() == 0) { return; }
+  if (ScheduledEventQueue.size() == 0) { return false; }
 
   START_TIMER
 
@@ -190,6 +192,25 @@ void ESPEasy_Scheduler::process_system_event_queue() {
       const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(Index);
 
       if (validDeviceIndex(deviceIndex)) {
+        #if FEATURE_MQTT
+
+        if (Function == PLUGIN_MQTT_IMPORT) {
+          EventStruct& event = ScheduledEventQueue.front().event;
+
+          // Par1 holds the bitmask of the task values with a matching subscription
+          MQTTimport_subscriptions.forEachMatchingTask(
+            event.String1.c_str(),
+            [&](taskIndex_t taskIndex, uint8_t valueMask) {
+            if (Settings.TaskDeviceEnabled[taskIndex]) {
+              event.setTaskIndex(taskIndex);
+              event.Par1 = valueMask;
+              PluginCall(deviceIndex, Function, &event, tmpString);
+            }
+          });
+          break;
+        }
+        #endif // if FEATURE_MQTT
+
         if (((Function != PLUGIN_READ) &&
              (Function != PLUGIN_MQTT_CONNECTION_STATE) &&
              (Function != PLUGIN_MQTT_IMPORT))
@@ -220,4 +241,5 @@ void ESPEasy_Scheduler::process_system_event_queue() {
   }
   ScheduledEventQueue.pop_front();
   STOP_TIMER(PROCESS_SYSTEM_EVENT_QUEUE);
+  return true;
 }
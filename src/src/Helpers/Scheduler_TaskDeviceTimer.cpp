@@ -4,6 +4,7 @@
 #include "../DataStructs/Scheduler_TaskDeviceTimerID.h"
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/Controller.h"
+#include "../Globals/Plugins.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/DeepSleep.h"
 
@@ -90,4 +91,31 @@ void ESPEasy_Scheduler::process_task_device_timer(SchedulerTimerID timerID, unsi
 
   SensorSendTask(&TempEvent, 0, lasttimer);
   STOP_TIMER(SENSOR_SEND_TASK);
+
+  process_task_device_timers_same_I2C_bus(task_index);
+}
+
+void ESPEasy_Scheduler::process_task_device_timers_same_I2C_bus(taskIndex_t task_index) {
+  const int16_t I2C_bus_config = getI2C_bus_config_by_taskIndex(task_index);
+
+  if (I2C_bus_config < 0) { return; }
+
+  for (taskIndex_t task = 0; task < TASKS_MAX; ++task) {
+    if ((task != task_index) && (getI2C_bus_config_by_taskIndex(task) == I2C_bus_config)) {
+      const TaskDeviceTimerID timerID(task);
+      unsigned long timer = 0;
+
+      if (msecTimerHandler.getTimerForId(timerID.mixed_id, timer) && (timePassedSince(timer) >= 0)) {
+        // Task is due, so run it now instead of from the timer queue.
+        msecTimerHandler.remove(timerID.mixed_id);
+        delay(0);
+
+        START_TIMER;
+        struct EventStruct TempEvent(task);
+
+        SensorSendTask(&TempEvent, 0, timer);
+        STOP_TIMER(SENSOR_SEND_TASK);
+      }
+    }
+  }
 }
@@ -0,0 +1,221 @@
+#include "../Helpers/Ser2Net_Bridge.h"
+
+#ifdef USES_P020
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+# include "../WebServer/HTML_wrappers.h"
+# include "../WebServer/Markup.h"
+
+bool Ser2Net_Bridge::begin(ESPeasySerial *serial, size_t serialBufferSize, size_t netBufferSize)
+{
+  _serial = serial;
+  _serialRx.release();
+  _netRx.release();
+
+  bool res = _netRx.allocate(netBufferSize);
+
+  if (serialBufferSize > 0) {
+    res &= _serialRx.allocate(serialBufferSize);
+  }
+  _statsTime = millis();
+  return res;
+}
+
+void Ser2Net_Bridge::end()
+{
+  _serial = nullptr;
+  _serialRx.release();
+  _netRx.release();
+}
+
+void Ser2Net_Bridge::setFlushThresholds(size_t flushSize, uint16_t idleTime_ms)
+{
+  _flushSize = flushSize;
+  _idleTime  = idleTime_ms;
+}
+
+bool Ser2Net_Bridge::acceptClient(WiFiServer *server)
+{
+  if ((nullptr == server) || !server->hasClient()) { return false; }
+
+  // Use a free slot, or else the one connected the longest
+  uint8_t slot = 0;
+
+  for (uint8_t i = 0; i < SER2NET_MAX_CLIENTS; ++i) {
+    if (!_clients[i].connected()) {
+      slot = i;
+      break;
+    }
+
+    if (timePassedSince(_connectTime[i]) > timePassedSince(_connectTime[slot])) {
+      slot = i;
+    }
+  }
+
+  if (_clients[slot]) { _clients[slot].stop(); }
+  # if ESP_IDF_VERSION_MAJOR >= 5
+  _clients[slot] = server->accept();
+  # else // if ESP_IDF_VERSION_MAJOR >= 5
+  _clients[slot] = server->available();
+  # endif // if ESP_IDF_VERSION_MAJOR >= 5
+
+  # ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
+
+  // See: https://github.com/espressif/arduino-esp32/pull/6676
+  _clients[slot].setTimeout((CONTROLLER_CLIENTTIMEOUT_DFLT + 500) / 1000); // in seconds!!!!
+  Client *pClient = &_clients[slot];
+  pClient->setTimeout(CONTROLLER_CLIENTTIMEOUT_DFLT);
+  # else // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
+  _clients[slot].setTimeout(CONTROLLER_CLIENTTIMEOUT_DFLT); // in msec as it should be!
+  # endif // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
+
+  // Send data right away, the buffering is done here
+  _clients[slot].setNoDelay(true);
+  _connectTime[slot] = millis();
+  return true;
+}
+
+uint8_t Ser2Net_Bridge::checkClients()
+{
+  uint8_t res = 0;
+
+  for (uint8_t i = 0; i < SER2NET_MAX_CLIENTS; ++i) {
+    if (_clients[i].connected()) {
+      ++res;
+    } else if (_clients[i]) {
+      _clients[i].stop();
+    }
+  }
+  return res;
+}
+
+void Ser2Net_Bridge::stopClients()
+{
+  for (uint8_t i = 0; i < SER2NET_MAX_CLIENTS; ++i) {
+    if (_clients[i]) { _clients[i].stop(); }
+  }
+}
+
+void Ser2Net_Bridge::netToSerial()
+{
+  if ((nullptr == _serial) || (_netRx.capacity() == 0)) { return; }
+
+  // Data not fitting in the buffer is kept by the client, until there is room
+  for (uint8_t i = 0; i < SER2NET_MAX_CLIENTS && !_netRx.isFull(); ++i) {
+    if (_clients[i].available() > 0) {
+      _netRx.readFrom(_clients[i], _netRx.room());
+    }
+  }
+
+  if (!_netRx.isEmpty()) {
+    const int serialRoom = _serial->availableForWrite();
+
+    if (serialRoom > 0) {
+      _netBytes += _netRx.writeTo(*_serial, serialRoom);
+    }
+  }
+}
+
+size_t Ser2Net_Bridge::serialToNet()
+{
+  if ((nullptr == _serial) || !hasSerialBuffer()) { return 0; }
+  size_t res = 0;
+
+  // Limit the amount of data handled in a single call, when data keeps coming in.
+  while (res < 4 * _serialRx.capacity()) {
+    const bool   wasEmpty  = _serialRx.isEmpty();
+    const size_t bytesRead = _serialRx.readFrom(*_serial, _serialRx.room());
+
+    if (bytesRead > 0) {
+      _lastSerialRx = millis();
+
+      if (wasEmpty) { _firstBuffered = _lastSerialRx; }
+      res += bytesRead;
+    }
+
+    if (_serialRx.isEmpty() || (!_serialRx.isFull() && (_serialRx.available() < _flushSize))) {
+      break;
+    }
+    flushSerialRx();
+  }
+
+  if (!_serialRx.isEmpty() && (timePassedSince(_lastSerialRx) >= _idleTime)) {
+    flushSerialRx();
+  }
+  return res;
+}
+
+void Ser2Net_Bridge::flushSerialRx()
+{
+  const uint32_t latency = timePassedSince(_firstBuffered);
+
+  _latencySum += latency;
+
+  if (latency > _latencyMax) { _latencyMax = latency; }
+  ++_flushCount;
+
+  while (!_serialRx.isEmpty()) {
+    const uint8_t *data = nullptr;
+    const size_t   length = _serialRx.peek(data);
+
+    send(data, length);
+    _serialRx.consume(length);
+  }
+}
+
+void Ser2Net_Bridge::send(const uint8_t *data, size_t length)
+{
+  for (uint8_t i = 0; i < SER2NET_MAX_CLIENTS; ++i) {
+    if (_clients[i].connected()) {
+      const size_t written = _clients[i].write(data, length);
+
+      if (written < length) {
+        _droppedBytes += length - written;
+      }
+    }
+  }
+  _serialBytes += length;
+}
+
+void Ser2Net_Bridge::send(const String& data)
+{
+  send(reinterpret_cast<const uint8_t *>(data.c_str()), data.length());
+}
+
+void Ser2Net_Bridge::updateStats()
+{
+  const long duration = timePassedSince(_statsTime);
+
+  if (duration <= 0) { return; }
+
+  _serialRate      = static_cast<uint64_t>(_serialBytes - _prevSerialBytes) * 1000 / duration;
+  _netRate         = static_cast<uint64_t>(_netBytes - _prevNetBytes) * 1000 / duration;
+  _prevSerialBytes = _serialBytes;
+  _prevNetBytes    = _netBytes;
+  _statsTime       = millis();
+}
+
+void Ser2Net_Bridge::webformShowStats()
+{
+  addRowLabel(F("Clients connected"));
+  addHtmlInt(checkClients());
+
+  addRowLabel(F("Serial to network"));
+  addHtml(strformat(F("%u bytes, %u bytes/sec"), _serialBytes, _serialRate));
+
+  addRowLabel(F("Network to serial"));
+  addHtml(strformat(F("%u bytes, %u bytes/sec"), _netBytes, _netRate));
+
+  if (_flushCount > 0) {
+    addRowLabel(F("Serial send delay (avg/max)"));
+    addHtml(strformat(F("%u / %u msec"), _latencySum / _flushCount, _latencyMax));
+  }
+
+  if (_droppedBytes > 0) {
+    addRowLabel(F("Bytes not accepted by client"));
+    addHtmlInt(_droppedBytes);
+  }
+}
+
+#endif // ifdef USES_P020
@@ -0,0 +1,110 @@
+#ifndef HELPERS_SER2NET_BRIDGE_H
+#define HELPERS_SER2NET_BRIDGE_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USES_P020
+
+# include "../Helpers/ByteRingBuffer.h"
+
+# include <ESPeasySerial.h>
+# include <WiFiClient.h>
+# include <WiFiServer.h>
+
+# ifndef SER2NET_MAX_CLIENTS
+#  ifdef ESP8266
+#   define SER2NET_MAX_CLIENTS      2
+#  else // ifdef ESP8266
+#   define SER2NET_MAX_CLIENTS      4
+#  endif // ifdef ESP8266
+# endif // ifndef SER2NET_MAX_CLIENTS
+
+# ifndef SER2NET_NET_BUFFER_SIZE
+#  define SER2NET_NET_BUFFER_SIZE   512 // Buffer for data received from the network clients
+# endif // ifndef SER2NET_NET_BUFFER_SIZE
+
+/*********************************************************************************************\
+* Ser2Net_Bridge: Pass data between a serial port and (multiple) network clients
+*
+* Data is moved in blocks using fixed size ring buffers.
+* Serial data is sent to the clients when the flush size is buffered, or when no data
+* was received during the idle time.
+\*********************************************************************************************/
+class Ser2Net_Bridge {
+public:
+
+  Ser2Net_Bridge() = default;
+
+  // Buffer size 0 for the serial data: Only use send() to send data to the clients.
+  bool begin(ESPeasySerial *serial,
+             size_t         serialBufferSize,
+             size_t         netBufferSize);
+  void end();
+
+  bool hasSerialBuffer() const {
+    return _serialRx.capacity() > 0;
+  }
+
+  void setFlushThresholds(size_t   flushSize,
+                          uint16_t idleTime_ms);
+
+  // Accept a waiting client from the server.
+  // When all slots are in use, the client connected the longest is replaced.
+  // Returns true when a client was accepted.
+  bool    acceptClient(WiFiServer *server);
+
+  // Stop disconnected clients, returns the nr of connected clients
+  uint8_t checkClients();
+
+  void    stopClients();
+
+  // Move data received from the clients to the serial port, as far as the serial port can take it
+  void    netToSerial();
+
+  // Read the received serial data and send to the clients when a flush threshold is reached.
+  // Returns the nr of bytes read from the serial port.
+  size_t  serialToNet();
+
+  // Send to all connected clients
+  void    send(const uint8_t *data,
+               size_t         length);
+  void    send(const String& data);
+
+  // Compute the throughput, call once a second
+  void    updateStats();
+
+  void    webformShowStats();
+
+private:
+
+  void flushSerialRx();
+
+  ESPeasySerial *_serial = nullptr;
+  WiFiClient     _clients[SER2NET_MAX_CLIENTS];
+  unsigned long  _connectTime[SER2NET_MAX_CLIENTS] = {};
+
+  ByteRingBuffer _serialRx; // From serial to network
+  ByteRingBuffer _netRx;    // From network to serial
+
+  size_t        _flushSize     = 0;
+  uint16_t      _idleTime      = 0;
+  unsigned long _lastSerialRx  = 0; // Time the last serial data was received
+  unsigned long _firstBuffered = 0; // Time the oldest data in _serialRx was received
+
+  // Statistics
+  uint32_t      _serialBytes     = 0; // Serial to network
+  uint32_t      _netBytes        = 0; // Network to serial
+  uint32_t      _droppedBytes    = 0; // Not accepted by a client
+  uint32_t      _serialRate      = 0; // Bytes per second
+  uint32_t      _netRate         = 0;
+  uint32_t      _prevSerialBytes = 0;
+  uint32_t      _prevNetBytes    = 0;
+  unsigned long _statsTime       = 0;
+  uint32_t      _flushCount      = 0;
+  uint32_t      _latencySum      = 0; // msec from receiving serial data until sent to the clients
+  uint32_t      _latencyMax      = 0;
+};
+
+#endif // ifdef USES_P020
+
+#endif // ifndef HELPERS_SER2NET_BRIDGE_H
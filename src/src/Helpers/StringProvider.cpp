@@ -130,6 +130,9 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     #if FEATURE_I2C_DEVICE_CHECK
     case LabelType::ENABLE_I2C_DEVICE_CHECK:    return F("Check I2C devices when enabled");
     #endif // if FEATURE_I2C_DEVICE_CHECK
+    #if FEATURE_CONTROLLER_WORKER_TASK
+    case LabelType::CONTROLLER_WORKER_TASK:     return F("Controller queues in worker task");
+    #endif // if FEATURE_CONTROLLER_WORKER_TASK
 #ifndef BUILD_NO_RAM_TRACKER
     case LabelType::ENABLE_RAM_TRACKING:    return F("Enable RAM Tracker");
 #endif
@@ -423,6 +426,9 @@ String getValue(LabelType::Enum label) {
 #if FEATURE_I2C_DEVICE_CHECK
     case LabelType::ENABLE_I2C_DEVICE_CHECK:    return jsonBool(Settings.CheckI2Cdevice());
 #endif // if FEATURE_I2C_DEVICE_CHECK
+#if FEATURE_CONTROLLER_WORKER_TASK
+    case LabelType::CONTROLLER_WORKER_TASK:     return jsonBool(Settings.ControllerWorkerTask());
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
 #ifndef BUILD_NO_RAM_TRACKER
     case LabelType::ENABLE_RAM_TRACKING:        return jsonBool(Settings.EnableRAMTracking());
 #endif
@@ -698,6 +704,11 @@ String getFormNote(LabelType::Enum label)
       flash_str = F("Toggling IPv6 requires reboot");
       break;
 #endif // if FEATURE_USE_IPV6
+#if FEATURE_CONTROLLER_WORKER_TASK
+    case LabelType::CONTROLLER_WORKER_TASK:
+      flash_str = F("Experimental: Send controller data from a separate task. Requires reboot to activate");
+      break;
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
 #ifndef NO_HTTP_UPDATER
     case LabelType::ALLOW_OTA_UNLIMITED:
       flash_str = F("When enabled, OTA updating can overwrite the filesystem and settings!<br>Requires reboot to activate");
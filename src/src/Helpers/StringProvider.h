@@ -78,6 +78,9 @@ struct LabelType {
     #if FEATURE_I2C_DEVICE_CHECK
     ENABLE_I2C_DEVICE_CHECK,
     #endif // if FEATURE_I2C_DEVICE_CHECK
+    #if FEATURE_CONTROLLER_WORKER_TASK
+    CONTROLLER_WORKER_TASK,
+    #endif // if FEATURE_CONTROLLER_WORKER_TASK
 #ifndef BUILD_NO_RAM_TRACKER
     ENABLE_RAM_TRACKING,
 #endif
@@ -20,6 +20,11 @@
 #include "../Globals/Settings.h"
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/HTTPConnectionPool.h"
+
+#if FEATURE_CONTROLLER_WORKER_TASK
+# include "../ControllerQueue/ControllerWorker.h"
+#endif
 
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Misc.h"
@@ -105,26 +110,58 @@ void log_connecting_fail(const __FlashStringHelper *prefix, cpluginID_t cpluginI
   }
 }
 
-bool count_connection_results(bool success, const __FlashStringHelper *prefix, cpluginID_t cpluginID, uint64_t statisticsTimerStart) {
-#if FEATURE_TIMING_STATS
-  const protocolIndex_t protocolIndex = getProtocolIndex_from_CPluginID(cpluginID);
-#endif
-
+void register_connection_result(bool success, const __FlashStringHelper *prefix, cpluginID_t cpluginID, uint32_t connectDuration_ms) {
   if (!success)
   {
     ++WiFiEventData.connectionFailures;
     log_connecting_fail(prefix, cpluginID);
-    STOP_TIMER_CONTROLLER(protocolIndex, CPlugin::Function::CPLUGIN_CONNECT_FAIL);
-    return false;
+    return;
   }
-  WiFiEventData.connectDurations[cpluginID] = usecPassedSince(statisticsTimerStart) / 1000ul;
-  STOP_TIMER_CONTROLLER(protocolIndex, CPlugin::Function::CPLUGIN_CONNECT_SUCCESS);
+  WiFiEventData.connectDurations[cpluginID] = connectDuration_ms;
   statusLED(true);
 
   if (WiFiEventData.connectionFailures > 0) {
     --WiFiEventData.connectionFailures;
   }
-  return true;
+}
+
+bool count_connection_results(bool success, const __FlashStringHelper *prefix, cpluginID_t cpluginID, uint64_t statisticsTimerStart) {
+#if FEATURE_TIMING_STATS
+  const protocolIndex_t protocolIndex = getProtocolIndex_from_CPluginID(cpluginID);
+#endif
+  const uint32_t connectDuration_ms = usecPassedSince(statisticsTimerStart) / 1000ul;
+
+  if (success) {
+    STOP_TIMER_CONTROLLER(protocolIndex, CPlugin::Function::CPLUGIN_CONNECT_SUCCESS);
+  } else {
+    STOP_TIMER_CONTROLLER(protocolIndex, CPlugin::Function::CPLUGIN_CONNECT_FAIL);
+  }
+
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+  if (ControllerWorker_inWorkerTask()) {
+    // Applied in the main loop when the job result is handled.
+    ControllerWorker_registerConnectResult(success, prefix, connectDuration_ms);
+    return success;
+  }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+  register_connection_result(success, prefix, cpluginID, connectDuration_ms);
+  return success;
+}
+
+// WiFiEventData may only be accessed from the main loop,
+// so the worker task uses the timeout suggested when the job was submitted.
+uint32_t getSuggestedTimeout(cpluginID_t cpluginID, const ControllerSettingsStruct& ControllerSettings) {
+  if (!ControllerSettings.MustCheckReply) {
+    return ControllerSettings.ClientTimeout;
+  }
+#if FEATURE_CONTROLLER_WORKER_TASK
+
+  if (ControllerWorker_inWorkerTask()) {
+    return ControllerWorker_getSuggestedTimeout(ControllerSettings.ClientTimeout);
+  }
+#endif // if FEATURE_CONTROLLER_WORKER_TASK
+  return WiFiEventData.getSuggestedTimeout(cpluginID, ControllerSettings.ClientTimeout);
 }
 
 bool try_connect_host(cpluginID_t cpluginID, WiFiUDP& client, ControllerSettingsStruct& ControllerSettings) {
@@ -139,9 +176,7 @@ bool try_connect_host(cpluginID_t cpluginID, WiFiUDP& client, ControllerSettings
   // For example because the server does not give an acknowledgement.
   // This way, we always need the set amount of timeout to handle the request.
   // Thus we should not make the timeout dynamic here if set to ignore ack.
-  const uint32_t timeout = ControllerSettings.MustCheckReply
-    ? WiFiEventData.getSuggestedTimeout(cpluginID, ControllerSettings.ClientTimeout)
-    : ControllerSettings.ClientTimeout;
+  const uint32_t timeout = getSuggestedTimeout(cpluginID, ControllerSettings);
 
   client.setTimeout(timeout); // in msec as it should be!
   delay(0);
@@ -186,9 +221,7 @@ bool try_connect_host(cpluginID_t                cpluginID,
   // For example because the server does not give an acknowledgement.
   // This way, we always need the set amount of timeout to handle the request.
   // Thus we should not make the timeout dynamic here if set to ignore ack.
-  const uint32_t timeout = ControllerSettings.MustCheckReply
-    ? WiFiEventData.getSuggestedTimeout(cpluginID, ControllerSettings.ClientTimeout)
-    : ControllerSettings.ClientTimeout;
+  const uint32_t timeout = getSuggestedTimeout(cpluginID, ControllerSettings);
 
   # ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
 
@@ -238,12 +271,15 @@ String send_via_http(int                             cpluginID,
   // For example because the server does not give an acknowledgement.
   // This way, we always need the set amount of timeout to handle the request.
   // Thus we should not make the timeout dynamic here if set to ignore ack.
-  const uint32_t timeout = ControllerSettings.MustCheckReply
-    ? WiFiEventData.getSuggestedTimeout(cpluginID, ControllerSettings.ClientTimeout)
-    : ControllerSettings.ClientTimeout;
+  const uint32_t timeout = getSuggestedTimeout(cpluginID, ControllerSettings);
 
   const uint64_t statisticsTimerStart(getMicros64());
+#if FEATURE_HTTP_CONNECTION_POOL
+  const String result                    = HTTPConnections.send(
+    controller_idx,
+#else
   const String result                    = send_via_http(
+#endif
     get_formatted_Controller_number(cpluginID),
     timeout,
     getControllerUser(controller_idx, ControllerSettings),
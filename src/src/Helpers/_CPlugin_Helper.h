@@ -38,8 +38,14 @@ void log_connecting_to(const __FlashStringHelper * prefix, cpluginID_t cpluginID
 
 void log_connecting_fail(const __FlashStringHelper * prefix, cpluginID_t cpluginID);
 
+// Update the connection statistics in WiFiEventData, must be called from the main loop.
+void register_connection_result(bool success, const __FlashStringHelper * prefix, cpluginID_t cpluginID, uint32_t connectDuration_ms);
+
 bool count_connection_results(bool success, const __FlashStringHelper * prefix, cpluginID_t cpluginID, uint64_t statisticsTimerStart);
 
+// Connect timeout based on the previous connection durations of the controller.
+uint32_t getSuggestedTimeout(cpluginID_t cpluginID, const ControllerSettingsStruct& ControllerSettings);
+
 #if FEATURE_HTTP_CLIENT
 bool try_connect_host(cpluginID_t cpluginID, WiFiUDP& client, ControllerSettingsStruct& ControllerSettings);
 
@@ -34,11 +34,18 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
     case ControllerSettingsStruct::CONTROLLER_PASS:                     return F("Controller Password");
 
     case ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL:        return F("Minimum Send Interval");
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:   return F("Adaptive Send Interval");
+    case ControllerSettingsStruct::CONTROLLER_MAX_SEND_INTERVAL:        return F("Maximum Send Interval");
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:          return F("Max Queue Depth");
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:              return F("Max Retries");
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:        return F("Full Queue Action");
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:             return F("Allow Expire");
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:              return F("De-duplicate");
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:           return F("Store on Flash When Full");
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:    return F("Use Local System Time");
 
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:              return F("Check Reply");
@@ -47,6 +54,7 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
 #if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT: return F("Unique Client ID on Reconnect");
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:               return F("Publish Retain Flag");
+    case ControllerSettingsStruct::CONTROLLER_PUBLISH_TASK_JSON:        return F("Publish Task Values as JSON");
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:                return F("Controller Subscribe");
     case ControllerSettingsStruct::CONTROLLER_PUBLISH:                  return F("Controller Publish");
@@ -287,6 +295,20 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
       addUnit(F("ms"));
       break;
     }
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:
+      addFormCheckBox(displayName, internalName, ControllerSettings.adaptiveSendInterval());
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_SEND_INTERVAL:
+    {
+      const unsigned int maxInterval = ControllerSettings.MaxTimeBetweenMessages == 0
+                                       ? CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_DFLT
+                                       : ControllerSettings.MaxTimeBetweenMessages;
+      addFormNumericBox(displayName, internalName, maxInterval, 1, CONTROLLER_DELAY_QUEUE_ADAPTIVE_DELAY_MAX);
+      addUnit(F("ms"));
+      break;
+    }
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:
     {
       addFormNumericBox(displayName, internalName, ControllerSettings.MaxQueueDepth, 1, CONTROLLER_DELAY_QUEUE_DEPTH_MAX);
@@ -312,6 +334,11 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:
       addFormCheckBox(displayName, internalName, ControllerSettings.deduplicate());
       break;
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:
+      addFormCheckBox(displayName, internalName, ControllerSettings.spillToFlash());
+      break;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       addFormCheckBox(displayName, internalName, ControllerSettings.useLocalSystemTime());
       break;
@@ -334,6 +361,9 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_retainFlag());
       break;
+    case ControllerSettingsStruct::CONTROLLER_PUBLISH_TASK_JSON:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_publishTaskJSON());
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       addFormTextBox(displayName, internalName, ControllerSettings.Subscribe, sizeof(ControllerSettings.Subscribe) - 1);
@@ -479,6 +509,14 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL:
       ControllerSettings.MinimalTimeBetweenMessages = getFormItemInt(internalName, ControllerSettings.MinimalTimeBetweenMessages);
       break;
+#if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:
+      ControllerSettings.adaptiveSendInterval(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_SEND_INTERVAL:
+      ControllerSettings.MaxTimeBetweenMessages = getFormItemInt(internalName, ControllerSettings.MaxTimeBetweenMessages);
+      break;
+#endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:
       ControllerSettings.MaxQueueDepth = getFormItemInt(internalName, ControllerSettings.MaxQueueDepth);
       break;
@@ -494,6 +532,11 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:
       ControllerSettings.deduplicate(isFormItemChecked(internalName));
       break;
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:
+      ControllerSettings.spillToFlash(isFormItemChecked(internalName));
+      break;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       ControllerSettings.useLocalSystemTime(isFormItemChecked(internalName));
       break;
@@ -510,6 +553,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       ControllerSettings.mqtt_retainFlag(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_PUBLISH_TASK_JSON:
+      ControllerSettings.mqtt_publishTaskJSON(isFormItemChecked(internalName));
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       strncpy_webserver_arg(ControllerSettings.Subscribe, internalName);
@@ -89,6 +89,7 @@ bool Internal_GPIO_pulseHelper::init()
 
 void Internal_GPIO_pulseHelper::getPulseCounters(unsigned long& pulseCounter, unsigned long& pulseTotalCounter, float& pulseTime_msec)
 {
+  processEdgeQueue();
   pulseCounter      = ISRdata.pulseCounter;
   pulseTotalCounter = ISRdata.pulseTotalCounter;
   pulseTime_msec    = static_cast<float>(ISRdata.pulseTime) / 1000.0f;
@@ -96,17 +97,20 @@ void Internal_GPIO_pulseHelper::getPulseCounters(unsigned long& pulseCounter, un
 
 void Internal_GPIO_pulseHelper::setPulseCountTotal(unsigned long pulseTotalCounter)
 {
+  processEdgeQueue();
   ISRdata.pulseTotalCounter = pulseTotalCounter;
 }
 
 void Internal_GPIO_pulseHelper::setPulseCounter(unsigned long pulseCounter, float pulseTime_msec)
 {
+  processEdgeQueue();
   ISRdata.pulseCounter = pulseCounter;
   ISRdata.pulseTime    = static_cast<uint64_t>(pulseTime_msec * 1000.0f);
 }
 
 void Internal_GPIO_pulseHelper::resetPulseCounter()
 {
+  processEdgeQueue();
   ISRdata.pulseCounter = 0;
   ISRdata.pulseTime    = 0;
 }
@@ -118,6 +122,11 @@ void Internal_GPIO_pulseHelper::doPulseStepProcessing(int pStep)
     case GPIO_PULSE_HELPER_PROCESSING_STEP_0:
       // regularily called to check if the trigger has flagged the next signal edge
     {
+      if (config.useEdgeMode()) {
+        processEdgeQueue();
+        break;
+      }
+
       if (ISRdata.initStepsFlags)
       {
         // schedule step 1 in remaining milliseconds from debounce time
@@ -360,6 +369,31 @@ void Internal_GPIO_pulseHelper::processStablePulse(int pinState, uint64_t pulseC
   ISRdata.processingFlags = false;
 }
 
+void Internal_GPIO_pulseHelper::processEdgeQueue()
+{
+  if (!config.useEdgeMode()) { return; }
+
+  uint64_t timestamp = 0;
+
+  while (edgeTimestamps.pop(timestamp)) {
+    ISRdata.pulseCounter++;
+    ISRdata.pulseTotalCounter++;
+    ISRdata.pulseTime = timestamp - lastEdgeTimestamp;
+    lastEdgeTimestamp = timestamp;
+  }
+
+  // When the loop was too slow to process all edges, the queue may have been full.
+  // These edges are still counted, only their timestamp is lost.
+  const uint32_t overflowCount = edgeTimestamps.getOverflowCount();
+
+  if (overflowCount != edgeOverflowProcessed) {
+    const uint32_t missed = overflowCount - edgeOverflowProcessed;
+    ISRdata.pulseCounter      += missed;
+    ISRdata.pulseTotalCounter += missed;
+    edgeOverflowProcessed      = overflowCount;
+  }
+}
+
 void IRAM_ATTR Internal_GPIO_pulseHelper::ISR_edgeCheck(Internal_GPIO_pulseHelper *self)
 {
   ISR_noInterrupts(); // s0170071: avoid nested interrups due to bouncing.
@@ -372,9 +406,9 @@ void IRAM_ATTR Internal_GPIO_pulseHelper::ISR_edgeCheck(Internal_GPIO_pulseHelpe
 
   if (timeSinceLastTrigger > self->config.debounceTime_micros) // check with debounce time for this task
   {
-    self->ISRdata.pulseCounter++;
-    self->ISRdata.pulseTotalCounter++;
-    self->ISRdata.pulseTime              = timeSinceLastTrigger;
+    // Counting is done in the loop, using the exact timestamp of every edge.
+    // When the queue is full, the edge is still counted via the overflow counter of the queue.
+    self->edgeTimestamps.push(currentTime);
     self->ISRdata.currentStableStartTime = currentTime; // reset when counted to determine interval between counted pulses
   }
   ISR_interrupts();                                     // enable interrupts again.
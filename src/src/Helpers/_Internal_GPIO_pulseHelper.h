@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/SPSC_Queue.h"
 #include "../DataTypes/TaskIndex.h"
 
 
@@ -31,6 +32,11 @@
 #define PULSE_MODE_MASK         0x30
 #define MODE_INTERRUPT_MASK     0x03
 
+// Number of counted edges which can be buffered between ISR and loop (edge mode only)
+#ifndef GPIO_PULSEHELPER_EDGE_QUEUE_SIZE
+  # define GPIO_PULSEHELPER_EDGE_QUEUE_SIZE 32 // Must be a power of 2
+#endif // ifndef GPIO_PULSEHELPER_EDGE_QUEUE_SIZE
+
 
 #if ESP_IDF_VERSION_MAJOR >= 5
 #include <atomic>
@@ -164,9 +170,19 @@ private:
   void     processStablePulse(int      pinState,
                               uint64_t pulseChangeTime);
 
+  /*********************************************************************************************\
+  *  Count the edges recorded by ISR_edgeCheck
+  \*********************************************************************************************/
+  void     processEdgeQueue();
+
   volatile pulseCounterISRdata_t ISRdata;
   const pulseCounterConfig       config;
 
+  // Timestamps of counted edges in edge mode. Filled by the ISR, processed in the loop.
+  SPSC_Queue<uint64_t, GPIO_PULSEHELPER_EDGE_QUEUE_SIZE> edgeTimestamps;
+  uint64_t lastEdgeTimestamp     = 0; // Timestamp of the last processed edge
+  uint32_t edgeOverflowProcessed = 0; // Number of edges which did not fit in the queue, already counted
+
   static void ISR_edgeCheck(Internal_GPIO_pulseHelper *self);
   static void ISR_pulseCheck(Internal_GPIO_pulseHelper *self);
 
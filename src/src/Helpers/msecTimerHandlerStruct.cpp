@@ -98,6 +98,14 @@
     return result;
   }
 
+  size_t msecTimerHandlerStruct::getQueueLength() const {
+    return _timer_ids.size();
+  }
+
+  unsigned long msecTimerHandlerStruct::getMaxQueueLength() const {
+    return max_queue_length;
+  }
+
   void msecTimerHandlerStruct::updateIdleTimeStats() {
     const long duration = timePassedSince(last_log_start_time);
 
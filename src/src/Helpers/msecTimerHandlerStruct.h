@@ -29,6 +29,11 @@ struct msecTimerHandlerStruct {
 
   String getQueueStats();
 
+  // Non-resetting statistics, e.g. for exporting metrics
+  size_t getQueueLength() const;
+
+  unsigned long getMaxQueueLength() const;
+
   void   updateIdleTimeStats();
 
   float  getIdleTimePct() const;
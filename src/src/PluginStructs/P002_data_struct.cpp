@@ -19,9 +19,20 @@
 # endif // ifndef P002_ADC_ATTEN_MAX
 
 
+P002_data_struct::~P002_data_struct()
+{
+# if FEATURE_ADC_CONTINUOUS
+
+  if (_useContinuous) {
+    ADC_continuous.removeChannel(_taskIndex);
+  }
+# endif // if FEATURE_ADC_CONTINUOUS
+}
+
 void P002_data_struct::init(struct EventStruct *event)
 {
   _sampleMode = P002_OVERSAMPLING;
+  _taskIndex  = event->TaskIndex;
 
   # ifdef ESP8266
   _pin_analogRead = A0;
@@ -55,6 +66,20 @@ void P002_data_struct::init(struct EventStruct *event)
 # endif // ifndef LIMIT_BUILD_SIZE
 }
 
+# if FEATURE_ADC_CONTINUOUS
+void P002_data_struct::startContinuousSampling(struct EventStruct *event)
+{
+  if (!P002_CONTINUOUS_SAMPLING) { return; }
+
+  _useContinuous = ADC_continuous.addChannel(event->TaskIndex, _pin_analogRead, _attenuation);
+
+  if (!_useContinuous) {
+    addLog(LOG_LEVEL_ERROR, F("ADC  : Continuous sampling not possible, using single reads"));
+  }
+}
+
+# endif // if FEATURE_ADC_CONTINUOUS
+
 # ifndef LIMIT_BUILD_SIZE
 void P002_data_struct::load(struct EventStruct *event)
 {
@@ -166,6 +191,7 @@ void P002_data_struct::webformLoad(struct EventStruct *event)
 # ifndef LIMIT_BUILD_SIZE
       , F("Binning")
 # endif // ifndef LIMIT_BUILD_SIZE
+      , F("RMS (AC)")
     };
     const int outputOptionValues[] = {
       P002_USE_CURENT_SAMPLE,
@@ -173,11 +199,25 @@ void P002_data_struct::webformLoad(struct EventStruct *event)
 # ifndef LIMIT_BUILD_SIZE
       , P002_USE_BINNING
 # endif // ifndef LIMIT_BUILD_SIZE
+      , P002_USE_RMS
     };
     constexpr int nrOptions = NR_ELEMENTS(outputOptionValues);
     addFormSelector(F("Oversampling"), F("oversampling"), nrOptions, outputOptions, outputOptionValues, P002_OVERSAMPLING);
+    addFormNote(F("RMS (AC): Root mean square with the average (DC offset) removed, multipoint processing is not applied"));
   }
 
+# if FEATURE_ADC_CONTINUOUS
+  addFormCheckBox(F("Continuous Sampling"), F("cont"), P002_CONTINUOUS_SAMPLING);
+  addFormNote(strformat(
+                F("ADC1 only, %u samples/sec shared by all tasks using continuous sampling. Other tasks cannot read ADC1."),
+                ADC_CONTINUOUS_SAMPLE_FREQ));
+
+  if (_useContinuous) {
+    addRowLabel(F("Samples per second"));
+    addHtmlInt(ADC_continuous.getSampleRate());
+  }
+# endif // if FEATURE_ADC_CONTINUOUS
+
 # ifdef ESP32
   addFormSubHeader(F("Factory Calibration"));
   addFormCheckBox(F("Apply Factory Calibration"), F("fac_cal"), P002_APPLY_FACTORY_CALIB, !hasADC_factory_calibration());
@@ -793,6 +833,9 @@ String P002_data_struct::webformSave(struct EventStruct *event)
   P002_APPLY_FACTORY_CALIB = isFormItemChecked(F("fac_cal"));
   P002_ATTENUATION         = getFormItemInt(F("attn"));
   # endif // ifdef ESP32
+  # if FEATURE_ADC_CONTINUOUS
+  P002_CONTINUOUS_SAMPLING = isFormItemChecked(F("cont"));
+  # endif // if FEATURE_ADC_CONTINUOUS
 
   // Map the input "point" values to the nearest int.
   setTwoPointCalibration(
@@ -840,8 +883,43 @@ String P002_data_struct::webformSave(struct EventStruct *event)
 
 void P002_data_struct::takeSample()
 {
+# if FEATURE_ADC_CONTINUOUS
+
+  if (_useContinuous) {
+    // Must be read at least every ADC_CONTINUOUS_BUFFER_MSEC, also when only the last sample is used,
+    // as the driver drops new conversions when its buffer is full.
+    // All samples taken since the last call are decimated into a single average,
+    // except for RMS, which needs all samples.
+    ADC_SampleAccumulator block;
+    ADC_continuous.process();
+
+    if (!ADC_continuous.takeSamples(_taskIndex, block)) { return; }
+
+    if (_sampleMode == P002_USE_CURENT_SAMPLE) { return; }
+
+#  if FEATURE_PLUGIN_STATS
+    PluginStats *stats = getPluginStats(0);
+
+    if (stats != nullptr) {
+      stats->trackPeak(block.getMin());
+      stats->trackPeak(block.getMax());
+    }
+#  endif // if FEATURE_PLUGIN_STATS
+
+    if (_sampleMode == P002_USE_RMS) {
+      _rmsSamples.add(block);
+    } else {
+      float average{};
+      block.getAverage(average);
+      addSample(lroundf(average));
+    }
+    return;
+  }
+# endif // if FEATURE_ADC_CONTINUOUS
+
   if (_sampleMode == P002_USE_CURENT_SAMPLE) { return; }
-  int raw = espeasy_analogRead(_pin_analogRead);
+
+  const int raw = espeasy_analogRead(_pin_analogRead);
 
 # if FEATURE_PLUGIN_STATS
   PluginStats *stats = getPluginStats(0);
@@ -851,6 +929,26 @@ void P002_data_struct::takeSample()
   }
 # endif // if FEATURE_PLUGIN_STATS
 
+  addSample(raw);
+}
+
+int P002_data_struct::readADC() const
+{
+# if FEATURE_ADC_CONTINUOUS
+
+  if (_useContinuous) {
+    // ADC1 cannot be read using analogRead while sampling continuously
+    int raw = 0;
+    ADC_continuous.process();
+    ADC_continuous.getLastSample(_taskIndex, raw);
+    return raw;
+  }
+# endif // if FEATURE_ADC_CONTINUOUS
+  return espeasy_analogRead(_pin_analogRead);
+}
+
+void P002_data_struct::addSample(int raw)
+{
   switch (_sampleMode) {
     case P002_USE_OVERSAMPLING:
       addOversamplingValue(raw);
@@ -860,6 +958,9 @@ void P002_data_struct::takeSample()
       addBinningValue(raw);
       break;
 # endif // ifndef LIMIT_BUILD_SIZE
+    case P002_USE_RMS:
+      _rmsSamples.add(raw);
+      break;
   }
 }
 
@@ -885,6 +986,9 @@ bool P002_data_struct::getValue(float& float_value,
       mustTakeSample = true;
       break;
 # endif // ifndef LIMIT_BUILD_SIZE
+    case P002_USE_RMS:
+      // A single sample has no AC component
+      return getRMSValue(float_value, raw_value);
     case P002_USE_CURENT_SAMPLE:
       mustTakeSample = true;
       break;
@@ -894,7 +998,7 @@ bool P002_data_struct::getValue(float& float_value,
     return false;
   }
 
-  raw_value = espeasy_analogRead(_pin_analogRead);
+  raw_value = readADC();
 # if FEATURE_PLUGIN_STATS
 
   PluginStats *stats = getPluginStats(0);
@@ -951,14 +1055,21 @@ void P002_data_struct::reset()
 
       break;
     }
+    case P002_USE_RMS:
+      _rmsSamples.reset();
+      break;
   }
 # else // ifndef LIMIT_BUILD_SIZE
   resetOversampling();
+  _rmsSamples.reset();
 # endif // ifndef LIMIT_BUILD_SIZE
 }
 
 uint32_t P002_data_struct::getOversamplingCount() const
 {
+  if (_sampleMode == P002_USE_RMS) {
+    return _rmsSamples.getCount();
+  }
   return OverSampling.getCount();
 }
 
@@ -974,15 +1085,8 @@ bool P002_data_struct::getOversamplingValue(float& float_value, int& raw_value)
   if (OverSampling.peek(float_value)) {
     raw_value = static_cast<int>(float_value);
 
-# ifdef ESP32
-
-    if (_useFactoryCalibration) {
-      float_value = applyADCFactoryCalibration(float_value, _attenuation);
-    }
-# endif // ifdef ESP32
-
     // We counted the raw oversampling values, so now we need to apply the calibration and multi-point processing
-    float_value = applyCalibration(float_value);
+    float_value = applyRawCalibration(float_value);
 # ifndef LIMIT_BUILD_SIZE
     float_value = applyMultiPointInterpolation(float_value);
 # endif // ifndef LIMIT_BUILD_SIZE
@@ -992,6 +1096,33 @@ bool P002_data_struct::getOversamplingValue(float& float_value, int& raw_value)
   return false;
 }
 
+bool P002_data_struct::getRMSValue(float& float_value, int& raw_value) const
+{
+  float average{};
+  float rms{};
+
+  if (!_rmsSamples.getAverage(average) || !_rmsSamples.getRMS(rms, true)) {
+    return false;
+  }
+  raw_value = lroundf(rms);
+
+  // The calibration does not pass through zero, so convert the RMS at the average level of the signal.
+  // For a linear calibration this is the same as scaling the RMS with the slope.
+  float_value = applyRawCalibration(average + rms) - applyRawCalibration(average);
+  return true;
+}
+
+float P002_data_struct::applyRawCalibration(float raw) const
+{
+# ifdef ESP32
+
+  if (_useFactoryCalibration) {
+    raw = applyADCFactoryCalibration(raw, _attenuation);
+  }
+# endif // ifdef ESP32
+  return applyCalibration(raw);
+}
+
 # ifndef LIMIT_BUILD_SIZE
 int P002_data_struct::getBinIndex(float currentValue) const
 {
@@ -1118,7 +1249,15 @@ float P002_data_struct::getCurrentValue(struct EventStruct *event, int& raw_valu
   const int pin = CONFIG_PIN1;
   # endif // ifdef ESP32
 
+  # if FEATURE_ADC_CONTINUOUS
+
+  // ADC1 cannot be read using analogRead while sampling continuously
+  if (!ADC_continuous.getLastSample(event->TaskIndex, raw_value)) {
+    raw_value = espeasy_analogRead(pin);
+  }
+  # else // if FEATURE_ADC_CONTINUOUS
   raw_value = espeasy_analogRead(pin);
+  # endif // if FEATURE_ADC_CONTINUOUS
 
   # ifdef ESP32
 
@@ -3,6 +3,8 @@
 
 #include "../../_Plugin_Helper.h"
 
+#include "../Helpers/ADC_SampleAccumulator.h"
+#include "../Helpers/Hardware_ADC_continuous.h"
 #include "../Helpers/OversamplingHelper.h"
 
 #ifdef USES_P002
@@ -27,6 +29,9 @@
 #  define P002_APPLY_FACTORY_CALIB  PCONFIG(1)
 #  define P002_ATTENUATION          PCONFIG(2)
 # endif // ifdef ESP32
+# if FEATURE_ADC_CONTINUOUS
+#  define P002_CONTINUOUS_SAMPLING  PCONFIG(6)
+# endif // if FEATURE_ADC_CONTINUOUS
 # define P002_CALIBRATION_ENABLED PCONFIG(3)
 # define P002_CALIBRATION_POINT1  PCONFIG_LONG(0)
 # define P002_CALIBRATION_POINT2  PCONFIG_LONG(1)
@@ -39,6 +44,7 @@
 # define P002_USE_CURENT_SAMPLE   0
 # define P002_USE_OVERSAMPLING    1
 # define P002_USE_BINNING         2
+# define P002_USE_RMS             3
 
 // FIXME TD-er: Must test if HTML POST on ESP8266 will not take too much ram on save
 # define P002_MAX_NR_MP_ITEMS     64
@@ -103,11 +109,17 @@ struct P002_binningRange {
 };
 
 struct P002_data_struct : public PluginTaskData_base {
-  P002_data_struct()          = default;
-  virtual ~P002_data_struct() = default;
+  P002_data_struct() = default;
+  virtual ~P002_data_struct();
 
   void init(struct EventStruct *event);
 
+# if FEATURE_ADC_CONTINUOUS
+
+  // Only call this for the active task, as the ADC channel is claimed for this task.
+  void startContinuousSampling(struct EventStruct *event);
+# endif // if FEATURE_ADC_CONTINUOUS
+
 private:
 
 # ifndef LIMIT_BUILD_SIZE
@@ -182,6 +194,11 @@ public:
 
 private:
 
+  // Read a single sample, or the last sample when using continuous sampling
+  int  readADC() const;
+
+  void addSample(int raw);
+
   void resetOversampling();
 
   void addOversamplingValue(int currentValue);
@@ -189,6 +206,13 @@ private:
   bool getOversamplingValue(float& float_value,
                             int  & raw_value) const;
 
+  // RMS of the AC component of the signal
+  bool getRMSValue(float& float_value,
+                   int  & raw_value) const;
+
+  // Apply factory calibration and 2-point calibration to a raw ADC value
+  float applyRawCalibration(float raw) const;
+
 private:
 
 # ifndef LIMIT_BUILD_SIZE
@@ -245,6 +269,7 @@ public:
 private:
 
   OversamplingHelper<int32_t>OverSampling;
+  ADC_SampleAccumulator      _rmsSamples;
 
   int   _calib_adc1 = 0;
   int   _calib_adc2 = 0;
@@ -261,6 +286,8 @@ private:
 
   int _pin_analogRead = -1;
 
+  taskIndex_t _taskIndex = INVALID_TASK_INDEX;
+
   uint8_t _sampleMode = P002_USE_CURENT_SAMPLE;
 
   uint8_t _nrDecimals = 0;
@@ -271,6 +298,9 @@ private:
 # endif // ifndef LIMIT_BUILD_SIZE
 # ifdef ESP32
   bool _useFactoryCalibration = false;
+#  if FEATURE_ADC_CONTINUOUS
+  bool _useContinuous = false;
+#  endif // if FEATURE_ADC_CONTINUOUS
 
 #  if ESP_IDF_VERSION_MAJOR >= 5
   adc_atten_t _attenuation = ADC_ATTEN_DB_12;
@@ -22,6 +22,9 @@
 # define BMP085_READPRESSURECMD   0x34
 
 
+P006_data_struct::P006_data_struct(taskIndex_t taskIndex, int elev)
+  : PluginTaskData_measurement(taskIndex), elevation(elev) {}
+
 bool P006_data_struct::begin()
 {
   if (!initialized) {
@@ -48,37 +51,54 @@ bool P006_data_struct::begin()
   return true;
 }
 
-uint16_t P006_data_struct::readRawTemperature()
+int32_t P006_data_struct::measurementStep(uint8_t step)
 {
-  I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READTEMPCMD);
-  delay(5);
-  return I2C_read16_reg(BMP085_I2CADDR, BMP085_TEMPDATA);
+  switch (step) {
+    case 0:
+
+      if (!begin()) { return MEASUREMENT_ERROR; }
+      I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READTEMPCMD);
+      return 5;
+    case 1:
+      UT = I2C_read16_reg(BMP085_I2CADDR, BMP085_TEMPDATA);
+      I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READPRESSURECMD + (oversampling << 6));
+      return 26;
+    case 2:
+    {
+      uint32_t raw = I2C_read16_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA);
+      raw <<= 8;
+      raw  |= I2C_read8_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA + 2);
+      raw >>= (8 - oversampling);
+      UP    = raw;
+      return MEASUREMENT_DONE;
+    }
+  }
+  return MEASUREMENT_ERROR;
 }
 
-uint32_t P006_data_struct::readRawPressure()
+bool P006_data_struct::setTaskValues(struct EventStruct *event)
 {
-  uint32_t raw;
-
-  I2C_write8_reg(BMP085_I2CADDR, BMP085_CONTROL, BMP085_READPRESSURECMD + (oversampling << 6));
+  UserVar.setFloat(event->TaskIndex, 0, computeTemperature());
+  float pressure = static_cast<float>(computePressure()) / 100.0f;
 
-  delay(26);
-
-  raw   = I2C_read16_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA);
-  raw <<= 8;
-  raw  |= I2C_read8_reg(BMP085_I2CADDR, BMP085_PRESSUREDATA + 2);
-  raw >>= (8 - oversampling);
+  if (elevation != 0)
+  {
+    pressure = pressureElevation(pressure, elevation);
+  }
+  UserVar.setFloat(event->TaskIndex, 1, pressure);
 
-  return raw;
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLog(LOG_LEVEL_INFO, concat(F("BMP  : Temperature: "), formatUserVarNoCheck(event, 0)));
+    addLog(LOG_LEVEL_INFO, concat(F("BMP  : Barometric Pressure: "), formatUserVarNoCheck(event, 1)));
+  }
+  return true;
 }
 
-int32_t P006_data_struct::readPressure()
+int32_t P006_data_struct::computePressure() const
 {
-  int32_t  UT, UP, B3, B5, B6, X1, X2, X3, p;
+  int32_t  B3, B5, B6, X1, X2, X3, p;
   uint32_t B4, B7;
 
-  UT = readRawTemperature();
-  UP = readRawPressure();
-
   // do temperature calculations
   X1 = (UT - (int32_t)(ac6)) * ((int32_t)(ac5)) / 32768.0f /*pow(2, 15)*/;
   X2 = ((int32_t)mc * 2048.0f /*pow(2, 11)*/) / (X1 + (int32_t)md);
@@ -113,13 +133,11 @@ int32_t P006_data_struct::readPressure()
   return p;
 }
 
-float P006_data_struct::readTemperature()
+float P006_data_struct::computeTemperature() const
 {
-  int32_t UT, X1, X2, B5; // following ds convention
+  int32_t X1, X2, B5; // following ds convention
   float   temp;
 
-  UT = readRawTemperature();
-
   // step 1
   X1    = (UT - (int32_t)ac6) * ((int32_t)ac5) / 32768.0f /*pow(2, 15)*/;
   X2    = ((int32_t)mc * 2048.0f /*pow(2, 11)*/) / (X1 + (int32_t)md);
@@ -4,22 +4,31 @@
 #include "../../_Plugin_Helper.h"
 #ifdef USES_P006
 
+# include "../DataStructs/PluginTaskData_measurement.h"
+
 
 # define BMP085_ULTRAHIGHRES         3
 
-struct P006_data_struct : public PluginTaskData_base {
-  P006_data_struct() = default;
+struct P006_data_struct : public PluginTaskData_measurement {
+  P006_data_struct(taskIndex_t taskIndex,
+                   int         elev);
+  P006_data_struct()          = delete;
   virtual ~P006_data_struct() = default;
 
-  bool     begin();
+  bool begin();
+
+protected:
 
-  uint16_t readRawTemperature();
+  // Steps: start temperature conversion, start pressure conversion, read pressure
+  int32_t measurementStep(uint8_t step) override;
 
-  uint32_t readRawPressure();
+  bool    setTaskValues(struct EventStruct *event) override;
 
-  int32_t  readPressure();
+private:
 
-  float    readTemperature();
+  float   computeTemperature() const;
+
+  int32_t computePressure() const;
 
   uint8_t  oversampling = BMP085_ULTRAHIGHRES;
   int16_t  ac1 = 0;
@@ -34,6 +43,10 @@ struct P006_data_struct : public PluginTaskData_base {
   uint16_t ac5 = 0;
   uint16_t ac6 = 0;
 
+  int32_t  UT        = 0;
+  int32_t  UP        = 0;
+  int      elevation = 0;
+
   bool initialized = false;
 };
 
@@ -7,6 +7,7 @@
 
 # include "../Globals/EventQueue.h"
 
+# include "../Helpers/CRC_functions.h"
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/Misc.h"
 
@@ -78,8 +79,8 @@ void P020_Task::checkServer() {
 
 void P020_Task::stopServer() {
   if (nullptr != ser2netServer) {
-    if (ser2netClient) { ser2netClient.stop(); }
-    clientConnected = false;
+    _bridge.stopClients();
+    _clientCount = 0;
     ser2netServer->close();
     addLog(LOG_LEVEL_INFO, F("Ser2Net: WiFi server closed"));
     delete ser2netServer;
@@ -88,51 +89,20 @@ void P020_Task::stopServer() {
 }
 
 bool P020_Task::hasClientConnected() {
-  if ((nullptr != ser2netServer) && ser2netServer->hasClient())
-  {
-    if (ser2netClient) { ser2netClient.stop(); }
-    #if ESP_IDF_VERSION_MAJOR >= 5
-    ser2netClient = ser2netServer->accept();
-    #else
-    ser2netClient = ser2netServer->available();
-    #endif
-
-    # ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
-
-    // See: https://github.com/espressif/arduino-esp32/pull/6676
-    ser2netClient.setTimeout((CONTROLLER_CLIENTTIMEOUT_DFLT + 500) / 1000); // in seconds!!!!
-    Client *pClient = &ser2netClient;
-    pClient->setTimeout(CONTROLLER_CLIENTTIMEOUT_DFLT);
-    # else // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
-    ser2netClient.setTimeout(CONTROLLER_CLIENTTIMEOUT_DFLT); // in msec as it should be!
-    # endif // ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
-
-    sendConnectedEvent(true);
+  if (_bridge.acceptClient(ser2netServer)) {
     addLog(LOG_LEVEL_INFO, F("Ser2Net: Client connected!"));
   }
 
-  if (ser2netClient.connected())
-  {
-    clientConnected = true;
-  }
-  else
-  {
-    if (clientConnected) // there was a client connected before...
-    {
-      clientConnected = false;
-      sendConnectedEvent(false);
+  const uint8_t clientCount = _bridge.checkClients();
+
+  if (clientCount != _clientCount) {
+    if (clientCount < _clientCount) {
       addLog(LOG_LEVEL_INFO, F("Ser2Net: Client disconnected!"));
     }
+    _clientCount = clientCount;
+    sendConnectedEvent(clientCount);
   }
-  return clientConnected;
-}
-
-void P020_Task::discardClientIn() {
-  // flush all data received from the WiFi gateway
-  // as a P1 meter does not receive data
-  while (ser2netClient.available()) {
-    ser2netClient.read();
-  }
+  return _clientCount > 0;
 }
 
 void P020_Task::clearBuffer() {
@@ -162,8 +132,21 @@ void P020_Task::serialBegin(const ESPEasySerialPort port, int16_t rxPin, int16_t
   }
 }
 
+void P020_Task::bridgeBegin(int rxBuffer, int rxWait) {
+  // Without event processing or character replacement, the serial data is passed through in blocks
+  const bool rawBridge = (P020_Events::None == serial_processing) && (0 == _space) && (0 == _newline);
+
+  if (!_bridge.begin(ser2netSerial, rawBridge ? 2 * rxBuffer : 0, SER2NET_NET_BUFFER_SIZE)) {
+    addLog(LOG_LEVEL_ERROR, F("Ser2Net: Could not allocate buffers"));
+  }
+  _bridge.setFlushThresholds(rxBuffer, rxWait);
+  _rawBridge = _bridge.hasSerialBuffer();
+}
+
 void P020_Task::serialEnd() {
   if (nullptr != ser2netSerial) {
+    _bridge.end();
+    _rawBridge = false;
     delete ser2netSerial;
     clearBuffer();
     ser2netSerial = nullptr;
@@ -174,24 +157,19 @@ void P020_Task::serialEnd() {
 }
 
 void P020_Task::handleClientIn(struct EventStruct *event) {
-  size_t  count      = ser2netClient.available();
-  size_t  bytes_read = 0;
-  uint8_t net_buf[_maxDataGramSize];
-
-  if (count > 0) {
-    if (count > _maxDataGramSize) { count = _maxDataGramSize; }
-    bytes_read = ser2netClient.read(net_buf, count);
-    ser2netSerial->write(net_buf, bytes_read);
-    ser2netSerial->flush();             // Waits for the transmission of outgoing serial data to
-
-    while (ser2netClient.available()) { // flush overflow data if available
-      ser2netClient.read();
-    }
-  }
+  // Only writes what fits in the serial TX buffer, so no waiting for the transmission to complete
+  _bridge.netToSerial();
 }
 
 void P020_Task::handleSerialIn(struct EventStruct *event) {
   if (nullptr == ser2netSerial) { return; }
+
+  if (_rawBridge) {
+    if (_bridge.serialToNet() > 0) {
+      blinkLED();
+    }
+    return;
+  }
   int  RXWait    = P020_RX_WAIT;
   int  timeOut   = RXWait;
   int  maxExtend = 5;
@@ -246,18 +224,24 @@ void P020_Task::handleSerialIn(struct EventStruct *event) {
     }
   } while (true);
 
+  # if P020_FEATURE_OBIS_PARSER
+
+  if (done && (_obisCount > 0)) {
+    setObisValues(event);
+  }
+  # endif // if P020_FEATURE_OBIS_PARSER
+
   if (serial_buffer.length() > 0) {
-    if (ser2netClient.connected()) { // Only send out if a client is connected
+    if (_clientCount > 0) { // Only send out if a client is connected
       if ((serial_processing == P020_Events::P1WiFiGateway) && !serial_buffer.endsWith(F("\r\n"))) {
         serial_buffer += F("\r\n");
       }
-      ser2netClient.print(serial_buffer);
+      _bridge.send(serial_buffer);
     }
 
     blinkLED();
 
     rulesEngine(serial_buffer);
-    ser2netClient.PR_9453_FLUSH_TO_CLEAR();
     clearBuffer();
     # ifndef BUILD_NO_DEBUG
     addLog(LOG_LEVEL_DEBUG, F("Ser2Net: data sent!"));
@@ -371,9 +355,9 @@ bool P020_Task::isInit() const {
   return nullptr != ser2netServer && nullptr != ser2netSerial;
 }
 
-void P020_Task::sendConnectedEvent(bool connected)
+void P020_Task::sendConnectedEvent(uint8_t clientCount)
 {
-  eventQueue.add(_taskIndex, F("Client"), (connected ? 1 : 0));
+  eventQueue.add(_taskIndex, F("Client"), clientCount);
 }
 
 void P020_Task::blinkLED() {
@@ -404,7 +388,7 @@ void P020_Task::addChar(char ch) {
 
 /*  checkDatagram
     checks whether the P020_CHECKSUM of the data received from P1 matches the P020_CHECKSUM
-    attached to the telegram
+    attached to the telegram. The CRC is calculated while the characters are received.
  */
 bool P020_Task::checkDatagram() const {
   int endChar = serial_buffer.length() - 1;
@@ -422,8 +406,6 @@ bool P020_Task::checkDatagram() const {
     return true;
   }
 
-  const int checksumStartIndex = endChar + 1;
-
   # if PLUGIN_020_DEBUG
 
   for (unsigned int cnt = 0; cnt < serial_buffer.length(); ++cnt) {
@@ -431,33 +413,8 @@ bool P020_Task::checkDatagram() const {
   }
   # endif // if PLUGIN_020_DEBUG
 
-  // calculate the CRC and check if it equals the hexadecimal one attached to the datagram
-  unsigned int crc = CRC16(serial_buffer, checksumStartIndex);
-  return strtoul(serial_buffer.substring(checksumStartIndex).c_str(), nullptr, 16) == crc;
-}
-
-/*
-   CRC16
-      based on code written by Jan ten Hove
-     https://github.com/jantenhove/P1-Meter-ESP8266
- */
-unsigned int P020_Task::CRC16(const String& buf, int len) {
-  unsigned int crc = 0;
-
-  for (int pos = 0; pos < len; ++pos) {
-    crc ^= static_cast<const unsigned int>(buf[pos]); // XOR byte into least sig. byte of crc
-
-    for (int i = 8; i != 0; --i) {                    // Loop over each bit
-      if ((crc & 0x0001) != 0) {                      // If the LSB is set
-        crc >>= 1;                                    // Shift right and XOR 0xA001
-        crc  ^= 0xA001;
-      } else {                                        // Else LSB is not set
-        crc >>= 1;                                    // Just shift right
-      }
-    }
-  }
-
-  return crc;
+  // check if the calculated CRC equals the hexadecimal one attached to the datagram
+  return _checksumValid && (_checksum == _crc);
 }
 
 /*
@@ -499,6 +456,10 @@ bool P020_Task::handleP1Char(char ch) {
       if (ch == P020_DATAGRAM_START_CHAR)  {
         clearBuffer();
         addChar(ch);
+        _crc = calc_CRC16_ARC_update(0, ch);
+        # if P020_FEATURE_OBIS_PARSER
+        _obis.start();
+        # endif // if P020_FEATURE_OBIS_PARSER
         _state = ParserState::READING;
       } // else ignore data
       break;
@@ -506,12 +467,22 @@ bool P020_Task::handleP1Char(char ch) {
 
       if (validP1char(ch)) {
         addChar(ch);
+        _crc = calc_CRC16_ARC_update(_crc, ch);
+        # if P020_FEATURE_OBIS_PARSER
+
+        if (_obisCount > 0) {
+          _obis.addChar(ch);
+        }
+        # endif // if P020_FEATURE_OBIS_PARSER
       } else if (ch == P020_DATAGRAM_END_CHAR) {
         addChar(ch);
+        _crc = calc_CRC16_ARC_update(_crc, ch);
 
         if (_CRCcheck) {
-          checkI = 0;
-          _state = ParserState::CHECKSUM;
+          checkI         = 0;
+          _checksum      = 0;
+          _checksumValid = true;
+          _state         = ParserState::CHECKSUM;
         } else {
           done = true;
         }
@@ -532,6 +503,12 @@ bool P020_Task::handleP1Char(char ch) {
         addChar(ch);
         ++checkI;
 
+        if (isHexadecimalDigit(ch)) {
+          _checksum = (_checksum << 4) | ((ch <= '9') ? (ch - '0') : ((ch & 0x0F) + 9));
+        } else {
+          _checksumValid = false;
+        }
+
         if (checkI == P020_CHECKSUM_LENGTH) {
           done = true;
         }
@@ -578,4 +555,218 @@ bool P020_Task::handleP1Char(char ch) {
   return done;
 }
 
+# if P020_FEATURE_OBIS_PARSER
+void P020_Task::setObisCodes(struct EventStruct *event) {
+  _obisCount = 0;
+
+  if (serial_processing == P020_Events::P1WiFiGateway) {
+    _obisCount = std::min(static_cast<uint8_t>(P020_GET_OBIS_COUNT), static_cast<uint8_t>(P020_OBIS_MAX_CODES));
+  }
+
+  for (uint8_t i = 0; i < P020_OBIS_MAX_CODES; ++i) {
+    _obis.setCode(i, i < _obisCount ? P020_GET_OBIS_CODE(i) : 0);
+  }
+}
+
+void P020_Task::setObisValues(struct EventStruct *event) {
+  const uint8_t found = _obis.getFound();
+
+  if (0 == found) { return; }
+
+  for (uint8_t i = 0; i < _obisCount; ++i) {
+    if (bitRead(found, i)) {
+      UserVar.setFloat(event->TaskIndex, i, _obis.getValue(i));
+    }
+  }
+  sendData(event);
+}
+
+# endif // if P020_FEATURE_OBIS_PARSER
+
+# if P020_FEATURE_OBIS_PARSER
+
+/*
+   P020_ObisParser
+ */
+uint32_t P020_ObisParser::parseObisCode(const String& code) {
+  // Expected format: A-B:C.D.E
+  const char separators[] = { '-', ':', '.', '.', 0 };
+  uint32_t   result       = 0;
+  uint8_t    field        = 0;
+  uint16_t   value        = 0;
+  bool       hasDigit     = false;
+
+  for (size_t i = 0; i <= code.length(); ++i) {
+    const char ch = i < code.length() ? code[i] : 0;
+
+    if (isDigit(ch)) {
+      value    = value * 10 + (ch - '0');
+      hasDigit = true;
+
+      if (value > ((field < 2) ? 15 : 255)) { return 0; }
+    } else if (hasDigit && (ch == separators[field])) {
+      result   = (result << ((field < 2) ? 4 : 8)) | value;
+      value    = 0;
+      hasDigit = false;
+      ++field;
+
+      if (ch == 0) { return result; }
+    } else {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+String P020_ObisParser::obisCodeToString(uint32_t code) {
+  if (0 == code) { return EMPTY_STRING; }
+  return strformat(F("%u-%u:%u.%u.%u"),
+                   (code >> 28) & 0x0F, (code >> 24) & 0x0F,
+                   (code >> 16) & 0xFF, (code >> 8) & 0xFF, code & 0xFF);
+}
+
+void P020_ObisParser::setCode(uint8_t index, uint32_t code) {
+  if (index < P020_OBIS_MAX_CODES) {
+    _codes[index] = code;
+  }
+}
+
+void P020_ObisParser::start() {
+  _found     = 0;
+  _state     = LineState::Skip; // Skip the identification line
+  _lineStart = false;
+  _match     = -1;
+  _lastMatch = -1;
+}
+
+void P020_ObisParser::addChar(char ch) {
+  if (ch == '\n') {
+    endLine();
+    return;
+  }
+
+  if (ch == '\r') { return; }
+
+  const bool lineStart = _lineStart;
+
+  _lineStart = false;
+
+  switch (_state) {
+    case LineState::Code:
+
+      if (isDigit(ch)) {
+        _fields[_field] = _fields[_field] * 10 + (ch - '0');
+
+        if (_fields[_field] > ((_field < 2) ? 15 : 255)) {
+          _state = LineState::Skip; // Not a valid OBIS code
+        }
+      } else if (((ch == '-') && (_field == 0)) ||
+                 ((ch == ':') && (_field == 1)) ||
+                 ((ch == '.') && ((_field == 2) || (_field == 3)))) {
+        ++_field;
+      } else if (ch == '(') {
+        if (_field == 4) {
+          const uint32_t code = (static_cast<uint32_t>(_fields[0] & 0x0F) << 28) |
+                                (static_cast<uint32_t>(_fields[1] & 0x0F) << 24) |
+                                (static_cast<uint32_t>(_fields[2]) << 16) |
+                                (static_cast<uint32_t>(_fields[3]) << 8) |
+                                _fields[4];
+
+          for (uint8_t i = 0; i < P020_OBIS_MAX_CODES; ++i) {
+            if ((_codes[i] != 0) && (_codes[i] == code)) {
+              _match = i;
+              break;
+            }
+          }
+        } else if (lineStart) {
+          _match = _lastMatch; // Continuation of the previous line
+        }
+        _state    = LineState::Group;
+        _mantissa = 0;
+        _decimals = -1;
+        _digits   = 0;
+        _negative = false;
+        _valid    = true;
+      } else {
+        _state = LineState::Skip;
+      }
+      break;
+    case LineState::Group:
+
+      if (isDigit(ch)) {
+        if (_mantissa > ((UINT32_MAX - 9) / 10)) {
+          _valid = false;
+        } else {
+          _mantissa = _mantissa * 10 + (ch - '0');
+          ++_digits;
+
+          if (_decimals >= 0) { ++_decimals; }
+        }
+      } else if ((ch == '.') && (_decimals < 0)) {
+        _decimals = 0;
+      } else if ((ch == '-') && (_digits == 0) && !_negative) {
+        _negative = true;
+      } else if (ch == '*') {
+        _state = LineState::Unit;
+      } else if (ch == ')') {
+        endGroup();
+      } else {
+        _valid = false;
+      }
+      break;
+    case LineState::Unit:
+
+      if (ch == ')') {
+        endGroup();
+      }
+      break;
+    case LineState::Between:
+
+      if (ch == '(') {
+        _state    = LineState::Group;
+        _mantissa = 0;
+        _decimals = -1;
+        _digits   = 0;
+        _negative = false;
+        _valid    = true;
+      } else {
+        _state = LineState::Skip;
+      }
+      break;
+    case LineState::Skip:
+      break;
+  }
+}
+
+void P020_ObisParser::endGroup() {
+  _hasValue = _valid && (_digits > 0);
+
+  if (_hasValue) {
+    double value = _mantissa;
+
+    for (int8_t i = 0; i < _decimals; ++i) {
+      value /= 10.0;
+    }
+    _value = static_cast<float>(_negative ? -value : value);
+  }
+  _state = LineState::Between;
+}
+
+void P020_ObisParser::endLine() {
+  if ((_match >= 0) && _hasValue && (_state == LineState::Between)) {
+    _values[_match] = _value;
+    bitSet(_found, _match);
+  }
+
+  _lastMatch = _match;
+  _match     = -1;
+  _state     = LineState::Code;
+  _field     = 0;
+  _lineStart = true;
+  _hasValue  = false;
+  memset(_fields, 0, sizeof(_fields));
+}
+
+# endif // if P020_FEATURE_OBIS_PARSER
+
 #endif // ifdef USES_P020
@@ -5,18 +5,34 @@
 
 #ifdef USES_P020
 
+# include "../Helpers/Ser2Net_Bridge.h"
+
 # include <ESPeasySerial.h>
 
 # ifndef PLUGIN_020_DEBUG
   #  define PLUGIN_020_DEBUG            false // when true: extra logging in serial out !?!?!
 # endif // ifndef PLUGIN_020_DEBUG
 
+# ifndef P020_FEATURE_OBIS_PARSER
+#  ifdef LIMIT_BUILD_SIZE
+#   define P020_FEATURE_OBIS_PARSER     0
+#  else // ifdef LIMIT_BUILD_SIZE
+#   define P020_FEATURE_OBIS_PARSER     1 // Parse configured OBIS codes from P1 telegrams into task values
+#  endif // ifdef LIMIT_BUILD_SIZE
+# endif // ifndef P020_FEATURE_OBIS_PARSER
+
 # define P020_SET_SERVER_PORT           ExtraTaskSettings.TaskDevicePluginConfigLong[0]
 # define P020_SET_BAUDRATE              ExtraTaskSettings.TaskDevicePluginConfigLong[1]
 
 # define P020_GET_SERVER_PORT           Cache.getTaskDevicePluginConfigLong(event->TaskIndex, 0)
 # define P020_GET_BAUDRATE              Cache.getTaskDevicePluginConfigLong(event->TaskIndex, 1)
 
+# define P020_OBIS_CODE_CONFIG_INDEX    2 // ExtraTaskSettings.TaskDevicePluginConfigLong[2..5]
+# define P020_OBIS_MAX_CODES            VARS_PER_TASK
+# define P020_SET_OBIS_CODE(n)          ExtraTaskSettings.TaskDevicePluginConfigLong[P020_OBIS_CODE_CONFIG_INDEX + (n)]
+# define P020_GET_OBIS_CODE(n)          static_cast<uint32_t>(Cache.getTaskDevicePluginConfigLong(event->TaskIndex, \
+                                                                                          P020_OBIS_CODE_CONFIG_INDEX + (n)))
+
 # define P020_REPLACE_CHAR_SET          ",;:.!^|/\\"
 
 # define P020_LED_PIN                   PCONFIG(0)
@@ -37,6 +53,7 @@
 # define P020_FLAG_P044_MODE_SAVED      8
 # define P020_FLAG_EVENT_SERIAL_ID      9
 # define P020_FLAG_APPEND_TASK_ID       10
+# define P020_FLAG_OBIS_COUNT           12 // 3 bits
 # define P020_IGNORE_CLIENT_CONNECTED   bitRead(P020_FLAGS, P020_FLAG_IGNORE_CLIENT)
 # define P020_HANDLE_MULTI_LINE         bitRead(P020_FLAGS, P020_FLAG_MULTI_LINE)
 # define P020_GET_LED_ENABLED           bitRead(P020_FLAGS, P020_FLAG_LED_ENABLED)
@@ -45,6 +62,7 @@
 # define P020_GET_P044_MODE_SAVED       bitRead(P020_FLAGS, P020_FLAG_P044_MODE_SAVED)
 # define P020_GET_EVENT_SERIAL_ID       bitRead(P020_FLAGS, P020_FLAG_EVENT_SERIAL_ID)
 # define P020_GET_APPEND_TASK_ID        bitRead(P020_FLAGS, P020_FLAG_APPEND_TASK_ID)
+# define P020_GET_OBIS_COUNT            get3BitFromUL(P020_FLAGS, P020_FLAG_OBIS_COUNT)
 
 # define P020_DEFAULT_SERVER_PORT           1234
 # define P020_DEFAULT_BAUDRATE              115200
@@ -69,6 +87,72 @@ enum class P020_Events : uint8_t {
   P1WiFiGateway = 3u,
 };
 
+# if P020_FEATURE_OBIS_PARSER
+
+/*********************************************************************************************\
+* P020_ObisParser
+*
+* Parses the lines of a DSMR P1 telegram while the characters are received, and keeps the
+* numeric value of the configured OBIS codes. Uses no String objects.
+* Line format: A-B:C.D.E(value*unit), optionally with more (...) groups, the last group holds the value.
+* A line starting with '(' continues the previous line (DSMR 2.2 gas meter value).
+\*********************************************************************************************/
+struct P020_ObisParser {
+  // OBIS code A-B:C.D.E is stored as 0xABCCDDEE, A and B: 0..15, C, D and E: 0..255, 0 = not set
+  static uint32_t parseObisCode(const String& code);
+  static String   obisCodeToString(uint32_t code);
+
+  void            setCode(uint8_t  index,
+                          uint32_t code);
+
+  // Start of a new telegram, clears the values found
+  void            start();
+
+  void            addChar(char ch);
+
+  // Bit per code index, set when a value was found in the current telegram
+  uint8_t getFound() const {
+    return _found;
+  }
+
+  float getValue(uint8_t index) const {
+    return _values[index];
+  }
+
+private:
+
+  enum class LineState : uint8_t {
+    Code,    // Reading the OBIS code
+    Group,   // Reading a numeric value in a (...) group
+    Unit,    // Skipping the unit after '*'
+    Between, // After a group
+    Skip     // Ignore the rest of the line
+  };
+
+  void endGroup();
+  void endLine();
+
+  uint32_t  _codes[P020_OBIS_MAX_CODES]  = {};
+  float     _values[P020_OBIS_MAX_CODES] = {};
+  uint8_t   _found = 0;
+
+  // State of the current line
+  LineState _state     = LineState::Skip;
+  uint8_t   _field     = 0;    // OBIS code field being read, A..E
+  uint16_t  _fields[5] = {};
+  bool      _lineStart = true; // No characters received on this line
+  int8_t    _match     = -1;   // Configured code index of this line
+  int8_t    _lastMatch = -1;   // Configured code index of the previous line
+  uint32_t  _mantissa  = 0;
+  int8_t    _decimals  = -1;   // -1: no decimal point
+  uint8_t   _digits    = 0;
+  bool      _negative  = false;
+  bool      _valid     = false;
+  bool      _hasValue  = false;
+  float     _value     = 0.0f;
+};
+# endif // if P020_FEATURE_OBIS_PARSER
+
 struct P020_Task : public PluginTaskData_base {
   enum class ParserState : uint8_t {
     WAITING,
@@ -87,7 +171,6 @@ struct P020_Task : public PluginTaskData_base {
   void               stopServer();
 
   bool               hasClientConnected();
-  void               discardClientIn();
 
   void               clearBuffer();
   void               serialBegin(const ESPEasySerialPort port,
@@ -95,6 +178,10 @@ struct P020_Task : public PluginTaskData_base {
                                  int16_t                 txPin,
                                  unsigned long           baud,
                                  uint8_t                 config);
+
+  // Set up the buffers, after serial_processing is set
+  void                bridgeBegin(int rxBuffer,
+                                  int rxWait);
   void                serialEnd();
 
   void                handleSerialIn(struct EventStruct *event);
@@ -104,7 +191,7 @@ struct P020_Task : public PluginTaskData_base {
 
   bool                isInit() const;
 
-  void                sendConnectedEvent(bool connected);
+  void                sendConnectedEvent(uint8_t clientCount);
 
   void                blinkLED();
   void                checkBlinkLED();
@@ -113,18 +200,10 @@ struct P020_Task : public PluginTaskData_base {
 
   /*  checkDatagram
       checks whether the P020_CHECKSUM of the data received from P1 matches the P020_CHECKSUM
-      attached to the telegram
+      attached to the telegram. The CRC is calculated while the characters are received.
    */
   bool                checkDatagram() const;
 
-  /*
-     CRC16
-        based on code written by Jan ten Hove
-       https://github.com/jantenhove/P1-Meter-ESP8266
-   */
-  static unsigned int CRC16(const String& buf,
-                            int           len);
-
   /*
      validP1char
          Checks if the character is valid as part of the P1 datagram contents and/or checksum.
@@ -133,10 +212,16 @@ struct P020_Task : public PluginTaskData_base {
   static bool validP1char(char ch);
   bool        handleP1Char(char ch);
 
+  # if P020_FEATURE_OBIS_PARSER
+  void        setObisCodes(struct EventStruct *event);
+  void        setObisValues(struct EventStruct *event);
+  # endif // if P020_FEATURE_OBIS_PARSER
+
   WiFiServer    *ser2netServer = nullptr;
   uint16_t       gatewayPort   = 0;
-  WiFiClient     ser2netClient;
-  bool           clientConnected = false;
+  Ser2Net_Bridge _bridge;
+  uint8_t        _clientCount = 0;
+  bool           _rawBridge   = false; // Pass serial data through in blocks, no character processing
   String         serial_buffer;
   String         net_buffer;
   int            checkI            = 0;
@@ -157,6 +242,13 @@ struct P020_Task : public PluginTaskData_base {
   char          _newline           = 0;
   bool          _serialId          = false;
   bool          _appendTaskId      = false;
+  uint16_t      _crc               = 0; // CRC16 of the P1 datagram received so far
+  uint16_t      _checksum          = 0; // CRC16 received with the P1 datagram
+  bool          _checksumValid     = false;
+  # if P020_FEATURE_OBIS_PARSER
+  uint8_t         _obisCount = 0;
+  P020_ObisParser _obis;
+  # endif // if P020_FEATURE_OBIS_PARSER
 
   ESPEasySerialPort _port;
 };
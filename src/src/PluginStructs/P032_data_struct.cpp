@@ -19,7 +19,8 @@ enum
 };
 
 
-P032_data_struct::P032_data_struct(uint8_t i2c_addr) : i2cAddress(i2c_addr) {}
+P032_data_struct::P032_data_struct(taskIndex_t taskIndex, uint8_t i2c_addr, int elev)
+  : PluginTaskData_measurement(taskIndex), i2cAddress(i2c_addr), elevation(elev) {}
 
 
 // **************************************************************************/
@@ -29,6 +30,52 @@ bool P032_data_struct::begin() {
   return 0 == I2C_wakeup(i2cAddress);
 }
 
+// **************************************************************************/
+// Measurement steps
+// **************************************************************************/
+int32_t P032_data_struct::measurementStep(uint8_t step)
+{
+  switch (step) {
+    case 0:
+
+      if (!begin()) { return MEASUREMENT_ERROR; }
+      I2C_write8(i2cAddress, MS5xxx_CMD_RESET);
+      return 3;
+    case 1:
+      read_prom();
+      return start_adc(MS5xxx_CMD_ADC_D2 + MS5xxx_CMD_ADC_4096);
+    case 2:
+      D2 = read_adc();
+      return start_adc(MS5xxx_CMD_ADC_D1 + MS5xxx_CMD_ADC_4096);
+    case 3:
+      D1 = read_adc();
+      return MEASUREMENT_DONE;
+  }
+  return MEASUREMENT_ERROR;
+}
+
+bool P032_data_struct::setTaskValues(struct EventStruct *event)
+{
+  readout();
+
+  UserVar.setFloat(event->TaskIndex, 0, ms5611_temperature / 100);
+
+  if (elevation != 0)
+  {
+    UserVar.setFloat(event->TaskIndex, 1, pressureElevation(ms5611_pressure, elevation));
+  } else {
+    UserVar.setFloat(event->TaskIndex, 1, ms5611_pressure);
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLog(LOG_LEVEL_INFO,
+           concat(F("MS5611  : Temperature: "), formatUserVarNoCheck(event, 0)));
+    addLog(LOG_LEVEL_INFO,
+           concat(F("MS5611  : Barometric Pressure: "), formatUserVarNoCheck(event, 1)));
+  }
+  return true;
+}
+
 // **************************************************************************/
 // Reads the PROM of MS5611
 // There are in total 8 addresses resulting in a total memory of 128 bit.
@@ -38,9 +85,6 @@ bool P032_data_struct::begin() {
 // clocked with the MSB first.
 // **************************************************************************/
 void P032_data_struct::read_prom() {
-  I2C_write8(i2cAddress, MS5xxx_CMD_RESET);
-  delay(3);
-
   for (uint8_t i = 0; i < 8; i++)
   {
     ms5611_prom[i] = I2C_read16_reg(i2cAddress, MS5xxx_CMD_PROM_RD + 2 * i);
@@ -48,26 +92,27 @@ void P032_data_struct::read_prom() {
 }
 
 // **************************************************************************/
-// Read analog/digital converter
+// Start conversion of analog/digital converter
 // **************************************************************************/
-unsigned long P032_data_struct::read_adc(unsigned char aCMD)
+uint8_t P032_data_struct::start_adc(unsigned char aCMD)
 {
   I2C_write8(i2cAddress, MS5xxx_CMD_ADC_CONV + aCMD); // start DAQ and conversion of ADC data
 
   switch (aCMD & 0x0f)
   {
-    case MS5xxx_CMD_ADC_256: delayMicroseconds(900);
-      break;
-    case MS5xxx_CMD_ADC_512: delay(3);
-      break;
-    case MS5xxx_CMD_ADC_1024: delay(4);
-      break;
-    case MS5xxx_CMD_ADC_2048: delay(6);
-      break;
-    case MS5xxx_CMD_ADC_4096: delay(10);
-      break;
+    case MS5xxx_CMD_ADC_256: return 1;
+    case MS5xxx_CMD_ADC_512: return 3;
+    case MS5xxx_CMD_ADC_1024: return 4;
+    case MS5xxx_CMD_ADC_2048: return 6;
   }
+  return 10;
+}
 
+// **************************************************************************/
+// Read analog/digital converter
+// **************************************************************************/
+unsigned long P032_data_struct::read_adc()
+{
   // read out values
   return I2C_read24_reg(i2cAddress, MS5xxx_CMD_ADC_READ);
 }
@@ -76,15 +121,10 @@ unsigned long P032_data_struct::read_adc(unsigned char aCMD)
 // Readout
 // **************************************************************************/
 void P032_data_struct::readout() {
-  unsigned long D1 = 0, D2 = 0;
-
   ESPEASY_RULES_FLOAT_TYPE dT;
   ESPEASY_RULES_FLOAT_TYPE Offset;
   ESPEASY_RULES_FLOAT_TYPE SENS;
 
-  D2 = read_adc(MS5xxx_CMD_ADC_D2 + MS5xxx_CMD_ADC_4096);
-  D1 = read_adc(MS5xxx_CMD_ADC_D1 + MS5xxx_CMD_ADC_4096);
-
   // calculate 1st order pressure and temperature (MS5611 1st order algorithm)
   dT     = D2 - ms5611_prom[5] * static_cast<ESPEASY_RULES_FLOAT_TYPE>(1 << 8);
   Offset = ms5611_prom[2] *
@@ -4,10 +4,14 @@
 #include "../../_Plugin_Helper.h"
 #ifdef USES_P032
 
-struct P032_data_struct : public PluginTaskData_base {
+# include "../DataStructs/PluginTaskData_measurement.h"
+
+struct P032_data_struct : public PluginTaskData_measurement {
 public:
 
-  P032_data_struct(uint8_t i2c_addr);
+  P032_data_struct(taskIndex_t taskIndex,
+                   uint8_t     i2c_addr,
+                   int         elev);
   P032_data_struct()          = delete;
   virtual ~P032_data_struct() = default;
 
@@ -17,6 +21,18 @@ public:
   // **************************************************************************/
   bool begin();
 
+protected:
+
+  // **************************************************************************/
+  // Measurement steps: reset, read PROM and start conversion of D2,
+  // read D2 and start conversion of D1, read D1
+  // **************************************************************************/
+  int32_t measurementStep(uint8_t step) override;
+
+  bool    setTaskValues(struct EventStruct *event) override;
+
+private:
+
   // **************************************************************************/
   // Reads the PROM of MS5611
   // There are in total 8 addresses resulting in a total memory of 128 bit.
@@ -27,10 +43,16 @@ public:
   // **************************************************************************/
   void read_prom();
 
+  // **************************************************************************/
+  // Start conversion of analog/digital converter
+  // Returns the conversion time in msec
+  // **************************************************************************/
+  uint8_t       start_adc(unsigned char aCMD);
+
   // **************************************************************************/
   // Read analog/digital converter
   // **************************************************************************/
-  unsigned long read_adc(unsigned char aCMD);
+  unsigned long read_adc();
 
   // **************************************************************************/
   // Readout
@@ -38,6 +60,9 @@ public:
   void readout();
 
   uint8_t                  i2cAddress;
+  int                      elevation;
+  unsigned long            D1                 = 0;
+  unsigned long            D2                 = 0;
   unsigned int             ms5611_prom[8]     = { 0 };
   ESPEASY_RULES_FLOAT_TYPE ms5611_pressure    = 0;
   ESPEASY_RULES_FLOAT_TYPE ms5611_temperature = 0;
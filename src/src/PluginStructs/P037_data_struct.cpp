@@ -15,16 +15,7 @@
 P037_data_struct::P037_data_struct(taskIndex_t taskIndex) : _taskIndex(taskIndex)
 {}
 
-P037_data_struct::~P037_data_struct() {
-  # if P037_JSON_SUPPORT
-
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
-  }
-  # endif // if P037_JSON_SUPPORT
-}
+P037_data_struct::~P037_data_struct() {}
 
 /**
  * Load the settings from file
@@ -936,60 +927,25 @@ bool P037_data_struct::checkFilters(const String& key, const String& value, int8
 # ifdef P037_JSON_SUPPORT
 
 /**
- * Allocate a DynamicJsonDocument and parse the message.
- * Returns true if the operation succeeded, and doc and iter can be used, when n ot successful the state of those variables is undefined.
+ * Prepare the message for extracting the json attributes, without parsing it into a document.
+ * Returns true if the message is a json object, and json can be used to fetch and iterate the attributes.
+ * The message must not be changed or released until cleanupJSON() is called.
  */
 bool P037_data_struct::parseJSONMessage(const String& message) {
-  bool result = false;
-
-  if ((nullptr != root) &&
-      (message.length() * 1.5 > lastJsonMessageLength)) {
-    cleanupJSON();
-  }
-
-  if (message.length() * 1.5 > lastJsonMessageLength) {
-    lastJsonMessageLength = message.length() * 1.5;
-    #  ifdef PLUGIN_037_DEBUG
-
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, concat(F("IMPT : JSON buffer increased to "), (int)lastJsonMessageLength));
-    }
-    #  endif // ifdef PLUGIN_037_DEBUG
-  }
-
-  if (nullptr == root) {
-    # ifdef USE_SECOND_HEAP
-    HeapSelectIram ephemeral;
-    # endif // ifdef USE_SECOND_HEAP
-
-    root = new (std::nothrow) DynamicJsonDocument(lastJsonMessageLength); // Dynamic allocation
-  }
+  json.setSource(message.c_str(), message.length());
 
-  if (nullptr != root) {
-    deserializeJson(*root, message);
-
-    if (!root->isNull()) {
-      # ifdef USE_SECOND_HEAP
-      HeapSelectIram ephemeral;
-      # endif // ifdef USE_SECOND_HEAP
-
-      result = true;
-      doc    = root->as<JsonObject>();
-      iter   = doc.begin();
-    }
+  if (!json.isObject()) {
+    json.clear();
+    return false;
   }
-  return result;
+  return true;
 }
 
 /**
- * Release the created DynamicJsonDocument (if it was allocated)
+ * Release the reference to the json message
  */
 void P037_data_struct::cleanupJSON() {
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
-  }
+  json.clear();
 }
 
 # endif // P037_JSON_SUPPORT
@@ -11,7 +11,7 @@
 # include "../Helpers/StringParser.h"
 # include "../Globals/MQTT.h"
 
-# include <ArduinoJson.h>
+# include "../Helpers/JSON_StreamScanner.h"
 
 // # define PLUGIN_037_DEBUG     // Additional debugging information
 
@@ -163,8 +163,7 @@ struct P037_data_struct : public PluginTaskData_base
   # if P037_JSON_SUPPORT
   bool parseJSONMessage(const String& message);
   void cleanupJSON();
-  JsonObject           doc;
-  JsonObject::iterator iter;
+  JSON_StreamScanner json;
   # endif // if P037_JSON_SUPPORT
 
   // The settings structures
@@ -196,10 +195,6 @@ private:
   int8_t _maxFilter = -1;
   String _filterListItem;
   # endif // if P037_FILTER_SUPPORT
-  # if P037_JSON_SUPPORT
-  DynamicJsonDocument *root                  = nullptr;
-  uint16_t             lastJsonMessageLength = 512;
-  # endif // if P037_JSON_SUPPORT
 };
 
 #endif    // ifdef USED_P037
@@ -0,0 +1,66 @@
+#include "../PluginStructs/P072_data_struct.h"
+
+#ifdef USES_P072
+
+P072_data_struct::P072_data_struct(taskIndex_t taskIndex)
+  : PluginTaskData_measurement(taskIndex) {}
+
+int32_t P072_data_struct::measurementStep(uint8_t step)
+{
+  switch (step) {
+    case 0:
+      Wire.beginTransmission(HDC1080_I2C_ADDRESS); // start transmission to device
+      Wire.write(0x02);                            // sends HDC1080_CONFIGURATION
+      Wire.write(0b00000000);                      // set resolution to 14bits both for T and H
+      Wire.write(0x00);                            // **reserved**
+
+      if (Wire.endTransmission() != 0) {           // end transmission
+        return MEASUREMENT_ERROR;
+      }
+      return 10;
+    case 1:
+      startConversion(0x00); // sends HDC1080_TEMPERATURE
+      return 9;
+    case 2:
+      hdc1080_rawtemp = readResult();
+      startConversion(0x01); // sends HDC1080_HUMIDITY
+      return 9;
+    case 3:
+      hdc1080_rawhum = readResult();
+      return MEASUREMENT_DONE;
+  }
+  return MEASUREMENT_ERROR;
+}
+
+bool P072_data_struct::setTaskValues(struct EventStruct *event)
+{
+  const float hdc1080_temp = (static_cast<float>(hdc1080_rawtemp) / 65536.0f) * 165.0f - 40.0f;
+  const float hdc1080_hum  = (static_cast<float>(hdc1080_rawhum) / 65536.0f) * 100.0f;
+
+  UserVar.setFloat(event->TaskIndex, 0, hdc1080_temp);
+  UserVar.setFloat(event->TaskIndex, 1, hdc1080_hum);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, concat(F("HDC10xx: Temperature: "), formatUserVarNoCheck(event, 0)));
+    addLogMove(LOG_LEVEL_INFO, concat(F("HDC10xx: Humidity: "), formatUserVarNoCheck(event, 1)));
+  }
+  return true;
+}
+
+void P072_data_struct::startConversion(uint8_t reg)
+{
+  Wire.beginTransmission(HDC1080_I2C_ADDRESS); // start transmission to device
+  Wire.write(reg);
+  Wire.endTransmission();                      // end transmission
+}
+
+uint16_t P072_data_struct::readResult()
+{
+  Wire.requestFrom(HDC1080_I2C_ADDRESS, 2); // read 2 bytes
+  const uint8_t hdc1080_msb = Wire.read();
+  const uint8_t hdc1080_lsb = Wire.read();
+
+  return hdc1080_msb << 8 | hdc1080_lsb;
+}
+
+#endif // ifdef USES_P072
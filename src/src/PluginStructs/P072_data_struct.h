@@ -0,0 +1,36 @@
+#ifndef PLUGINSTRUCTS_P072_DATA_STRUCT_H
+#define PLUGINSTRUCTS_P072_DATA_STRUCT_H
+
+#include "../../_Plugin_Helper.h"
+#ifdef USES_P072
+
+# include "../DataStructs/PluginTaskData_measurement.h"
+
+# define HDC1080_I2C_ADDRESS      0x40 // I2C address for the sensor
+
+struct P072_data_struct : public PluginTaskData_measurement {
+  explicit P072_data_struct(taskIndex_t taskIndex);
+  P072_data_struct()          = delete;
+  virtual ~P072_data_struct() = default;
+
+protected:
+
+  // Steps: set resolution, start temperature conversion,
+  // read temperature and start humidity conversion, read humidity
+  int32_t measurementStep(uint8_t step) override;
+
+  bool    setTaskValues(struct EventStruct *event) override;
+
+private:
+
+  // Send the register pointer to start a conversion
+  static void     startConversion(uint8_t reg);
+
+  static uint16_t readResult();
+
+  uint16_t hdc1080_rawtemp = 0;
+  uint16_t hdc1080_rawhum  = 0;
+};
+
+#endif // ifdef USES_P072
+#endif // ifndef PLUGINSTRUCTS_P072_DATA_STRUCT_H
@@ -5,6 +5,7 @@
 #ifdef USES_P078
 
 # include <limits>
+# include <map>
 
 # include <SDM.h> // Requires SDM library from Reaper7 - https://github.com/reaper7/SDM_Energy_Meter/
 
@@ -424,6 +425,50 @@ String p078_register_description::getPhaseDescription(SDM_MODEL model, char sepa
 
 SDM_RegisterReadQueue _SDM_RegisterReadQueue;
 
+// The first _SDM_blockElements elements of the queue are read in a single request, starting at _SDM_blockRegister
+uint8_t  _SDM_blockElements = 0;
+uint16_t _SDM_blockRegister = 0;
+
+// Max. nr of unused registers between 2 values in a request per Modbus address, -1: Don't combine values
+// Lowered per meter when it does not accept a combined request, P078_MAX_READ_GAP when not present.
+std::map<uint8_t, int8_t> _SDM_maxReadGap;
+
+uint32_t _SDM_readRequests = 0;
+uint32_t _SDM_readValues   = 0;
+
+int8_t SDM_getMaxReadGap(uint8_t dev_id)
+{
+  auto it = _SDM_maxReadGap.find(dev_id);
+
+  if (it == _SDM_maxReadGap.end()) {
+    return P078_MAX_READ_GAP;
+  }
+  return it->second;
+}
+
+bool compare_SDM_RegisterReadQueueElement(const SDM_RegisterReadQueueElement& first, const SDM_RegisterReadQueueElement& second)
+{
+  if (first._dev_id != second._dev_id) {
+    return first._dev_id < second._dev_id;
+  }
+  return first._reg < second._reg;
+}
+
+// Sort the queue on Modbus address and register, so the values to combine are next to each other.
+// A request still waiting for a reply is sent again.
+void SDM_sortRegisterReadQueue()
+{
+  auto it = _SDM_RegisterReadQueue.begin();
+
+  if (it == _SDM_RegisterReadQueue.end()) { return; }
+  const uint8_t state = it->_state == 2 ? 2 : 0;
+
+  it->_state = 0;
+  _SDM_RegisterReadQueue.sort(compare_SDM_RegisterReadQueueElement);
+  _SDM_RegisterReadQueue.front()._state = state;
+  _SDM_blockElements                    = 0;
+}
+
 void SDM_removeRegisterReadQueueElement(taskIndex_t TaskIndex, taskVarIndex_t TaskVarIndex)
 {
   if (validTaskIndex(TaskIndex) && validTaskVarIndex(TaskVarIndex)) {
@@ -434,6 +479,7 @@ void SDM_removeRegisterReadQueueElement(taskIndex_t TaskIndex, taskVarIndex_t Ta
         ++it;
       }
     }
+    SDM_sortRegisterReadQueue();
   }
 }
 
@@ -444,10 +490,59 @@ void SDM_addRegisterReadQueueElement(taskIndex_t TaskIndex, taskVarIndex_t TaskV
   if ((reg != std::numeric_limits<uint16_t>::max()) &&
       validTaskIndex(TaskIndex) &&
       validTaskVarIndex(TaskVarIndex)) {
+    if (_SDM_RegisterReadQueue.empty()) {
+      _SDM_maxReadGap.clear();
+    }
     _SDM_RegisterReadQueue.emplace_back(TaskIndex, TaskVarIndex, reg, dev_id);
+    SDM_sortRegisterReadQueue();
+  }
+}
+
+void SDM_setRegisterReadValue(const SDM_RegisterReadQueueElement& element, float value)
+{
+  UserVar.setFloat(element.taskIndex, element.taskVarIndex, value);
 
-    //    _SDM_RegisterReadQueue.sort(compare_SDM_RegisterReadQueueElement);
+  # if FEATURE_PLUGIN_STATS
+  PluginTaskData_base *taskdata = getPluginTaskDataBaseClassOnly(element.taskIndex);
+
+  if (taskdata != nullptr) {
+    PluginStats *stats = taskdata->getPluginStats(element.taskVarIndex);
+
+    if (stats != nullptr) {
+      stats->trackPeak(value);
+    }
+  }
+  # endif // if FEATURE_PLUGIN_STATS
+}
+
+// Collect the elements at the front of the queue that can be read in a single request.
+// Returns the nr of registers to read.
+uint8_t SDM_collectRegisterReadBlock()
+{
+  auto it = _SDM_RegisterReadQueue.begin();
+
+  _SDM_blockElements = 1;
+  _SDM_blockRegister = it->_reg;
+
+  const uint8_t dev_id  = it->_dev_id;
+  uint16_t      lastReg = it->_reg;
+
+  const int8_t maxReadGap = SDM_getMaxReadGap(dev_id);
+
+  if (maxReadGap >= 0) {
+    for (++it; it != _SDM_RegisterReadQueue.end() && _SDM_blockElements < 255; ++it) {
+      // Queue is sorted, but rotated, so a lower register means the start of the queue
+      if ((it->_dev_id != dev_id) ||
+          (it->_reg < lastReg) ||
+          (it->_reg > lastReg + 2 + maxReadGap) ||
+          (it->_reg + 2 - _SDM_blockRegister > SDM_MAX_READ_REGISTERS)) {
+        break;
+      }
+      lastReg = it->_reg;
+      ++_SDM_blockElements;
+    }
   }
+  return lastReg + 2 - _SDM_blockRegister;
 }
 
 void SDM_loopRegisterReadQueue(SDM *sdm)
@@ -462,36 +557,42 @@ void SDM_loopRegisterReadQueue(SDM *sdm)
 
     if (readErr == SDM_ERR_STILL_WAITING) { return; }
 
-    if (readErr == SDM_ERR_NO_ERROR) {
-      const float value = sdm->decodeFloatValue();
-      UserVar.setFloat(it->taskIndex, it->taskVarIndex, value);
-
-      # if FEATURE_PLUGIN_STATS
-      PluginTaskData_base *taskdata = getPluginTaskDataBaseClassOnly(it->taskIndex);
-
-      if (taskdata != nullptr) {
-        PluginStats *stats = taskdata->getPluginStats(it->taskVarIndex);
+    if (readErr != SDM_ERR_NO_ERROR) {
+      sdm->clearErrCode();
 
-        if (stats != nullptr) {
-          stats->trackPeak(value);
-        }
+      if ((readErr == SDM_ERR_ILLEGAL_DATA_ADDRESS) && (_SDM_blockElements > 1)) {
+        // Meter does not accept reading unused registers, first try without gaps, then single values
+        _SDM_maxReadGap[it->_dev_id] = SDM_getMaxReadGap(it->_dev_id) > 0 ? 0 : -1;
       }
-      # endif // if FEATURE_PLUGIN_STATS
-    } else {
-      sdm->clearErrCode();
     }
     it->_state = 0;
-    _SDM_RegisterReadQueue.emplace_back(*it);
-    _SDM_RegisterReadQueue.pop_front();
-    it = _SDM_RegisterReadQueue.begin();
+
+    for (uint8_t i = 0; i < _SDM_blockElements; ++i) {
+      if (readErr == SDM_ERR_NO_ERROR) {
+        SDM_setRegisterReadValue(*it, sdm->decodeFloatValue(it->_reg - _SDM_blockRegister));
+      }
+      _SDM_RegisterReadQueue.emplace_back(*it);
+      _SDM_RegisterReadQueue.pop_front();
+      it = _SDM_RegisterReadQueue.begin();
+    }
+    _SDM_blockElements = 0;
   }
 
   if (it->_state == 0) {
-    sdm->startReadVal(it->_reg, it->_dev_id);
+    const uint8_t nrRegisters = SDM_collectRegisterReadBlock();
+    sdm->startReadRegisters(_SDM_blockRegister, nrRegisters, it->_dev_id);
+    ++_SDM_readRequests;
+    _SDM_readValues += _SDM_blockElements;
     it->_state = 1;
   }
 }
 
+void SDM_getRegisterReadQueueStats(uint32_t& requests, uint32_t& values)
+{
+  requests = _SDM_readRequests;
+  values   = _SDM_readValues;
+}
+
 void SDM_pause_loopRegisterReadQueue()
 {
   auto it = _SDM_RegisterReadQueue.begin();
@@ -37,6 +37,10 @@
 # define P078_QUERY3_DFLT     2 // Power (W)
 # define P078_QUERY4_DFLT     5 // Power Factor (cos-phi)
 
+# ifndef P078_MAX_READ_GAP
+#  define P078_MAX_READ_GAP    6 // Max. nr of unused registers read to combine 2 values in a single request
+# endif // ifndef P078_MAX_READ_GAP
+
 
 enum class SDM_UOM {
   percent,
@@ -156,13 +160,6 @@ struct SDM_RegisterReadQueueElement {
   uint8_t        _state       = 0;
 };
 
-/*
-   bool compare_SDM_RegisterReadQueueElement(const SDM_RegisterReadQueueElement& first, const SDM_RegisterReadQueueElement& second) const {
-    return first._userVarIndex < second._userVarIndex;
-   }
- */
-
-
 typedef std::list<SDM_RegisterReadQueueElement> SDM_RegisterReadQueue;
 
 void SDM_removeRegisterReadQueueElement(taskIndex_t    TaskIndex,
@@ -172,8 +169,13 @@ void SDM_addRegisterReadQueueElement(taskIndex_t    TaskIndex,
                                      uint16_t       reg,
                                      uint8_t        dev_id);
 
+// Values of the same Modbus address in (nearly) contiguous registers are read in a single request
 void SDM_loopRegisterReadQueue(SDM *sdm);
 
+// Nr of Modbus read requests sent and nr of values read using those requests
+void SDM_getRegisterReadQueueStats(uint32_t& requests,
+                                   uint32_t& values);
+
 void SDM_pause_loopRegisterReadQueue();
 
 void SDM_resume_loopRegisterReadQueue();
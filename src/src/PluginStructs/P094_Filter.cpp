@@ -459,5 +459,62 @@ P094_Filter_Window P094_filter::getFilterWindow() const
   return static_cast<P094_Filter_Window>(_filter._filterWindow);
 }
 
+void P094_filter_index::clear()
+{
+  _index.clear();
+  _wildcardCombinations = 0;
+}
+
+void P094_filter_index::build(const std::vector<P094_filter>& filters)
+{
+  clear();
+
+  for (size_t i = 0; i < filters.size() && i <= 0xFF; ++i) {
+    const P094_filter& filter = filters[i];
+
+    const uint8_t wildcards =
+      (filter.isWildcardManufacturer() ? 1 : 0) |
+      (filter.isWildcardMeterType() ? 2 : 0) |
+      (filter.isWildcardSerial() ? 4 : 0);
+
+    bitSet(_wildcardCombinations, wildcards);
+
+    // Does not replace an existing key, so the first matching filter is kept.
+    _index.emplace(
+      makeKey(filter._filter._serialNr, filter._filter._manufacturer, filter._filter._meterType),
+      static_cast<uint8_t>(i));
+  }
+}
+
+int P094_filter_index::find(const mBusPacket_header_t& header) const
+{
+  int res = -1;
+
+  for (uint8_t wildcards = 0; wildcards < 8; ++wildcards) {
+    if (bitRead(_wildcardCombinations, wildcards)) {
+      const uint64_t key = makeKey(
+        (wildcards & 4) ? mBus_packet_wildcard_serial : header._serialNr,
+        (wildcards & 1) ? mBus_packet_wildcard_manufacturer : header._manufacturer,
+        (wildcards & 2) ? mBus_packet_wildcard_metertype : header._meterType);
+
+      auto it = _index.find(key);
+
+      if ((it != _index.end()) && ((res < 0) || (it->second < res))) {
+        res = it->second;
+
+        if (res == 0) { return res; }
+      }
+    }
+  }
+  return res;
+}
+
+uint64_t P094_filter_index::makeKey(uint32_t serialNr, uint16_t manufacturer, uint8_t meterType)
+{
+  return static_cast<uint64_t>(serialNr) |
+         (static_cast<uint64_t>(manufacturer) << 32) |
+         (static_cast<uint64_t>(meterType) << 48);
+}
+
 
 #endif // ifdef USES_P094
\ No newline at end of file
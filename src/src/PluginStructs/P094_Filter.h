@@ -6,6 +6,8 @@
 
 # include "../DataStructs/mBusPacket.h"
 
+# include <map>
+
 // Is stored, so do not change the int values.
 enum class P094_Filter_Window : uint8_t {
   None            = 0, // no messages pass the filter
@@ -90,6 +92,32 @@ struct P094_filter {
   } _filter;
 };
 
+
+// Index to find the first filter matching a header, without checking all filters.
+// Filters are grouped per combination of wildcards, so per used combination
+// only a single lookup of the (masked) manufacturer, metertype and serial is needed.
+struct P094_filter_index {
+  void clear();
+
+  void build(const std::vector<P094_filter>& filters);
+
+  // Return the index of the first filter matching the header, -1 when no filter matches.
+  int  find(const mBusPacket_header_t& header) const;
+
+private:
+
+  static uint64_t makeKey(uint32_t serialNr,
+                          uint16_t manufacturer,
+                          uint8_t  meterType);
+
+  // Key: serial, manufacturer and metertype, with wildcard value for wildcards
+  // Value: index of the first filter with this key
+  std::map<uint64_t, uint8_t> _index;
+
+  // Bit per used combination of wildcards, bit 0: manufacturer, bit 1: metertype, bit 2: serial
+  uint8_t _wildcardCombinations = 0;
+};
+
 #endif // ifdef USES_P094
 
 #endif // ifndef PLUGINSTRUCTS_P094_FILTER_H
\ No newline at end of file
@@ -105,6 +105,7 @@ void P094_data_struct::loadFilters(struct EventStruct *event, uint8_t nrFilters)
       readPos += chunkSize;
     }
   }
+  _filterIndex.build(_filters);
 }
 
 String P094_data_struct::saveFilters(struct EventStruct *event) const
@@ -158,6 +159,7 @@ String P094_data_struct::saveFilters(struct EventStruct *event) const
 void P094_data_struct::clearFilters()
 {
   _filters.clear();
+  _filterIndex.clear();
 }
 
 bool P094_data_struct::addFilter(struct EventStruct *event, const String& filter)
@@ -179,6 +181,7 @@ bool P094_data_struct::addFilter(struct EventStruct *event, const String& filter
   }
 
   _filters.push_back(f);
+  _filterIndex.build(_filters);
 
   // No sorting as this may have unexpected side-effects
   // std::sort(_filters.begin(), _filters.end());
@@ -254,6 +257,7 @@ void P094_data_struct::WebformSaveFilters(struct EventStruct *event, uint8_t nrF
       }
     }
   }
+  _filterIndex.build(_filters);
   addHtmlError(saveFilters(event));
 }
 
@@ -713,6 +717,28 @@ bool P094_data_struct::parsePacket(const String& received, mBusPacket_t& packet)
       return false;
     }
 
+    # ifdef ESP32
+
+    // Stats are collected for all received packets, which needs the fully decoded packet
+    const bool quickReject = !collect_stats;
+    # else // ifdef ESP32
+    const bool quickReject = true;
+    # endif // ifdef ESP32
+
+    if (quickReject && !mute_messages && interval_filter.enabled && (_filters.size() != 0)) {
+      // Only decode the headers first, to skip decoding packets from meters we're not interested in
+      if (!packet.parseHeaderOnly(received)) { return false; }
+
+      const mBusPacket_header_t *header = packet.getDeviceHeader();
+
+      if ((header == nullptr) || (_filterIndex.find(*header) < 0)) {
+        if ((header != nullptr) && loglevelActiveFor(LOG_LEVEL_INFO)) {
+          addLogMove(LOG_LEVEL_INFO, concat(F("CUL Filter: NO Match "), header->toString()));
+        }
+        return false;
+      }
+    }
+
     // Decoded packet
     if (!packet.parse(received)) { return false; }
 
@@ -742,17 +768,17 @@ bool P094_data_struct::parsePacket(const String& received, mBusPacket_t& packet)
       return true; // No filtering
     }
 
-    for (unsigned int f = 0; f < _filters.size(); ++f) {
-      if (_filters[f].matches(*header)) {
-        const bool res = interval_filter.filter(packet, _filters[f]);
+    const int f = _filterIndex.find(*header);
 
-        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-          addLogMove(LOG_LEVEL_INFO, concat(F("CUL Filter: Match "), _filters[f].toString()));
-          addLogMove(LOG_LEVEL_INFO, concat(res ? F("CUL Filter: Pass ") : F("CUL Filter: Reject "), header->toString()));
-        }
+    if (f >= 0) {
+      const bool res = interval_filter.filter(packet, _filters[f]);
 
-        return res;
+      if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+        addLogMove(LOG_LEVEL_INFO, concat(F("CUL Filter: Match "), _filters[f].toString()));
+        addLogMove(LOG_LEVEL_INFO, concat(res ? F("CUL Filter: Pass ") : F("CUL Filter: Reject "), header->toString()));
       }
+
+      return res;
     }
 
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -161,6 +161,7 @@ private:
   bool isDuplicate(const P094_filter& other) const;
 
   std::vector<P094_filter>_filters;
+  P094_filter_index       _filterIndex;
 
   ESPeasySerial *easySerial = nullptr;
   String         sentence_part;
@@ -230,6 +230,9 @@ bool P095_data_struct::plugin_init(struct EventStruct *event) {
     }
 
     if (nullptr != gfxHelper) {
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      gfxHelper->setShadowBuffer(bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_SHADOW_BUFFER));
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
       gfxHelper->initialize();
       gfxHelper->setRotation(_rotation);
       gfxHelper->setColumnRowMode(bitRead(P095_CONFIG_FLAGS, P095_CONFIG_FLAG_USE_COL_ROW));
@@ -247,7 +250,11 @@ bool P095_data_struct::plugin_init(struct EventStruct *event) {
     } else
     # endif // if P095_ENABLE_ILI948X
     {
-      tft->fillScreen(_bgcolor);             // fill screen with background color
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(_bgcolor);     // fill screen with background color, also in shadow buffer
+      } else {
+        tft->fillScreen(_bgcolor);           // fill screen with background color
+      }
       tft->setTextColor(_fgcolor, _bgcolor); // set text color to white and configured background
       tft->setTextSize(_fontscaling);        // Handles 0 properly, text size, default 1 = very small
       tft->setCursor(0, 0);                  // move cursor to position (0, 0) pixel
@@ -380,12 +387,13 @@ bool P095_data_struct::plugin_ten_per_second(struct EventStruct *event) {
       addLog(LOG_LEVEL_INFO, F("P095 Splash finished."));
       #  endif // ifndef BUILD_NO_DEBUG
 
-      if (nullptr != tft) {
-        tft->fillScreen(_bgcolor); // fill screen with background color
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(_bgcolor); // fill screen with background color, also in shadow buffer
+      } else if (nullptr != tft) {
+        tft->fillScreen(_bgcolor);       // fill screen with background color
       }
       #  if P095_ENABLE_ILI948X
-
-      if (nullptr != ili9488) {
+      else if (nullptr != ili9488) {
         ili9488->fillScreen(_bgcolor); // fill screen with background color
       }
       #  endif // if P095_ENABLE_ILI948X
@@ -438,26 +446,19 @@ bool P095_data_struct::plugin_write(struct EventStruct *event, const String& str
     {
       String arg2 = parseString(string, 3);
 
-      if (!arg2.isEmpty()) {
-        # if P095_ENABLE_ILI948X
+      const uint16_t color = arg2.isEmpty() ? _bgcolor : AdaGFXparseColor(arg2);
 
-        if (useILI9488) {
-          ili9488->fillScreen(AdaGFXparseColor(arg2));
-        } else
-        # endif // if P095_ENABLE_ILI948X
-        {
-          tft->fillScreen(AdaGFXparseColor(arg2));
-        }
-      } else {
-        # if P095_ENABLE_ILI948X
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(color); // Also clears the shadow buffer
+      } else
+      # if P095_ENABLE_ILI948X
 
-        if (useILI9488) {
-          ili9488->fillScreen(_bgcolor);
-        } else
-        # endif // if P095_ENABLE_ILI948X
-        {
-          tft->fillScreen(_bgcolor);
-        }
+      if (useILI9488) {
+        ili9488->fillScreen(color);
+      } else
+      # endif // if P095_ENABLE_ILI948X
+      {
+        tft->fillScreen(color);
       }
     }
     else if (equals(arg1, F("backlight"))) {
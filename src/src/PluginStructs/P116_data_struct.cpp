@@ -272,9 +272,12 @@ bool P116_data_struct::plugin_init(struct EventStruct *event) {
     if (nullptr != gfxHelper) {
       displayOnOff(true);
 
+      # if ADAGFX_ENABLE_SHADOW_BUFFER
+      gfxHelper->setShadowBuffer(bitRead(P116_CONFIG_FLAGS, P116_CONFIG_FLAG_SHADOW_BUFFER));
+      # endif // if ADAGFX_ENABLE_SHADOW_BUFFER
       gfxHelper->initialize();
       gfxHelper->setRotation(_rotation);
-      st77xx->fillScreen(_bgcolor);             // fill screen with black color
+      gfxHelper->fillScreen(_bgcolor);          // fill screen with black color, also in shadow buffer
       st77xx->setTextColor(_fgcolor, _bgcolor); // set text color to white and black background
 
       # ifdef P116_SHOW_SPLASH
@@ -431,7 +434,11 @@ bool P116_data_struct::plugin_write(struct EventStruct *event,
       displayOnOff(true);
     }
     else if (equals(arg1, F("clear"))) {
-      st77xx->fillScreen(_bgcolor);
+      if (nullptr != gfxHelper) {
+        gfxHelper->fillScreen(_bgcolor); // Also clears the shadow buffer
+      } else {
+        st77xx->fillScreen(_bgcolor);
+      }
     }
     else if (equals(arg1, F("backlight"))) {
       if ((P116_CONFIG_BACKLIGHT_PIN != -1) &&       // All is valid?
@@ -57,6 +57,7 @@
 # define P116_CONFIG_FLAG_TYPE          16              // Flag-offset to store 4 bits for Hardwaretype, uses bits 16, 17, 18 and 19
 # define P116_CONFIG_FLAG_CMD_TRIGGER   20              // Flag-offset to store 4 bits for Command trigger, uses bits 20, 21, 22 and 23
 # define P116_CONFIG_FLAG_BACK_FILL     28              // Flag: Background fill when printing text
+# define P116_CONFIG_FLAG_SHADOW_BUFFER 29              // Flag: Only send changed areas to the display
 
 // Getters
 # define P116_CONFIG_FLAG_GET_MODE          (get4BitFromUL(P116_CONFIG_FLAGS, P116_CONFIG_FLAG_MODE))
@@ -852,7 +852,10 @@ bool P128_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
       break;
   } // switch mode
 
-  Plugin_128_pixels->Show();
+  // Don't wait for the previous transmission to complete, the pixels stay dirty and are sent on a next call
+  if (Plugin_128_pixels->CanShow()) {
+    Plugin_128_pixels->Show();
+  }
 
   if (mode != lastmode) {
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -865,20 +868,49 @@ bool P128_data_struct::plugin_fifty_per_second(struct EventStruct *event) {
   return true;
 }
 
+uint16_t P128_data_struct::fadeProgress(uint32_t elapsed, uint32_t duration) {
+  if (elapsed >= duration) { return 256; }
+
+  if (elapsed < 0x1000000u) {
+    return (elapsed << 8) / duration;
+  }
+  return elapsed / (duration >> 8); // Avoid overflow, duration is > 256 here
+}
+
+uint8_t P128_data_struct::blend8(uint8_t left, uint8_t right, uint16_t progress) {
+  return left + (((static_cast<int16_t>(right) - left) * static_cast<int32_t>(progress)) >> 8);
+}
+
+void P128_data_struct::fadeOutPixels() {
+  // Divide every color element by 2, independent of the color order, and already scaled for brightness
+  uint8_t     *pixels = Plugin_128_pixels->Pixels();
+  const size_t size   = Plugin_128_pixels->PixelsSize();
+
+  for (size_t i = 0; i < size; ++i) {
+    pixels[i] >>= 1;
+  }
+  Plugin_128_pixels->Dirty();
+}
+
 void P128_data_struct::fade(void) {
-  for (int pixel = 0; pixel < pixelCount; pixel++) {
-    long  counter  = 20 * (counter20ms - starttime[pixel]);
-    float progress = (float)counter / (float)fadetime;
-    progress = constrain(progress, 0.0f, 1.0f);
+  const uint16_t pixels = min(pixelCount, static_cast<uint16_t>(ARRAYSIZE));
+
+  for (uint16_t pixel = 0; pixel < pixels; pixel++) {
+    // With fadedelay set, the start time of a pixel may still be in the future
+    const int32_t  elapsed  = static_cast<int32_t>(counter20ms - starttime[pixel]);
+    const uint16_t progress = (elapsed < 0) ? 0 : fadeProgress(20 * elapsed, fadetime);
 
     # if defined(RGBW) || defined(GRBW)
-    RgbwColor updatedColor = RgbwColor::LinearBlend(
-      rgb_old[pixel], rgb_target[pixel],
-      progress);
+    const RgbwColor updatedColor(
+      blend8(rgb_old[pixel].R, rgb_target[pixel].R, progress),
+      blend8(rgb_old[pixel].G, rgb_target[pixel].G, progress),
+      blend8(rgb_old[pixel].B, rgb_target[pixel].B, progress),
+      blend8(rgb_old[pixel].W, rgb_target[pixel].W, progress));
     # else // if defined(RGBW) || defined(GRBW)
-    RgbColor updatedColor = RgbColor::LinearBlend(
-      rgb_old[pixel], rgb_target[pixel],
-      progress);
+    const RgbColor updatedColor(
+      blend8(rgb_old[pixel].R, rgb_target[pixel].R, progress),
+      blend8(rgb_old[pixel].G, rgb_target[pixel].G, progress),
+      blend8(rgb_old[pixel].B, rgb_target[pixel].B, progress));
     # endif // if defined(RGBW) || defined(GRBW)
 
     if ((counter20ms > maxtime) && (Plugin_128_pixels->GetPixelColor(pixel).CalculateBrightness() == 0)) {
@@ -1032,16 +1064,30 @@ void P128_data_struct::faketv(void) {
  * Cycles a rainbow over the entire string of LEDs.
  */
 void P128_data_struct::rainbow(void) {
-  const long  counter  = 20 * (counter20ms - starttimerb);
-  const float progress = (float)counter / (float)fadetime;
+  if (pixelCount == 0) { return; }
 
   if (fadeIn == true) {
-    Plugin_128_pixels->SetBrightness(progress * maxBright); // Safety check
-    fadeIn = (progress == 1) ? false : true;
+    const uint16_t progress = fadeProgress(20 * (counter20ms - starttimerb), fadetime);
+    Plugin_128_pixels->SetBrightness((progress * maxBright) >> 8); // Safety check
+    fadeIn = progress < 256;
   }
 
+  // Wheel position of pixel i is i * 256 / pixelCount, stepped without a division per pixel
+  const uint32_t offset    = counter20ms * rainbowspeed / 10;
+  const uint16_t step      = 256 / pixelCount;
+  const uint16_t stepRest  = 256 % pixelCount;
+  uint16_t       wheelPos  = 0;
+  uint16_t       wheelRest = 0;
+
   for (int i = 0; i < pixelCount; i++) {
-    const uint32_t color = Wheel(((i * 256 / pixelCount) + counter20ms * rainbowspeed / 10) & 255);
+    const uint32_t color = Wheel((wheelPos + offset) & 255);
+    wheelPos  += step;
+    wheelRest += stepRest;
+
+    if (wheelRest >= pixelCount) {
+      wheelRest -= pixelCount;
+      ++wheelPos;
+    }
     Plugin_128_pixels->SetPixelColor(i, 
       RgbColor(
         (color >> 16), // r
@@ -1073,28 +1119,7 @@ uint32_t P128_data_struct::Wheel(uint8_t pos) {
 // Larson Scanner K.I.T.T.
 void P128_data_struct::kitt(void) {
   if (counter20ms % (unsigned long)(SPEED_MAX / abs(speed)) == 0) {
-    for (uint16_t i = 0; i < pixelCount; i++) {
-      # if defined(RGBW) || defined(GRBW)
-      RgbwColor px_rgb = Plugin_128_pixels->GetPixelColor(i);
-
-      // fade out (divide by 2)
-      px_rgb.R >>= 1;
-      px_rgb.G >>= 1;
-      px_rgb.B >>= 1;
-      px_rgb.W >>= 1;
-
-      # else // if defined(RGBW) || defined(GRBW)
-
-      RgbColor px_rgb = Plugin_128_pixels->GetPixelColor(i);
-
-      // fade out (divide by 2)
-      px_rgb.R >>= 1;
-      px_rgb.G >>= 1;
-      px_rgb.B >>= 1;
-      # endif // if defined(RGBW) || defined(GRBW)
-
-      Plugin_128_pixels->SetPixelColor(i, px_rgb);
-    }
+    fadeOutPixels();
 
     uint16_t pos = 0;
 
@@ -1113,29 +1138,7 @@ void P128_data_struct::kitt(void) {
 // Firing comets from one end.
 void P128_data_struct::comet(void) {
   if (counter20ms % (unsigned long)(SPEED_MAX / abs(speed)) == 0) {
-    for (uint16_t i = 0; i < pixelCount; i++) {
-      const uint16_t pixelIndex = (speed > 0) ? i : pixelCount - i - 1;
-      # if defined(RGBW) || defined(GRBW)
-      RgbwColor px_rgb = Plugin_128_pixels->GetPixelColor(pixelIndex);
-
-      // fade out (divide by 2)
-      px_rgb.R >>= 1;
-      px_rgb.G >>= 1;
-      px_rgb.B >>= 1;
-      px_rgb.W >>= 1;
-
-      # else // if defined(RGBW) || defined(GRBW)
-
-      RgbColor px_rgb = Plugin_128_pixels->GetPixelColor(pixelIndex);
-
-      // fade out (divide by 2)
-      px_rgb.R >>= 1;
-      px_rgb.G >>= 1;
-      px_rgb.B >>= 1;
-      # endif // if defined(RGBW) || defined(GRBW)
-
-      Plugin_128_pixels->SetPixelColor(pixelIndex, px_rgb);
-    }
+    fadeOutPixels();
 
     {
       const uint16_t pixelIndex = (speed > 0) ? _counter_mode_step : pixelCount - _counter_mode_step - 1;
@@ -1226,28 +1229,7 @@ void P128_data_struct::twinkle(void) {
  */
 void P128_data_struct::twinklefade(void) {
   if ((counter20ms % (unsigned long)(SPEED_MAX / abs(speed)) == 0) && (speed != 0)) {
-    for (uint16_t i = 0; i < pixelCount; i++) {
-      # if defined(RGBW) || defined(GRBW)
-      RgbwColor px_rgb = Plugin_128_pixels->GetPixelColor(pixelCount - i - 1);
-
-      // fade out (divide by 2)
-      px_rgb.R = px_rgb.R >> 1;
-      px_rgb.G = px_rgb.G >> 1;
-      px_rgb.B = px_rgb.B >> 1;
-      px_rgb.W = px_rgb.W >> 1;
-
-      # else // if defined(RGBW) || defined(GRBW)
-
-      RgbColor px_rgb = Plugin_128_pixels->GetPixelColor(pixelCount - i - 1);
-
-      // fade out (divide by 2)
-      px_rgb.R = px_rgb.R >> 1;
-      px_rgb.G = px_rgb.G >> 1;
-      px_rgb.B = px_rgb.B >> 1;
-      # endif // if defined(RGBW) || defined(GRBW)
-
-      Plugin_128_pixels->SetPixelColor(i, px_rgb);
-    }
+    fadeOutPixels();
 
     if (HwRandom(count) < 50) {
       Plugin_128_pixels->SetPixelColor(HwRandom(pixelCount), rgb);
@@ -1273,12 +1255,9 @@ void P128_data_struct::fire(void) {
   if (counter20ms > fireTimer + 50 / fps) {
     fireTimer = counter20ms;
     Fire2012();
-    RgbColor pixel;
 
     for (int i = 0; i < pixelCount; i++) {
-      pixel = leds[i];
-      pixel = RgbColor::LinearBlend(pixel, RgbColor(0, 0, 0), (255 - brightness) / 255.0f);
-      Plugin_128_pixels->SetPixelColor(i, pixel);
+      Plugin_128_pixels->SetPixelColor(i, leds[i].Dim(brightness));
     }
   }
 }
@@ -1416,7 +1395,7 @@ void P128_data_struct::fire_flicker() {
     byte b   = 12;  // (SEGMENT.colors[0]        & 0xFF);
     byte lum = max(w, max(r, max(g, b))) / rev_intensity;
 
-    for (uint16_t i = 0; i <= NUMPixels - 1; i++) {
+    for (uint16_t i = 0; i < pixelCount; i++) {
       int flicker = random8(lum);
 
       # if defined(RGBW) || defined(GRBW)
@@ -1446,20 +1425,24 @@ void P128_data_struct::Plugin_128_simpleclock() {
   }
 
 
-  for (int i = 0; i < pixelCount; i++) {
-    if (lround((((float)Seconds + ((float)counter20ms - (float)maxtime) / 50.0f) * (float)pixelCount) / 60.0f) == i) {
-      if (rgb_s_off  == false) {
-        Plugin_128_pixels->SetPixelColor(i, rgb_s);
-      }
-    }
-    else if (lround((((float)Minutes * 60.0f) + (float)Seconds) / 60.0f * (float)pixelCount / 60.0f) == i) {
-      Plugin_128_pixels->SetPixelColor(i, rgb_m);
-    }
-    else if (lround(((float)Hours + (float)Minutes / 60) * (float)pixelCount / 12.0f)  == i) {
-      Plugin_128_pixels->SetPixelColor(i,                                 rgb_h);
-      Plugin_128_pixels->SetPixelColor((i + 1) % pixelCount,              rgb_h);
-      Plugin_128_pixels->SetPixelColor((i - 1 + pixelCount) % pixelCount, rgb_h);
-    }
+  // Calculate the hand positions once per frame, instead of for every pixel
+  const long secondPos = lround((((float)Seconds + ((float)counter20ms - (float)maxtime) / 50.0f) * (float)pixelCount) / 60.0f);
+  const long minutePos = lround((((float)Minutes * 60.0f) + (float)Seconds) / 60.0f * (float)pixelCount / 60.0f);
+  const long hourPos   = lround(((float)Hours + (float)Minutes / 60) * (float)pixelCount / 12.0f);
+
+  // A pixel shows only 1 hand, the second hand has precedence over the minute hand, and that over the hour hand
+  if ((hourPos >= 0) && (hourPos < pixelCount) && (hourPos != secondPos) && (hourPos != minutePos)) {
+    Plugin_128_pixels->SetPixelColor(hourPos,                                 rgb_h);
+    Plugin_128_pixels->SetPixelColor((hourPos + 1) % pixelCount,              rgb_h);
+    Plugin_128_pixels->SetPixelColor((hourPos - 1 + pixelCount) % pixelCount, rgb_h);
+  }
+
+  if ((minutePos >= 0) && (minutePos < pixelCount) && (minutePos != secondPos)) {
+    Plugin_128_pixels->SetPixelColor(minutePos, rgb_m);
+  }
+
+  if ((secondPos >= 0) && (secondPos < pixelCount) && (rgb_s_off == false)) {
+    Plugin_128_pixels->SetPixelColor(secondPos, rgb_s);
   }
 }
 
@@ -2249,12 +2249,22 @@ const uint8_t PROGMEM ftv_colors[] = {
 // # define BRG   //A three element color in the order of Blue, Red, and then Green.
 // # define RBG   //A three element color in the order of Red, Blue, and then Green.
 
-# define NEOPIXEL_LIB NeoPixelBrightnessBus   // Neopixel library type
+// ESP8266: Send the pixel data from the UART interrupt, so Show() doesn't wait until all data is transmitted.
+// Disabled by default, as it replaces the UART interrupt handler of the core, so no data can be received via Serial.
+# ifndef P128_ASYNC_SHOW
+#  define P128_ASYNC_SHOW 0
+# endif // ifndef P128_ASYNC_SHOW
+
+# define NEOPIXEL_LIB NeoPixelBrightnessBus        // Neopixel library type
 # if defined(ESP32)
-#  define METHOD NeoWs2812xMethod             // Automatic method, user selected pin
+#  define METHOD NeoWs2812xMethod                  // Automatic method, user selected pin
 # endif // if defined(ESP32)
 # if defined(ESP8266)
-#  define METHOD NeoEsp8266Uart1800KbpsMethod // GPIO2 - use NeoEsp8266Uart0800KbpsMethod for GPIO1(TX)
+#  if P128_ASYNC_SHOW
+#   define METHOD NeoEsp8266AsyncUart1800KbpsMethod // GPIO2
+#  else // if P128_ASYNC_SHOW
+#   define METHOD NeoEsp8266Uart1800KbpsMethod      // GPIO2 - use NeoEsp8266Uart0800KbpsMethod for GPIO1(TX)
+#  endif // if P128_ASYNC_SHOW
 # endif // if defined(ESP8266)
 
 # if defined GRB
@@ -2406,6 +2416,16 @@ private:
 
   void     rgb2colorStr();
 
+  // Fade progress 0..256, using integer math only
+  static uint16_t fadeProgress(uint32_t elapsed,
+                               uint32_t duration);
+  static uint8_t  blend8(uint8_t  left,
+                         uint8_t  right,
+                         uint16_t progress);
+
+  // Halve the brightness of all pixels, directly in the pixel buffer
+  void     fadeOutPixels();
+
   void     fade(void);
   void     colorfade(void);
   void     wipe(void);
@@ -130,6 +130,9 @@ void handle_advanced() {
     #if FEATURE_I2C_DEVICE_CHECK
     Settings.CheckI2Cdevice(isFormItemChecked(LabelType::ENABLE_I2C_DEVICE_CHECK));
     #endif // if FEATURE_I2C_DEVICE_CHECK
+    #if FEATURE_CONTROLLER_WORKER_TASK
+    Settings.ControllerWorkerTask(isFormItemChecked(LabelType::CONTROLLER_WORKER_TASK));
+    #endif // if FEATURE_CONTROLLER_WORKER_TASK
 #ifndef ESP32
     Settings.WaitWiFiConnect(isFormItemChecked(LabelType::WAIT_WIFI_CONNECT));
 #endif
@@ -323,6 +326,9 @@ void handle_advanced() {
   #if FEATURE_I2C_DEVICE_CHECK
   addFormCheckBox(LabelType::ENABLE_I2C_DEVICE_CHECK, Settings.CheckI2Cdevice());
   #endif // if FEATURE_I2C_DEVICE_CHECK
+  #if FEATURE_CONTROLLER_WORKER_TASK
+  addFormCheckBox(LabelType::CONTROLLER_WORKER_TASK, Settings.ControllerWorkerTask());
+  #endif // if FEATURE_CONTROLLER_WORKER_TASK
 
   # ifndef NO_HTTP_UPDATER
   addFormCheckBox(LabelType::ALLOW_OTA_UNLIMITED, Settings.AllowOTAUnlimited());
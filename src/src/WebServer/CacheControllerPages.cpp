@@ -8,6 +8,7 @@
 # include "../WebServer/JSON.h"
 # include "../CustomBuild/ESPEasyLimits.h"
 # include "../DataStructs/DeviceStruct.h"
+# include "../DataStructs/RTC_cache_block_codec.h"
 # include "../DataStructs/ESPEasyControllerCache_CSV_dumper.h"
 # include "../DataTypes/TaskIndex.h"
 # include "../Globals/C016_ControllerCache.h"
@@ -136,6 +137,29 @@ void handle_cache_json() {
     }
   }
   addHtml(F("],\n"));
+# if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
+
+  // Format per file, as the files may be read without decoding them.
+  // When not present, all files are "raw".
+  addHtml(F("\"formats\": ["));
+  islast    = false;
+  filenr    = 0;
+  fileCount = 0;
+
+  while (!islast) {
+    const String currentFile = C016_getCacheFileName(filenr, islast);
+    ++filenr;
+
+    if (currentFile.length() > 0) {
+      if (fileCount != 0) {
+        addHtml(',');
+      }
+      addHtml(to_json_value(RTC_cache_block_getFileFormat(currentFile)));
+      ++fileCount;
+    }
+  }
+  addHtml(F("],\n"));
+# endif // if FEATURE_RTC_CACHE_STORAGE && FEATURE_RTC_CACHE_COMPRESSION
   addHtml(F("\"pluginID\": ["));
 
   for (taskIndex_t taskIndex = 0; validTaskIndex(taskIndex); ++taskIndex) {
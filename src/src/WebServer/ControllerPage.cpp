@@ -9,11 +9,13 @@
 # include "../WebServer/Markup_Buttons.h"
 # include "../WebServer/Markup_Forms.h"
 
+# include "../ControllerQueue/DelayQueueElements.h"
 # include "../DataStructs/ESPEasy_EventStruct.h"
 
 # include "../ESPEasyCore/Controller.h"
 
 # include "../Globals/CPlugins.h"
+# include "../Globals/HTTPConnectionPool.h"
 # include "../Globals/Settings.h"
 
 # if FEATURE_MQTT
@@ -376,6 +378,11 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           if (proto.usesQueue) {
             addTableSeparator(F("Controller Queue"), 2, 3);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL);
+            # if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL);
+            addFormNote(F("Send faster while messages are acknowledged quickly, back off on failures"));
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_SEND_INTERVAL);
+            # endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_RETRIES);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION);
@@ -384,6 +391,10 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
               addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE);
             }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_DEDUPLICATE);
+            # if FEATURE_CONTROLLER_QUEUE_SPILL
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH);
+            addFormNote(F("Messages are kept on the file system while the queue is full and sent when the controller is connected again"));
+            # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
           }
 
           if (proto.usesCheckReply) {
@@ -597,6 +608,55 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
 #  endif // if FEATURE_MQTT_TLS
       }
 # endif // if FEATURE_MQTT
+# if FEATURE_HTTP_CONNECTION_POOL
+      const HTTPConnectionStats *stats = HTTPConnections.getStats(controllerindex);
+
+      if (stats != nullptr) {
+        addFormSubHeader(F("HTTP Connection Statistics"));
+        addRowLabel(F("Requests"));
+        addHtmlInt(stats->requests);
+        addRowLabel(F("Connection Reuse"));
+        addHtmlFloat(stats->getReuseRatio() * 100.0f, 1);
+        addUnit('%');
+        addRowLabel(F("Connection Setup Time"));
+        addHtmlFloat(stats->getSetupTime_usec() / 1000.0f, 1);
+        addUnit(F("ms"));
+        addFormNote(F("Estimated from the difference in duration of requests over a new and a reused connection"));
+        addRowLabel(F("Reconnects"));
+        addHtmlInt(stats->retries);
+        addRowLabel(F("Closed by Server"));
+        addHtmlInt(stats->serverClosed);
+      }
+# endif // if FEATURE_HTTP_CONNECTION_POOL
+# if FEATURE_CONTROLLER_QUEUE_SPILL || FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+      const ControllerDelayHandlerStruct *delayHandler = getControllerDelayHandler(controllerindex);
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL || FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+# if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+      if ((delayHandler != nullptr) && (delayHandler->getRoundTripTime_usec() != 0)) {
+        addFormSubHeader(F("Send Rate"));
+        addRowLabel(F("Send Interval"));
+        addHtmlInt(delayHandler->getSendInterval());
+        addUnit(F("ms"));
+        addRowLabel(F("Round Trip Time"));
+        addHtmlFloat(delayHandler->getRoundTripTime_usec() / 1000.0f, 1);
+        addUnit(F("ms"));
+        addRowLabel(F("Success Rate"));
+        addHtmlFloat(delayHandler->getSuccessRate() / 100.0f, 1);
+        addUnit('%');
+      }
+# endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+
+      if ((delayHandler != nullptr) && (delayHandler->getSpillCount() > 0)) {
+        addFormSubHeader(F("Queue Stored on Flash"));
+        addRowLabel(F("Messages"));
+        addHtmlInt(delayHandler->getSpillCount());
+        addRowLabel(F("Flash Used"));
+        addHtmlInt(static_cast<uint32_t>(delayHandler->getSpillFlashUsage()));
+        addUnit(F("bytes"));
+      }
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     }
 
     // Separate enabled checkbox as it doesn't need to use the ControllerSettings.
@@ -125,6 +125,8 @@ void handle_i2cscanner_json() {
   for (int i = 0; i < 128; i++) {
     mainBusDevices[i] = false;
   }
+  // The channel selected last is kept, deselect it so only devices on the main bus are found
+  I2CMultiplexerOff();
   nDevices = scanI2CbusForDevices_json(Settings.I2C_Multiplexer_Addr, -1, nDevices, mainBusDevices); // Channel -1 = standard I2C bus
   #else // if FEATURE_I2CMULTIPLEXER
   nDevices = scanI2CbusForDevices_json(-1, -1, nDevices); // Standard scan
@@ -488,6 +490,8 @@ void handle_i2cscanner() {
     for (int i = 0; i < 128; i++) {
       mainBusDevices[i] = false;
     }
+    // The channel selected last is kept, deselect it so only devices on the main bus are found
+    I2CMultiplexerOff();
     nDevices = scanI2CbusForDevices(Settings.I2C_Multiplexer_Addr, -1, nDevices, mainBusDevices); // Channel -1 = standard I2C bus
     #else // if FEATURE_I2CMULTIPLEXER
     nDevices = scanI2CbusForDevices(-1, -1, nDevices); // Standard scan
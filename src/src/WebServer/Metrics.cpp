@@ -8,6 +8,15 @@
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Static/WebStaticData.h"
 
+#include "../ControllerQueue/DelayQueueElements.h"
+#include "../DataStructs/TimingStats.h"
+#include "../Globals/CPlugins.h"
+#include "../Globals/CooperativeScheduler.h"
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/HTTPConnectionPool.h"
+#include "../Globals/Plugins.h"
+#include "../Globals/Statistics.h"
+
 #ifdef WEBSERVER_METRICS
 
 # ifdef ESP32
@@ -85,9 +94,478 @@ void handle_metrics() {
   // devices
   handle_metrics_devices();
 
+  // controller queues
+  handle_metrics_controller_queues();
+  # if FEATURE_HTTP_CONNECTION_POOL
+  handle_metrics_http_connections();
+  # endif // if FEATURE_HTTP_CONNECTION_POOL
+
+  // scheduler
+  handle_metrics_scheduler();
+  handle_metrics_background_jobs();
+
+  // I2C bus
+  handle_metrics_i2c_bus();
+
+  # if FEATURE_TIMING_STATS
+
+  // plugin/controller/misc timing stats
+  handle_metrics_timing_stats();
+  # endif // if FEATURE_TIMING_STATS
+
   TXBuffer.endStream();
 }
 
+void handle_metrics_header(const __FlashStringHelper *name,
+                           const __FlashStringHelper *help,
+                           const __FlashStringHelper *type) {
+  addHtml(F("# HELP espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(help);
+  addHtml(F("\n# TYPE espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(type);
+  addHtml('\n');
+}
+
+// Write: espeasy_<name>{<labels>} <value>
+// labels may be empty
+void handle_metrics_sample_start(const __FlashStringHelper *name,
+                                 const __FlashStringHelper *suffix,
+                                 const String             & labels) {
+  addHtml(F("espeasy_"));
+  addHtml(name);
+
+  if (suffix != nullptr) {
+    addHtml(suffix);
+  }
+
+  if (!labels.isEmpty()) {
+    addHtml('{');
+    addHtml(labels);
+    addHtml('}');
+  }
+  addHtml(' ');
+}
+
+void handle_metrics_sample(const __FlashStringHelper *name,
+                           const String             & labels,
+                           uint64_t                   value) {
+  handle_metrics_sample_start(name, nullptr, labels);
+  addHtmlInt(value);
+  addHtml('\n');
+}
+
+String handle_metrics_controller_labels(controllerIndex_t controllerIndex) {
+  String labels = F("controller=\"");
+
+  labels += get_formatted_Controller_number(getCPluginID_from_ControllerIndex(controllerIndex));
+  labels += F("\",index=\"");
+  labels += controllerIndex + 1;
+  labels += '"';
+  return labels;
+}
+
+void handle_metrics_controller_queues() {
+  // Collect the handlers first, as all MQTT controllers share a single queue
+  // and each metric family must be streamed as one group.
+  ControllerDelayHandlerStruct *handlers[CONTROLLER_MAX] = {};
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (Settings.ControllerEnabled[x]) {
+      handlers[x] = getControllerDelayHandler(x);
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_depth"),
+    F("Number of messages waiting in the controller queue"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_depth"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->sendQueue.size());
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_max_depth"),
+    F("Configured maximum number of messages in the controller queue"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_max_depth"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->max_queue_depth);
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_memory_bytes"),
+    F("Memory used by messages in the controller queue"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_memory_bytes"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getQueueMemorySize());
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_dropped_total"),
+    F("Messages dropped from the controller queue (full, expired or max retries)"),
+    F("counter"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_dropped_total"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getDroppedCount());
+    }
+  }
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  handle_metrics_header(
+    F("controller_queue_flash_messages"),
+    F("Number of messages of the controller queue stored on flash"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_flash_messages"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getSpillCount());
+    }
+  }
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+# if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+
+  handle_metrics_header(
+    F("controller_queue_send_interval_msec"),
+    F("Time between messages sent by the controller currently in use"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_send_interval_msec"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getSendInterval());
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_rtt_usec"),
+    F("Smoothed duration of successfully sent messages"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_rtt_usec"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getRoundTripTime_usec());
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_queue_success_pct"),
+    F("Smoothed percentage of messages sent successfully"),
+    F("gauge"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (handlers[x] != nullptr) {
+      handle_metrics_sample(
+        F("controller_queue_success_pct"),
+        handle_metrics_controller_labels(x),
+        handlers[x]->getSuccessRate() / 100);
+    }
+  }
+# endif // if FEATURE_CONTROLLER_ADAPTIVE_SEND_INTERVAL
+}
+
+# if FEATURE_HTTP_CONNECTION_POOL
+void handle_metrics_http_connections() {
+  handle_metrics_header(
+    F("controller_http_requests_total"),
+    F("Number of HTTP requests sent by the controller, per type of connection"),
+    F("counter"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    const HTTPConnectionStats *stats = HTTPConnections.getStats(x);
+
+    if (stats != nullptr) {
+      const String labels = handle_metrics_controller_labels(x);
+      handle_metrics_sample(
+        F("controller_http_requests_total"),
+        concat(labels, F(",connection=\"new\"")),
+        stats->requests - stats->reused);
+      handle_metrics_sample(
+        F("controller_http_requests_total"),
+        concat(labels, F(",connection=\"reused\"")),
+        stats->reused);
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_http_request_usec_total"),
+    F("Total duration of HTTP requests sent by the controller, per type of connection"),
+    F("counter"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    const HTTPConnectionStats *stats = HTTPConnections.getStats(x);
+
+    if (stats != nullptr) {
+      const String labels = handle_metrics_controller_labels(x);
+      handle_metrics_sample(
+        F("controller_http_request_usec_total"),
+        concat(labels, F(",connection=\"new\"")),
+        stats->new_usec);
+      handle_metrics_sample(
+        F("controller_http_request_usec_total"),
+        concat(labels, F(",connection=\"reused\"")),
+        stats->reused_usec);
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_http_reconnects_total"),
+    F("Number of requests sent again as the kept-alive connection was lost"),
+    F("counter"));
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    const HTTPConnectionStats *stats = HTTPConnections.getStats(x);
+
+    if (stats != nullptr) {
+      handle_metrics_sample(
+        F("controller_http_reconnects_total"),
+        handle_metrics_controller_labels(x),
+        stats->retries);
+    }
+  }
+}
+
+# endif // if FEATURE_HTTP_CONNECTION_POOL
+
+void handle_metrics_scheduler() {
+  handle_metrics_header(
+    F("scheduler_timer_queue_length"),
+    F("Number of timers scheduled"),
+    F("gauge"));
+  handle_metrics_sample(F("scheduler_timer_queue_length"), EMPTY_STRING, Scheduler.getTimerQueueLength());
+
+  handle_metrics_header(
+    F("scheduler_timer_queue_max_length"),
+    F("Max number of timers scheduled since boot"),
+    F("gauge"));
+  handle_metrics_sample(F("scheduler_timer_queue_max_length"), EMPTY_STRING, Scheduler.getMaxTimerQueueLength());
+
+  handle_metrics_header(
+    F("scheduler_event_queue_length"),
+    F("Number of system events waiting to be processed"),
+    F("gauge"));
+  handle_metrics_sample(F("scheduler_event_queue_length"), EMPTY_STRING, Scheduler.getSystemEventQueueLength());
+
+  handle_metrics_header(
+    F("scheduler_idle_pct"),
+    F("Percentage of time the scheduler was idle"),
+    F("gauge"));
+  handle_metrics_sample_start(F("scheduler_idle_pct"), nullptr, EMPTY_STRING);
+  addHtmlFloat(Scheduler.getIdleTimePct());
+  addHtml('\n');
+}
+
+void handle_metrics_i2c_bus() {
+  if (!Settings.isI2CEnabled()) { return; }
+
+  handle_metrics_header(
+    F("i2c_task_calls_total"),
+    F("Number of plugin calls for I2C tasks"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_task_calls_total"), EMPTY_STRING, I2C_bus_stats.taskCalls);
+
+  handle_metrics_header(
+    F("i2c_bus_time_usec_total"),
+    F("Time spent in plugin calls for I2C tasks in usec"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_bus_time_usec_total"), EMPTY_STRING, I2C_bus_stats.busTime_usec);
+
+  handle_metrics_header(
+    F("i2c_mux_writes_total"),
+    F("Number of writes to the I2C multiplexer"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_mux_writes_total"), EMPTY_STRING, I2C_bus_stats.muxWrites);
+
+  handle_metrics_header(
+    F("i2c_mux_writes_skipped_total"),
+    F("Number of I2C multiplexer writes skipped as the channels were already selected"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_mux_writes_skipped_total"), EMPTY_STRING, I2C_bus_stats.muxWritesSkipped);
+
+  handle_metrics_header(
+    F("i2c_clock_changes_total"),
+    F("Number of I2C clock speed changes"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_clock_changes_total"), EMPTY_STRING, I2C_bus_stats.clockChanges);
+
+  handle_metrics_header(
+    F("i2c_clock_changes_skipped_total"),
+    F("Number of I2C clock speed changes skipped as the clock speed was already set"),
+    F("counter"));
+  handle_metrics_sample(F("i2c_clock_changes_skipped_total"), EMPTY_STRING, I2C_bus_stats.clockChangesSkipped);
+}
+
+void handle_metrics_background_jobs() {
+  const __FlashStringHelper *names[] = {
+    F("background_job_calls_total"),
+    F("background_job_overruns_total"),
+    F("background_job_deferred_total"),
+    F("background_job_skipped_total"),
+    F("background_job_max_usec"),
+    F("background_job_usec_total")
+  };
+  const __FlashStringHelper *help[] = {
+    F("Number of work items processed by the background job"),
+    F("Number of runs where the background job exceeded its budget"),
+    F("Number of runs ended by the budget while more work was pending"),
+    F("Number of runs skipped as the loop budget was used up"),
+    F("Max duration of a single background job run"),
+    F("Total time spent in the background job")
+  };
+
+  for (size_t i = 0; i < NR_ELEMENTS(names); ++i) {
+    handle_metrics_header(
+      names[i],
+      help[i],
+      i == 4 ? F("gauge") : F("counter"));
+
+    for (uint8_t job = 0; job < static_cast<uint8_t>(CooperativeJob_e::NR_ELEMENTS); ++job) {
+      const CooperativeJob_e jobId = static_cast<CooperativeJob_e>(job);
+
+      if (BackgroundJobs.isRegistered(jobId)) {
+        const CooperativeJobStats& stats = BackgroundJobs.getStats(jobId);
+        uint64_t value                   = 0;
+
+        switch (i) {
+          case 0: value = stats.calls; break;
+          case 1: value = stats.overruns; break;
+          case 2: value = stats.deferred; break;
+          case 3: value = stats.skipped; break;
+          case 4: value = stats.max_usec; break;
+          case 5: value = stats.total_usec; break;
+        }
+        handle_metrics_sample(names[i], concat(F("job=\""), toString(jobId)) + '"', value);
+      }
+    }
+  }
+
+  handle_metrics_header(
+    F("background_loop_budget_exhausted_total"),
+    F("Number of scheduler runs where not all background jobs could be dispatched"),
+    F("counter"));
+  handle_metrics_sample(F("background_loop_budget_exhausted_total"), EMPTY_STRING, BackgroundJobs.getLoopBudgetExhausted());
+}
+
+# if FEATURE_TIMING_STATS
+
+// Stream a TimingStats object as Prometheus summary.
+// TimingStats only keeps track of min/avg/max, thus only quantile 0 (min) and 1 (max) can be given.
+void handle_metrics_timing_summary(const __FlashStringHelper *name,
+                                   const String             & labels,
+                                   const TimingStats        & stats) {
+  uint64_t minVal, maxVal;
+  const uint32_t count = stats.getMinMax(minVal, maxVal);
+
+  handle_metrics_sample_start(name, nullptr, concat(labels, F(",quantile=\"0\"")));
+  addHtmlInt(minVal);
+  addHtml('\n');
+  handle_metrics_sample_start(name, nullptr, concat(labels, F(",quantile=\"1\"")));
+  addHtmlInt(maxVal);
+  addHtml('\n');
+  handle_metrics_sample_start(name, F("_sum"), labels);
+  addHtmlFloat(stats.getAvg() * count, 0);
+  addHtml('\n');
+  handle_metrics_sample_start(name, F("_count"), labels);
+  addHtmlInt(count);
+  addHtml('\n');
+}
+
+void handle_metrics_timing_stats() {
+  handle_metrics_header(
+    F("timingstats_period_msec"),
+    F("Time since timing statistics were last reset"),
+    F("gauge"));
+  handle_metrics_sample(F("timingstats_period_msec"), EMPTY_STRING, timePassedSince(timingstats_last_reset));
+
+  handle_metrics_header(
+    F("plugin_call_usec"),
+    F("Duration of plugin function calls in usec"),
+    F("summary"));
+
+  for (auto& x: pluginStats) {
+    if (!x.second.isEmpty()) {
+      const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(x.first >> 8);
+
+      if (validDeviceIndex(deviceIndex)) {
+        String labels = F("plugin=\"");
+        labels += get_formatted_Plugin_number(getPluginID_from_DeviceIndex(deviceIndex));
+        labels += F("\",function=\"");
+        labels += getPluginFunctionName(x.first % 256);
+        labels += '"';
+        handle_metrics_timing_summary(F("plugin_call_usec"), labels, x.second);
+      }
+    }
+  }
+
+  handle_metrics_header(
+    F("controller_call_usec"),
+    F("Duration of controller function calls in usec"),
+    F("summary"));
+
+  for (auto& x: controllerStats) {
+    if (!x.second.isEmpty()) {
+      const protocolIndex_t ProtocolIndex = x.first >> 8;
+
+      if (validProtocolIndex(ProtocolIndex)) {
+        String labels = F("controller=\"");
+        labels += get_formatted_Controller_number(getCPluginID_from_ProtocolIndex(ProtocolIndex));
+        labels += F("\",function=\"");
+        labels += getCPluginCFunctionName(static_cast<CPlugin::Function>(x.first % 256));
+        labels += '"';
+        handle_metrics_timing_summary(F("controller_call_usec"), labels, x.second);
+      }
+    }
+  }
+
+  handle_metrics_header(
+    F("misc_call_usec"),
+    F("Duration of miscellaneous internal functions in usec"),
+    F("summary"));
+
+  for (auto& x: miscStats) {
+    if (!x.second.isEmpty()) {
+      handle_metrics_timing_summary(
+        F("misc_call_usec"),
+        concat(F("stat=\""), getMiscStatsName(x.first)) + '"',
+        x.second);
+    }
+  }
+}
+
+# endif // if FEATURE_TIMING_STATS
+
 void handle_metrics_devices() {
   for (taskIndex_t x = 0; validTaskIndex(x); x++) {
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
@@ -7,6 +7,16 @@
 
 void handle_metrics();
 void handle_metrics_devices();
+void handle_metrics_controller_queues();
+# if FEATURE_HTTP_CONNECTION_POOL
+void handle_metrics_http_connections();
+# endif // if FEATURE_HTTP_CONNECTION_POOL
+void handle_metrics_scheduler();
+void handle_metrics_background_jobs();
+void handle_metrics_i2c_bus();
+# if FEATURE_TIMING_STATS
+void handle_metrics_timing_stats();
+# endif // if FEATURE_TIMING_STATS
 
 #endif    // ifdef WEBSERVER_METRICS
 
@@ -15,6 +15,7 @@
 
 # include "../CustomBuild/CompiletimeDefines.h"
 
+# include "../DataStructs/ObjectPool.h"
 # include "../DataStructs/RTCStruct.h"
 
 # include "../ESPEasyCore/ESPEasyEth.h"
@@ -413,6 +414,25 @@ void handle_sysinfo_memory() {
     addRowLabelValue(LabelType::PSRAM_MAX_FREE_BLOCK);
   } 
 # endif // if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+
+# if FEATURE_OBJECT_POOL
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(ObjectPool_e::NR_ELEMENTS); ++i) {
+    const ObjectPool_e pool_e = static_cast<ObjectPool_e>(i);
+    const ObjectPool& pool    = getObjectPool(pool_e);
+
+    addRowLabel(concat(F("Pool "), toString(pool_e)));
+
+    // E.g. "3/16 x 96 byte (max: 5, heap: 0)"
+    addHtml(strformat(
+      F("%u/%u x %u byte (max: %u, heap: %u)"),
+      pool.getInUse(),
+      pool.getNrBlocks(),
+      pool.getBlockSize(),
+      pool.getHighWaterMark(),
+      pool.getFailedCount()));
+  }
+# endif // if FEATURE_OBJECT_POOL
 }
 #endif
 